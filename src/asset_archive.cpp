@@ -0,0 +1,217 @@
+// src/asset_archive.cpp
+#include "asset_archive.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetArchive::~AssetArchive() { close(); }
+
+static uint64_t readU64(const unsigned char *bytes) {
+  uint64_t value = 0;
+  for (int i = 7; i >= 0; --i)
+    value = (value << 8) | bytes[i];
+  return value;
+}
+
+static uint32_t readU32(const unsigned char *bytes) {
+  return static_cast<uint32_t>(bytes[0]) | (bytes[1] << 8) |
+         (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+bool AssetArchive::open(const std::string &path) {
+  close();
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false; // No archive; not an error
+  LARGE_INTEGER fileSize;
+  HANDLE mapping = nullptr;
+  const void *view = nullptr;
+  if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping)
+      view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  }
+  if (!view) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "AssetArchive: failed to map '%s' (error %lu)", path.c_str(),
+                 GetLastError());
+    if (mapping)
+      CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+  fileHandle = file;
+  mappingHandle = mapping;
+  mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false; // No archive; not an error
+  struct stat info;
+  void *view = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && info.st_size > 0)
+    view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                MAP_PRIVATE, fd, 0);
+  ::close(fd); // The mapping keeps the file alive
+  if (view == MAP_FAILED) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "AssetArchive: failed to map '%s': %s", path.c_str(),
+                 std::strerror(errno));
+    return false;
+  }
+  mappedSize = static_cast<size_t>(info.st_size);
+#endif
+  base = static_cast<const unsigned char *>(view);
+
+  if (!readIndex(path)) {
+    close();
+    return false;
+  }
+  SDL_Log("AssetArchive: mapped '%s' (%zu entries, %zu bytes).", path.c_str(),
+          entries.size(), mappedSize);
+  return true;
+}
+
+bool AssetArchive::readIndex(const std::string &path) {
+  if (mappedSize < ASSET_ARCHIVE_HEADER_SIZE ||
+      std::memcmp(base, ASSET_ARCHIVE_MAGIC, sizeof(ASSET_ARCHIVE_MAGIC)) != 0) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "AssetArchive: '%s' is not an asset archive", path.c_str());
+    return false;
+  }
+  uint32_t version = readU32(base + 4);
+  if (version != ASSET_ARCHIVE_VERSION) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "AssetArchive: '%s' is version %u, expected %u; repack it",
+                 path.c_str(), version, ASSET_ARCHIVE_VERSION);
+    return false;
+  }
+  uint64_t indexOffset = readU64(base + 8);
+  uint64_t indexSize = readU64(base + 16);
+  manifestHash = readU64(base + 24);
+  if (indexOffset > mappedSize || indexSize > mappedSize - indexOffset) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "AssetArchive: '%s' is truncated", path.c_str());
+    return false;
+  }
+
+  std::string index(reinterpret_cast<const char *>(base + indexOffset),
+                    static_cast<size_t>(indexSize));
+  std::string error;
+  entries.clear();
+  if (!parseAssetArchiveIndex(index, entries, error)) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "AssetArchive: bad index in '%s': %s", path.c_str(),
+                 error.c_str());
+    return false;
+  }
+  for (const AssetManifestEntry &entry : entries) {
+    if (entry.offset > indexOffset || entry.size > indexOffset - entry.offset) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                   "AssetArchive: entry '%s' in '%s' is out of bounds",
+                   entry.name.c_str(), path.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+void AssetArchive::close() {
+  if (base) {
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char *>(base), mappedSize);
+#endif
+  }
+  base = nullptr;
+  mappedSize = 0;
+  manifestHash = 0;
+  entries.clear();
+}
+
+const AssetManifestEntry *AssetArchive::find(const std::string &name) const {
+  for (const AssetManifestEntry &entry : entries) {
+    if (entry.name == name)
+      return &entry;
+  }
+  return nullptr;
+}
+
+SDL_RWops *AssetArchive::openEntry(const AssetManifestEntry &entry) const {
+  if (!base)
+    return nullptr;
+  return SDL_RWFromConstMem(data(entry), static_cast<int>(entry.size));
+}
+
+static bool readTextFile(const std::string &path, std::string &text) {
+  SDL_RWops *file = SDL_RWFromFile(path.c_str(), "rb");
+  if (!file)
+    return false;
+  text.assign(static_cast<size_t>(SDL_RWsize(file)), '\0');
+  size_t read = text.empty() ? 0 : SDL_RWread(file, &text[0], 1, text.size());
+  SDL_RWclose(file);
+  text.resize(read);
+  return true;
+}
+
+bool openAssetSources(AssetArchive &archive, const std::string &archivePath,
+                      const std::string &looseManifestPath,
+                      std::vector<AssetManifestEntry> &entries) {
+  entries.clear();
+  std::string text;
+  bool haveManifest = readTextFile(looseManifestPath, text);
+  if (archive.open(archivePath)) {
+    if (!haveManifest) {
+      entries = archive.getEntries();
+      return true;
+    }
+    // A development tree has both; an archive not repacked after the
+    // manifest changed would otherwise hide the change
+    if (archive.getManifestHash() == hashAssetManifest(text)) {
+      SDL_Log("Asset archive '%s' matches '%s'; its index takes precedence.",
+              archivePath.c_str(), looseManifestPath.c_str());
+      entries = archive.getEntries();
+      return true;
+    }
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "Asset archive '%s' was packed from a different '%s'; "
+                "ignoring it and loading the loose files. Repack to use it.",
+                archivePath.c_str(), looseManifestPath.c_str());
+    archive.close();
+  }
+
+  if (!haveManifest) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "No asset archive at '%s' and no manifest at '%s': %s",
+                 archivePath.c_str(), looseManifestPath.c_str(),
+                 SDL_GetError());
+    return false;
+  }
+
+  std::string error;
+  if (!parseAssetManifest(text, entries, error)) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bad asset manifest '%s': %s",
+                 looseManifestPath.c_str(), error.c_str());
+    return false;
+  }
+  SDL_Log("Loading %zu loose files listed in '%s'.",
+          entries.size(), looseManifestPath.c_str());
+  return true;
+}
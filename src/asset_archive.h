@@ -0,0 +1,65 @@
+// src/asset_archive.h
+#ifndef ASSET_ARCHIVE_H
+#define ASSET_ARCHIVE_H
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include "asset_manifest.h" // For AssetManifestEntry and the archive layout
+
+// --- Asset Archive ---
+// Read-only view of an assets.pak written by tools/asset_packer. The whole
+// file is memory-mapped once; loading an entry wraps its bytes in a
+// constant-memory SDL_RWops, so nothing is copied and pages are read in by
+// the OS as the decoders touch them.
+//
+// Entries stay valid only while the archive is open. Fonts read their file
+// lazily, so the archive has to outlive every font loaded from it.
+class AssetArchive {
+public:
+  AssetArchive() = default;
+  ~AssetArchive();
+  AssetArchive(const AssetArchive &) = delete;
+  AssetArchive &operator=(const AssetArchive &) = delete;
+
+  // Maps the archive and reads its index. Returns false (logged, unless the
+  // file simply isn't there) if it can't be used.
+  bool open(const std::string &path);
+  void close();
+  bool isOpen() const { return base != nullptr; }
+
+  const std::vector<AssetManifestEntry> &getEntries() const { return entries; }
+  const AssetManifestEntry *find(const std::string &name) const;
+  // hashAssetManifest of the manifest the archive was packed from.
+  uint64_t getManifestHash() const { return manifestHash; }
+
+  // The entry's bytes inside the mapping.
+  const void *data(const AssetManifestEntry &entry) const {
+    return base + entry.offset;
+  }
+  // A read-only stream over the entry; free it (or pass freesrc = 1).
+  SDL_RWops *openEntry(const AssetManifestEntry &entry) const;
+
+private:
+  bool readIndex(const std::string &path);
+
+  const unsigned char *base = nullptr;
+  size_t mappedSize = 0;
+  uint64_t manifestHash = 0;
+#ifdef _WIN32
+  void *fileHandle = nullptr;    // HANDLE
+  void *mappingHandle = nullptr; // HANDLE
+#endif
+  std::vector<AssetManifestEntry> entries;
+};
+
+// Where to load from: the archive next to the executable if there is one
+// (entries then come from its index), otherwise the loose files listed in
+// looseManifestPath. If both are there but the archive was packed from a
+// different manifest, it's stale: that's logged and the loose files win.
+// Fills `entries`; false if neither could be read.
+bool openAssetSources(AssetArchive &archive, const std::string &archivePath,
+                      const std::string &looseManifestPath,
+                      std::vector<AssetManifestEntry> &entries);
+
+#endif // ASSET_ARCHIVE_H
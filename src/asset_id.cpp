@@ -0,0 +1,41 @@
+// src/asset_id.cpp
+#include "asset_id.h"
+#include <unordered_map>
+
+// Function-local so interning from static initialisers is safe
+static std::unordered_map<std::string, uint32_t> &idsByName() {
+  static std::unordered_map<std::string, uint32_t> ids;
+  return ids;
+}
+static std::vector<std::string> &namesById() {
+  static std::vector<std::string> names;
+  return names;
+}
+
+AssetId internAssetName(const std::string &name) {
+  auto &ids = idsByName();
+  auto it = ids.find(name);
+  if (it != ids.end()) return AssetId{it->second};
+  std::vector<std::string> &names = namesById();
+  uint32_t index = static_cast<uint32_t>(names.size());
+  names.push_back(name);
+  ids.emplace(name, index);
+  return AssetId{index};
+}
+
+std::vector<AssetId> internAssetNames(const std::vector<std::string> &names) {
+  std::vector<AssetId> ids;
+  ids.reserve(names.size());
+  for (const std::string &name : names) {
+    ids.push_back(internAssetName(name));
+  }
+  return ids;
+}
+
+const std::string &assetNameOf(AssetId id) {
+  static const std::string empty;
+  const std::vector<std::string> &names = namesById();
+  return id.index < names.size() ? names[id.index] : empty;
+}
+
+size_t internedAssetCount() { return namesById().size(); }
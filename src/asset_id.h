@@ -0,0 +1,37 @@
+// src/asset_id.h
+#ifndef ASSET_ID_H
+#define ASSET_ID_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// --- Asset Id ---
+// Small integer standing for an asset name. Names are interned once (at load
+// time, or when an archetype or character is set up) and AssetManager keeps
+// its textures and sprites in arrays indexed by id, so a per-frame lookup is
+// a bounds check and an index instead of a string map search.
+//
+// Interning isn't thread-safe; do it on the main thread. Looking ids up is
+// safe from anywhere once they exist.
+struct AssetId {
+  static const uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+  uint32_t index = INVALID_INDEX;
+
+  bool isValid() const { return index != INVALID_INDEX; }
+  bool operator==(const AssetId &other) const { return index == other.index; }
+  bool operator!=(const AssetId &other) const { return index != other.index; }
+};
+
+// Id for name, assigning the next free one the first time a name is seen.
+AssetId internAssetName(const std::string &name);
+// Interns each name in order.
+std::vector<AssetId> internAssetNames(const std::vector<std::string> &names);
+// Name an id was interned from; empty for an invalid id. The reference is
+// good until the next name is interned.
+const std::string &assetNameOf(AssetId id);
+// Number of ids handed out so far (one past the largest index).
+size_t internedAssetCount();
+
+#endif // ASSET_ID_H
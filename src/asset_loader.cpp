@@ -0,0 +1,135 @@
+// src/asset_loader.cpp
+#include "asset_loader.h"
+#include "asset_manager.h"
+#include <SDL_image.h>
+
+AssetLoader::AssetLoader(AssetManager &assetManager, JobSystem &jobSystem)
+    : assets(assetManager), jobs(jobSystem) {}
+
+AssetLoader::~AssetLoader() {
+  if (started)
+    jobs.wait(decodeJobs); // Jobs write into requests
+  for (Request &request : requests) {
+    if (!request.handedOver && request.image)
+      SDL_FreeSurface(request.image);
+  }
+}
+
+void AssetLoader::queueTexture(const std::string &name,
+                               const std::string &path) {
+  requests.emplace_back(name, path, false);
+}
+
+void AssetLoader::queueSprite(const std::string &name,
+                              const std::string &path) {
+  requests.emplace_back(name, path, true);
+}
+
+void AssetLoader::queueTexture(const std::string &name, const void *data,
+                               size_t size, const std::string &source) {
+  requests.emplace_back(name, source, false, data, size);
+}
+
+void AssetLoader::queueSprite(const std::string &name, const void *data,
+                              size_t size, const std::string &source) {
+  requests.emplace_back(name, source, true, data, size);
+}
+
+// IMG_Load and surface conversion don't touch the renderer, and SDL keeps
+// the error string per thread.
+SDL_Surface *decodeAssetImage(const std::string &path, const void *data,
+                              size_t size, bool isSprite, std::string &error) {
+  SDL_Surface *loaded =
+      data ? IMG_Load_RW(SDL_RWFromConstMem(data, static_cast<int>(size)), 1)
+           : IMG_Load(path.c_str());
+  if (loaded && isSprite) {
+    // One pixel format for every sprite so packing is a plain copy
+    SDL_Surface *converted =
+        SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    loaded = converted;
+  }
+  if (!loaded)
+    error = SDL_GetError();
+  return loaded;
+}
+
+// Runs on a worker.
+void AssetLoader::decode(Request &request) {
+  request.image = decodeAssetImage(request.path, request.data,
+                                   request.dataSize, request.isSprite,
+                                   request.error);
+}
+
+void AssetLoader::start() {
+  if (started)
+    return;
+  started = true;
+  SDL_Log("AssetLoader: decoding %zu files on %u threads.", requests.size(),
+          jobs.getThreadCount());
+  for (Request &request : requests) {
+    Request *target = &request;
+    jobs.submit(
+        [this, target]() {
+          decode(*target);
+          target->decoded.store(true, std::memory_order_release);
+          decodedCount.fetch_add(1, std::memory_order_relaxed);
+        },
+        &decodeJobs);
+  }
+}
+
+bool AssetLoader::pump(int maxUploads, Uint32 budgetMs) {
+  if (!started)
+    start();
+
+  // Lend this thread to the decoders for a while
+  Uint32 begin = SDL_GetTicks();
+  while (SDL_GetTicks() - begin < budgetMs && jobs.tryRunJob()) {
+  }
+
+  // Hand over what's ready, in any order
+  int uploads = 0;
+  for (size_t i = nextToHandOver; i < requests.size() && uploads < maxUploads;
+       ++i) {
+    Request &request = requests[i];
+    if (request.handedOver ||
+        !request.decoded.load(std::memory_order_acquire))
+      continue;
+    request.handedOver = true;
+    handedOver++;
+    SDL_Surface *image = request.image;
+    request.image = nullptr; // The manager owns it (or it's gone) from here
+    if (!image) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                   "Failed to load %s '%s' from '%s': %s",
+                   request.isSprite ? "sprite" : "texture",
+                   request.name.c_str(), request.path.c_str(),
+                   request.error.c_str());
+      failures++;
+      continue;
+    }
+    bool added = request.isSprite ? assets.addSprite(request.name, image)
+                                  : assets.addTexture(request.name, image);
+    if (!added)
+      failures++;
+    if (!request.isSprite)
+      uploads++; // Sprites only reach the GPU with the atlas
+  }
+  while (nextToHandOver < requests.size() &&
+         requests[nextToHandOver].handedOver)
+    nextToHandOver++;
+
+  if (isDone()) {
+    jobs.wait(decodeJobs); // Lets the last job leave its counter
+    return true;
+  }
+  return false;
+}
+
+float AssetLoader::progress() const {
+  if (requests.empty())
+    return 1.0f;
+  float total = static_cast<float>(requests.size()) * 2.0f;
+  return (decodedCount.load(std::memory_order_relaxed) + handedOver) / total;
+}
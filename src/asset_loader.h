@@ -0,0 +1,95 @@
+// src/asset_loader.h
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SDL.h>
+#include <atomic>
+#include <deque>
+#include <string>
+#include "job_system.h" // For JobSystem / JobCounter
+
+class AssetManager;
+
+// Textures handed to the renderer per pump() call. Creating a texture is a
+// GPU upload, so this bounds how long a loading-screen frame can take.
+const int ASSET_UPLOADS_PER_PUMP = 8;
+
+// Decodes one image: the file at path, or the encoded bytes at data when
+// that's set (path then only names them). Sprites come back RGBA32, the
+// format the atlas packs. Safe on any thread; returns nullptr and sets
+// error on failure.
+SDL_Surface *decodeAssetImage(const std::string &path, const void *data,
+                              size_t size, bool isSprite, std::string &error);
+
+// --- Asset Loader ---
+// Decodes image files on the job system's workers and hands them to the
+// AssetManager on the main thread, where textures have to be created.
+//
+// Queue everything, start(), then call pump() once per frame until it
+// returns true; between pumps the caller is free to draw progress(). pump()
+// also decodes on the calling thread for up to its time budget, so loading
+// still finishes with --single-thread.
+//
+// Sprites are handed over as surfaces (AssetManager::addSprite); they reach
+// the GPU when the caller builds the atlas afterwards.
+class AssetLoader {
+public:
+  AssetLoader(AssetManager &assets, JobSystem &jobs);
+  // Waits for any decode still running and frees what was never handed over.
+  ~AssetLoader();
+  AssetLoader(const AssetLoader &) = delete;
+  AssetLoader &operator=(const AssetLoader &) = delete;
+
+  // Same meaning as AssetManager::loadTexture / loadSprite, but deferred.
+  void queueTexture(const std::string &name, const std::string &path);
+  void queueSprite(const std::string &name, const std::string &path);
+  // Decode from bytes already in memory (an AssetArchive entry) instead of a
+  // file. The bytes must stay put until the loader is done; source names
+  // them in errors.
+  void queueTexture(const std::string &name, const void *data, size_t size,
+                    const std::string &source);
+  void queueSprite(const std::string &name, const void *data, size_t size,
+                   const std::string &source);
+
+  // Submits a decode job per queued file. Queue nothing after this.
+  void start();
+  // Helps decode for up to budgetMs, then hands over up to maxUploads
+  // decoded images. Returns true once every file has been handed over.
+  bool pump(int maxUploads = ASSET_UPLOADS_PER_PUMP, Uint32 budgetMs = 12);
+
+  // 0..1: decoding and handing over each count for half.
+  float progress() const;
+  bool isDone() const { return handedOver == requests.size(); }
+  // False if any file failed to load (each failure is logged).
+  bool succeeded() const { return failures == 0; }
+
+private:
+  struct Request {
+    Request(const std::string &n, const std::string &p, bool s,
+            const void *d = nullptr, size_t size = 0)
+        : name(n), path(p), isSprite(s), data(d), dataSize(size) {}
+    std::string name;
+    std::string path; // File to read, or just a label when data is set
+    bool isSprite;
+    const void *data; // Encoded image in memory, if not read from path
+    size_t dataSize;
+    SDL_Surface *image = nullptr; // Written by the decode job
+    std::string error;            // Ditto, when image is nullptr
+    std::atomic<bool> decoded{false};
+    bool handedOver = false;
+  };
+
+  static void decode(Request &request);
+
+  AssetManager &assets;
+  JobSystem &jobs;
+  std::deque<Request> requests; // Deque: jobs hold pointers into it
+  JobCounter decodeJobs;
+  std::atomic<size_t> decodedCount{0};
+  size_t handedOver = 0;
+  size_t nextToHandOver = 0; // Everything before this is handed over
+  int failures = 0;
+  bool started = false;
+};
+
+#endif // ASSET_LOADER_H
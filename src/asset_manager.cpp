@@ -1,6 +1,13 @@
 // asset_manager.cpp
 #include "asset_manager.h"
+#include "asset_residency.h"
+#include <algorithm> // For std::min
 #include <iostream> // For error messages if needed (or use SDL_Log)
+#include <vector>
+
+// reportedMissing bits
+static const Uint8 MISSING_TEXTURE = 1;
+static const Uint8 MISSING_SPRITE = 2;
 
 AssetManager::AssetManager(SDL_Renderer* renderer) : rendererRef(renderer) {
     if (!rendererRef) {
@@ -19,29 +26,72 @@ AssetManager::~AssetManager() {
 // --- Loading ---
 
 bool AssetManager::loadTexture(const std::string& name, const std::string& path) {
-    if (!rendererRef) return false; // Cannot load without renderer
+    return loadTexture(name, SDL_RWFromFile(path.c_str(), "rb"), path);
+}
+
+bool AssetManager::loadTexture(const std::string& name, SDL_RWops* stream, const std::string& source) {
+    if (!rendererRef) { // Cannot load without renderer
+        if (stream) SDL_RWclose(stream);
+        return false;
+    }
 
-    SDL_Texture* texture = IMG_LoadTexture(rendererRef, path.c_str());
+    SDL_Texture* texture = stream ? IMG_LoadTexture_RW(rendererRef, stream, 1) : nullptr;
     if (!texture) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load texture '%s' from path '%s': %s", name.c_str(), path.c_str(), IMG_GetError());
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load texture '%s' from '%s': %s", name.c_str(), source.c_str(), IMG_GetError());
         return false;
     }
 
+    AssetId id = internAssetName(name);
+    if (textures.size() <= id.index) {
+        textures.resize(id.index + 1, nullptr);
+    }
     // Optional: Check if name already exists and handle (e.g., log warning, don't overwrite)
-    if (textures.count(name)) {
+    if (textures[id.index]) {
          SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Texture name '%s' already exists. Overwriting.", name.c_str());
-         SDL_DestroyTexture(textures[name]); // Destroy old one before replacing
+         SDL_DestroyTexture(textures[id.index]); // Destroy old one before replacing
+    }
+
+    textures[id.index] = texture;
+    SDL_Log("Loaded Texture '%s' from '%s'", name.c_str(), source.c_str());
+    return true;
+}
+
+bool AssetManager::addTexture(const std::string& name, SDL_Surface* image) {
+    if (!image) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No image given for texture '%s'", name.c_str());
+        return false;
+    }
+    if (!rendererRef) {
+        SDL_FreeSurface(image);
+        return false;
+    }
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(rendererRef, image);
+    SDL_FreeSurface(image);
+    if (!texture) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create texture '%s': %s", name.c_str(), SDL_GetError());
+        return false;
     }
 
-    textures[name] = texture;
-    SDL_Log("Loaded Texture '%s' from '%s'", name.c_str(), path.c_str());
+    AssetId id = internAssetName(name);
+    if (textures.size() <= id.index) {
+        textures.resize(id.index + 1, nullptr);
+    }
+    if (textures[id.index]) {
+         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Texture name '%s' already exists. Overwriting.", name.c_str());
+         SDL_DestroyTexture(textures[id.index]);
+    }
+    textures[id.index] = texture;
     return true;
 }
 
 bool AssetManager::loadFont(const std::string& name, const std::string& path, int pointSize) {
-    TTF_Font* font = TTF_OpenFont(path.c_str(), pointSize);
+    return loadFont(name, SDL_RWFromFile(path.c_str(), "rb"), pointSize, path);
+}
+
+bool AssetManager::loadFont(const std::string& name, SDL_RWops* stream, int pointSize, const std::string& source) {
+    TTF_Font* font = stream ? TTF_OpenFontRW(stream, 1, pointSize) : nullptr;
     if (!font) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load font '%s' from path '%s': %s", name.c_str(), path.c_str(), TTF_GetError());
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load font '%s' from '%s': %s", name.c_str(), source.c_str(), TTF_GetError());
         return false;
     }
 
@@ -51,21 +101,203 @@ bool AssetManager::loadFont(const std::string& name, const std::string& path, in
     }
 
     fonts[name] = font;
-    SDL_Log("Loaded Font '%s' from '%s' (%dpt)", name.c_str(), path.c_str(), pointSize);
+    SDL_Log("Loaded Font '%s' from '%s' (%dpt)", name.c_str(), source.c_str(), pointSize);
+    return true;
+}
+
+bool AssetManager::loadSprite(const std::string& name, const std::string& path) {
+    SDL_Surface* loaded = IMG_Load(path.c_str());
+    if (!loaded) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load sprite '%s' from path '%s': %s", name.c_str(), path.c_str(), IMG_GetError());
+        return false;
+    }
+    // One pixel format for every sprite so packing is a plain copy
+    SDL_Surface* image = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    if (!image) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to convert sprite '%s': %s", name.c_str(), SDL_GetError());
+        return false;
+    }
+
+    if (pendingSprites.count(name)) {
+         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Sprite name '%s' already exists. Overwriting.", name.c_str());
+         SDL_FreeSurface(pendingSprites[name]);
+    }
+    pendingSprites[name] = image;
+    SDL_Log("Loaded Sprite '%s' from '%s'", name.c_str(), path.c_str());
+    return true;
+}
+
+bool AssetManager::addSprite(const std::string& name, SDL_Surface* image) {
+    if (!image) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No image given for sprite '%s'", name.c_str());
+        return false;
+    }
+    SDL_Surface* converted = image;
+    if (image->format->format != SDL_PIXELFORMAT_RGBA32) {
+        converted = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(image);
+        if (!converted) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to convert sprite '%s': %s", name.c_str(), SDL_GetError());
+            return false;
+        }
+    }
+
+    if (pendingSprites.count(name)) {
+         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Sprite name '%s' already exists. Overwriting.", name.c_str());
+         SDL_FreeSurface(pendingSprites[name]);
+    }
+    pendingSprites[name] = converted;
+    return true;
+}
+
+bool AssetManager::buildAtlas(const std::string& dumpPath) {
+    if (!rendererRef) return false;
+
+    // Pages as big as the renderer allows, up to 2048 (fine on any GPU)
+    int pageSize = 2048;
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(rendererRef, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0) {
+        pageSize = std::min(pageSize, std::min(info.max_texture_width, info.max_texture_height));
+    }
+
+    std::vector<std::pair<std::string, SDL_Surface*>> images(pendingSprites.begin(), pendingSprites.end());
+    bool success = atlas.build(rendererRef, images, pageSize, dumpPath);
+    for (auto const& [name, image] : pendingSprites) {
+        // Resolve each name once; the atlas's entries don't move after build
+        AssetId id = internAssetName(name);
+        if (sprites.size() <= id.index) {
+            sprites.resize(id.index + 1, nullptr);
+        }
+        sprites[id.index] = atlas.find(name);
+        SDL_FreeSurface(image);
+    }
+    pendingSprites.clear();
+    return success;
+}
+
+// --- Hot reload ---
+
+bool AssetManager::reloadTexture(AssetId id, SDL_Surface* image) {
+    if (!image) return false;
+    if (residency && residency->isLazy(id) && (id.index >= textures.size() || !textures[id.index])) {
+        SDL_FreeSurface(image); // Not resident; it's read afresh when next loaded
+        return true;
+    }
+    SDL_Texture* texture = rendererRef ? SDL_CreateTextureFromSurface(rendererRef, image) : nullptr;
+    SDL_FreeSurface(image);
+    if (!texture) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to recreate texture '%s': %s", assetNameOf(id).c_str(), SDL_GetError());
+        return false;
+    }
+    if (textures.size() <= id.index) {
+        textures.resize(id.index + 1, nullptr);
+    }
+    if (SDL_Texture* old = textures[id.index]) {
+        // Keep whatever blend and modulation the game set on the old one
+        SDL_BlendMode blend;
+        Uint8 r, g, b, a;
+        if (SDL_GetTextureBlendMode(old, &blend) == 0) SDL_SetTextureBlendMode(texture, blend);
+        if (SDL_GetTextureColorMod(old, &r, &g, &b) == 0) SDL_SetTextureColorMod(texture, r, g, b);
+        if (SDL_GetTextureAlphaMod(old, &a) == 0) SDL_SetTextureAlphaMod(texture, a);
+        SDL_DestroyTexture(old);
+    }
+    textures[id.index] = texture;
+    SDL_Log("Reloaded texture '%s'", assetNameOf(id).c_str());
+    return true;
+}
+
+bool AssetManager::reloadSprite(AssetId id, SDL_Surface* image) {
+    if (!image) return false;
+    const std::string& name = assetNameOf(id);
+    bool replaced = atlas.find(name) ? atlas.replace(name, image)
+                                     : residency && residency->replaceSprite(id, image);
+    SDL_FreeSurface(image);
+    if (replaced) SDL_Log("Reloaded sprite '%s'", name.c_str());
+    return replaced;
+}
+
+bool AssetManager::reloadFont(const std::string& name, std::string fileData, int pointSize) {
+    // Heap-held so the bytes don't move once the font is reading them
+    auto data = std::make_unique<std::string>(std::move(fileData));
+    SDL_RWops* stream = SDL_RWFromConstMem(data->data(), static_cast<int>(data->size()));
+    TTF_Font* font = stream ? TTF_OpenFontRW(stream, 1, pointSize) : nullptr;
+    if (!font) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to reload font '%s': %s", name.c_str(), TTF_GetError());
+        return false;
+    }
+    auto it = fonts.find(name);
+    if (it != fonts.end() && it->second) {
+        TTF_CloseFont(it->second); // Before its data goes below
+    }
+    fonts[name] = font;
+    fontData[name] = std::move(data);
+    SDL_Log("Reloaded font '%s' (%dpt)", name.c_str(), pointSize);
     return true;
 }
 
+// --- Residency ---
+
+void AssetManager::setResidency(AssetResidency* newResidency) {
+    residency = newResidency;
+    if (!residency || placeholderTexture || !rendererRef) return;
+    // One transparent pixel: lazily loaded things just aren't drawn for the
+    // frame or two before they arrive, and gameplay never sees a nullptr
+    placeholderTexture = SDL_CreateTexture(rendererRef, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 1, 1);
+    if (!placeholderTexture) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create placeholder texture: %s", SDL_GetError());
+        return;
+    }
+    const Uint32 clear = 0;
+    SDL_UpdateTexture(placeholderTexture, nullptr, &clear, sizeof(clear));
+    SDL_SetTextureBlendMode(placeholderTexture, SDL_BLENDMODE_BLEND);
+    placeholderSprite.texture = placeholderTexture;
+    placeholderSprite.source = {0, 0, 1, 1};
+    placeholderSprite.u1 = 1.0f;
+    placeholderSprite.v1 = 1.0f;
+}
+
+void AssetManager::prefetch(const std::vector<std::string>& groups) {
+    if (residency) residency->prefetch(groups);
+}
+
+void AssetManager::unloadTexture(AssetId id) {
+    if (id.index < textures.size() && textures[id.index]) {
+        SDL_DestroyTexture(textures[id.index]);
+        textures[id.index] = nullptr;
+    }
+}
+
+void AssetManager::setSprite(AssetId id, const AtlasSprite* sprite) {
+    if (sprites.size() <= id.index) {
+        sprites.resize(id.index + 1, nullptr);
+    }
+    sprites[id.index] = sprite;
+}
+
 // --- Accessors ---
 
-SDL_Texture* AssetManager::getTexture(const std::string& name) {
-    // Use find for efficiency and to avoid inserting if not found
-    auto it = textures.find(name);
-    if (it != textures.end()) {
-        return it->second; // Return pointer to the found texture
-    } else {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Texture '%s' not found in AssetManager!", name.c_str());
-        return nullptr;
+void AssetManager::reportMissing(AssetId id, Uint8 kindBit, const char* kind) const {
+    if (!id.isValid()) return;
+    if (reportedMissing.size() <= id.index) {
+        reportedMissing.resize(id.index + 1, 0);
     }
+    if (reportedMissing[id.index] & kindBit) return;
+    reportedMissing[id.index] |= kindBit;
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s '%s' not found in AssetManager! (Reported once.)",
+                 kind, assetNameOf(id).c_str());
+}
+
+SDL_Texture* AssetManager::getTexture(AssetId id) const {
+    if (id.index < textures.size() && textures[id.index]) {
+        if (residency) residency->touch(id);
+        return textures[id.index];
+    }
+    if (residency && residency->touch(id)) {
+        return placeholderTexture; // Loading
+    }
+    reportMissing(id, MISSING_TEXTURE, "Texture");
+    return nullptr;
 }
 
 TTF_Font* AssetManager::getFont(const std::string& name) {
@@ -78,14 +310,25 @@ TTF_Font* AssetManager::getFont(const std::string& name) {
     }
 }
 
+const AtlasSprite* AssetManager::getSprite(AssetId id) const {
+    if (id.index < sprites.size() && sprites[id.index]) {
+        if (residency) residency->touch(id);
+        return sprites[id.index];
+    }
+    if (residency && residency->touch(id)) {
+        return placeholderTexture ? &placeholderSprite : nullptr; // Loading
+    }
+    reportMissing(id, MISSING_SPRITE, "Sprite");
+    return nullptr;
+}
+
 // --- Cleanup ---
 
 void AssetManager::clearAssets() {
     // Destroy textures
-    for (auto const& [name, texture] : textures) {
+    for (SDL_Texture* texture : textures) {
         if (texture) {
             SDL_DestroyTexture(texture);
-            // SDL_Log("Destroyed texture '%s'", name.c_str()); // Verbose logging if needed
         }
     }
     textures.clear();
@@ -98,6 +341,21 @@ void AssetManager::clearAssets() {
         }
     }
     fonts.clear();
+    fontData.clear();
+
+    // Sprites: decoded images never packed, then the atlas pages
+    for (auto const& [name, image] : pendingSprites) {
+        SDL_FreeSurface(image);
+    }
+    pendingSprites.clear();
+    sprites.clear();
+    atlas.clear();
+    reportedMissing.clear();
+    if (placeholderTexture) {
+        SDL_DestroyTexture(placeholderTexture);
+        placeholderTexture = nullptr;
+        placeholderSprite = AtlasSprite();
+    }
 
     // Add sound/music cleanup here later
 }
\ No newline at end of file
@@ -3,12 +3,18 @@
 #define ASSET_MANAGER_H
 
 #include <string>
-#include <map> // To store assets by name
+#include <map> // To store fonts by name
+#include <memory>
+#include <vector>
 #include <SDL.h>
 #include <SDL_image.h>
 #include <SDL_ttf.h>
+#include "asset_id.h"      // For AssetId
+#include "texture_atlas.h" // For TextureAtlas / AtlasSprite
 // #include <SDL_mixer.h> // For future sound/music
 
+class AssetResidency;
+
 class AssetManager {
 public:
     // Constructor: Needs the renderer to create textures
@@ -21,13 +27,59 @@ public:
     bool loadTexture(const std::string& name, const std::string& path);
     // Loads a font, stores it under 'name'. Returns true on success.
     bool loadFont(const std::string& name, const std::string& path, int pointSize);
+    // Same, reading from an open stream (e.g. AssetArchive::openEntry), which
+    // is always closed. 'source' names where it came from, for the log.
+    bool loadTexture(const std::string& name, SDL_RWops* stream, const std::string& source);
+    // A font keeps reading its stream after this returns, so whatever backs
+    // the stream has to outlive the font.
+    bool loadFont(const std::string& name, SDL_RWops* stream, int pointSize, const std::string& source);
+    // Decodes an in-world sprite and queues it for the atlas. It can't be
+    // drawn until buildAtlas() has run; fetch it with getSprite, not getTexture.
+    bool loadSprite(const std::string& name, const std::string& path);
+    // Makes a texture from an already decoded image (see AssetLoader), taking
+    // ownership of the image. Main thread only.
+    bool addTexture(const std::string& name, SDL_Surface* image);
+    // Queues an image made at runtime for the atlas, taking ownership of it.
+    bool addSprite(const std::string& name, SDL_Surface* image);
+    // Packs every queued sprite into atlas pages and frees the decoded images.
+    // A non-empty dumpPath also writes the pages and their frame index to disk.
+    bool buildAtlas(const std::string& dumpPath = "");
     // Add loadSound, loadMusic later...
 
+    // --- Hot reload (see AssetWatcher) ---
+    // Swap a freshly decoded asset in under its existing name, so holders of
+    // its AssetId or name get the new one from their next lookup. Each takes
+    // ownership of what it's given; on failure the old asset stays.
+    bool reloadTexture(AssetId id, SDL_Surface* image);
+    // The sprite must keep its size (it's rewritten in place in the atlas).
+    bool reloadSprite(AssetId id, SDL_Surface* image);
+    // fileData is the whole font file; it's kept for as long as the font.
+    bool reloadFont(const std::string& name, std::string fileData, int pointSize);
+
+    // --- Residency (see AssetResidency) ---
+    // Lazily loaded groups are looked up through the same getters: asking
+    // for one marks it used this frame and, if it isn't resident, starts
+    // loading it and returns a transparent placeholder until it arrives.
+    void setResidency(AssetResidency* residency);
+    // Hint that these groups are about to be needed (e.g. the next floor's).
+    void prefetch(const std::vector<std::string>& groups);
+    // For AssetResidency: drop a texture, or point an id at a sprite in an
+    // atlas it owns (nullptr when that atlas goes).
+    void unloadTexture(AssetId id);
+    void setSprite(AssetId id, const AtlasSprite* sprite);
+    SDL_Renderer* getRenderer() const { return rendererRef; }
+
     // --- Accessor Functions ---
+    // Per-frame lookups take an AssetId (see asset_id.h): a plain array index.
+    // A missing asset is reported once, not every frame it's asked for.
     // Gets a previously loaded texture. Returns nullptr if not found.
-    SDL_Texture* getTexture(const std::string& name);
+    SDL_Texture* getTexture(AssetId id) const;
+    SDL_Texture* getTexture(const std::string& name) const { return getTexture(internAssetName(name)); }
     // Gets a previously loaded font. Returns nullptr if not found.
     TTF_Font* getFont(const std::string& name);
+    // Gets a sprite's place in the atlas. Returns nullptr if not found.
+    const AtlasSprite* getSprite(AssetId id) const;
+    const AtlasSprite* getSprite(const std::string& name) const { return getSprite(internAssetName(name)); }
     // Add getSound, getMusic later...
 
 private:
@@ -38,14 +90,24 @@ private:
     // Pointer to the main renderer (doesn't own it)
     SDL_Renderer* rendererRef;
 
-    // Storage for assets
-    std::map<std::string, SDL_Texture*> textures;
+    // Storage for assets; textures and sprites are indexed by AssetId
+    std::vector<SDL_Texture*> textures;
     std::map<std::string, TTF_Font*> fonts;
+    std::map<std::string, std::unique_ptr<std::string>> fontData; // Reloaded fonts read from these
+    std::map<std::string, SDL_Surface*> pendingSprites; // Decoded, not packed yet
+    TextureAtlas atlas;
+    std::vector<const AtlasSprite*> sprites; // Into atlas, filled by buildAtlas
+    mutable std::vector<Uint8> reportedMissing; // MISSING_* bits per AssetId
+    AssetResidency* residency = nullptr; // Not owned
+    SDL_Texture* placeholderTexture = nullptr; // Stands in while a group loads
+    AtlasSprite placeholderSprite;
     // std::map<std::string, Mix_Chunk*> sounds;
     // std::map<std::string, Mix_Music*> music;
 
     // Helper for cleanup
     void clearAssets();
+    // Logs that id wasn't found as a texture or sprite, the first time only.
+    void reportMissing(AssetId id, Uint8 kindBit, const char* kind) const;
 };
 
 #endif // ASSET_MANAGER_H
\ No newline at end of file
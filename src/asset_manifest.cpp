@@ -0,0 +1,172 @@
+// src/asset_manifest.cpp
+#include "asset_manifest.h"
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+const char *assetKindName(AssetKind kind) {
+  switch (kind) {
+  case AssetKind::Texture: return "texture";
+  case AssetKind::Sprite: return "sprite";
+  case AssetKind::Font: return "font";
+  }
+  return "texture";
+}
+
+static bool parseKind(const std::string &word, AssetKind &kind) {
+  if (word == "texture")
+    kind = AssetKind::Texture;
+  else if (word == "sprite")
+    kind = AssetKind::Sprite;
+  else if (word == "font")
+    kind = AssetKind::Font;
+  else
+    return false;
+  return true;
+}
+
+std::string assetFormatOf(const std::string &path) {
+  size_t dot = path.find_last_of('.');
+  size_t slash = path.find_last_of("/\\");
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    return "";
+  std::string format = path.substr(dot + 1);
+  for (char &c : format)
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  return format;
+}
+
+uint64_t hashAssetManifest(const std::string &text) {
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : text) {
+    if (c == '\r')
+      continue;
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// Calls parseLine(words, error) for every non-blank, non-comment line.
+template <typename LineParser>
+static bool forEachLine(const std::string &text, std::string &error,
+                        LineParser parseLine) {
+  std::istringstream lines(text);
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(lines, line)) {
+    lineNumber++;
+    size_t hash = line.find('#');
+    if (hash != std::string::npos)
+      line.erase(hash);
+    std::istringstream fields(line);
+    std::vector<std::string> words;
+    std::string word;
+    while (fields >> word)
+      words.push_back(word);
+    if (words.empty())
+      continue;
+    std::string lineError;
+    if (!parseLine(words, lineError)) {
+      error = "line " + std::to_string(lineNumber) + ": " + lineError;
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool parseInt(const std::string &word, long long &value) {
+  if (word.empty())
+    return false;
+  char *end = nullptr;
+  value = std::strtoll(word.c_str(), &end, 10);
+  return end && *end == '\0' && value >= 0;
+}
+
+bool parseAssetManifest(const std::string &text,
+                        std::vector<AssetManifestEntry> &out,
+                        std::string &error) {
+  std::string group;
+  return forEachLine(text, error, [&](const std::vector<std::string> &words,
+                                      std::string &lineError) {
+    if (words[0] == "group") {
+      if (words.size() != 2) {
+        lineError = "expected group <name>";
+        return false;
+      }
+      group = words[1] == "core" ? "" : words[1];
+      return true;
+    }
+    AssetManifestEntry entry;
+    entry.group = group;
+    if (!parseKind(words[0], entry.kind)) {
+      lineError = "unknown kind '" + words[0] + "'";
+      return false;
+    }
+    size_t expected = entry.kind == AssetKind::Font ? 4 : 3;
+    if (words.size() != expected) {
+      lineError = entry.kind == AssetKind::Font
+                      ? "expected font <name> <path> <pointSize>"
+                      : "expected <kind> <name> <path>";
+      return false;
+    }
+    entry.name = words[1];
+    entry.path = words[2];
+    entry.format = assetFormatOf(entry.path);
+    if (entry.kind == AssetKind::Font) {
+      long long size = 0;
+      if (!parseInt(words[3], size) || size == 0) {
+        lineError = "bad point size '" + words[3] + "'";
+        return false;
+      }
+      entry.fontSize = static_cast<int>(size);
+    }
+    out.push_back(entry);
+    return true;
+  });
+}
+
+std::string
+writeAssetArchiveIndex(const std::vector<AssetManifestEntry> &entries) {
+  std::ostringstream index;
+  for (const AssetManifestEntry &entry : entries) {
+    index << assetKindName(entry.kind) << ' ' << entry.name << ' '
+          << entry.offset << ' ' << entry.size << ' '
+          << (entry.format.empty() ? "-" : entry.format) << ' '
+          << (entry.group.empty() ? "-" : entry.group);
+    if (entry.kind == AssetKind::Font)
+      index << ' ' << entry.fontSize;
+    index << '\n';
+  }
+  return index.str();
+}
+
+bool parseAssetArchiveIndex(const std::string &text,
+                            std::vector<AssetManifestEntry> &out,
+                            std::string &error) {
+  return forEachLine(text, error, [&out](const std::vector<std::string> &words,
+                                         std::string &lineError) {
+    AssetManifestEntry entry;
+    if (!parseKind(words[0], entry.kind)) {
+      lineError = "unknown kind '" + words[0] + "'";
+      return false;
+    }
+    size_t expected = entry.kind == AssetKind::Font ? 7 : 6;
+    long long offset = 0, size = 0, fontSize = 0;
+    if (words.size() != expected || !parseInt(words[2], offset) ||
+        !parseInt(words[3], size) ||
+        (entry.kind == AssetKind::Font && !parseInt(words[6], fontSize))) {
+      lineError = "malformed index entry";
+      return false;
+    }
+    entry.name = words[1];
+    entry.path = entry.name; // Loose path isn't kept in the archive
+    entry.offset = static_cast<uint64_t>(offset);
+    entry.size = static_cast<uint64_t>(size);
+    entry.format = words[4] == "-" ? "" : words[4];
+    entry.group = words[5] == "-" ? "" : words[5];
+    entry.fontSize = static_cast<int>(fontSize);
+    out.push_back(entry);
+    return true;
+  });
+}
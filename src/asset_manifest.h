@@ -0,0 +1,76 @@
+// src/asset_manifest.h
+#ifndef ASSET_MANIFEST_H
+#define ASSET_MANIFEST_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// --- Asset Manifest ---
+// The list of everything the game loads, kept as data in assets/manifest.txt
+// rather than as load calls in main(). One asset per line, '#' starts a
+// comment, fields are separated by whitespace (so names and paths can't
+// contain spaces):
+//
+//   texture <name> <path>              A standalone texture
+//   sprite  <name> <path>              Packed into the sprite atlas
+//   font    <name> <path> <pointSize>  A TTF font at one size
+//   group   <name>                     Entries below belong to this group
+//
+// Paths are relative to the assets directory. The same file may be listed
+// more than once (one font at several sizes).
+//
+// Entries before the first group line are core: loaded at startup and kept.
+// Grouped entries are loaded on first use and may be evicted together (see
+// AssetResidency); `group core` goes back to core entries.
+//
+// This file has no SDL dependency so tools/asset_packer.cpp can share it.
+
+enum class AssetKind : uint8_t { Texture, Sprite, Font };
+
+struct AssetManifestEntry {
+  AssetKind kind = AssetKind::Texture;
+  std::string name;
+  std::string path;  // Relative to the assets directory
+  int fontSize = 0;  // Fonts only
+  std::string group; // Empty for core assets
+  // Filled in for entries read from an archive index
+  uint64_t offset = 0; // Byte offset of the file in the archive
+  uint64_t size = 0;   // Byte length
+  std::string format;  // Lower-case file extension ("png", "ttf")
+};
+
+// Parses manifest text into `out`. On a malformed line returns false with
+// `error` naming it; entries before it are kept.
+bool parseAssetManifest(const std::string &text,
+                        std::vector<AssetManifestEntry> &out,
+                        std::string &error);
+
+// --- Archive layout (assets.pak) ---
+// Little-endian header, then each file's bytes (16-byte aligned, each file
+// stored once), then the index: one line per manifest entry,
+//   <kind> <name> <offset> <size> <format> <group or -> [<pointSize>]
+const char ASSET_ARCHIVE_MAGIC[4] = {'W', 'R', 'P', 'K'};
+const uint32_t ASSET_ARCHIVE_VERSION = 3;
+// magic, version, index offset, index size, hash of the manifest it was
+// packed from (hashAssetManifest)
+const size_t ASSET_ARCHIVE_HEADER_SIZE = 32;
+const size_t ASSET_ARCHIVE_ALIGNMENT = 16;
+
+// Index text for entries whose offset, size and format are set.
+std::string
+writeAssetArchiveIndex(const std::vector<AssetManifestEntry> &entries);
+// Parses index text written by writeAssetArchiveIndex.
+bool parseAssetArchiveIndex(const std::string &text,
+                            std::vector<AssetManifestEntry> &out,
+                            std::string &error);
+
+// FNV-1a of manifest text, ignoring '\r' so a checkout's line endings
+// don't matter. Tells the game an archive is older than the manifest.
+uint64_t hashAssetManifest(const std::string &text);
+
+const char *assetKindName(AssetKind kind);
+// Lower-case extension of path, without the dot ("" if there is none).
+std::string assetFormatOf(const std::string &path);
+
+#endif // ASSET_MANIFEST_H
@@ -0,0 +1,241 @@
+// src/asset_residency.cpp
+#include "asset_residency.h"
+#include "asset_archive.h"
+#include "asset_loader.h" // For decodeAssetImage
+#include "asset_manager.h"
+#include <algorithm>
+#include <utility>
+
+// Bytes a texture of this size holds on the GPU (always 32-bit here)
+static size_t textureBytes(SDL_Texture *texture) {
+  int w = 0, h = 0;
+  if (!texture || SDL_QueryTexture(texture, nullptr, nullptr, &w, &h) != 0)
+    return 0;
+  return static_cast<size_t>(w) * static_cast<size_t>(h) * 4;
+}
+
+AssetResidency::AssetResidency(AssetManager &assetManager,
+                               JobSystem &jobSystem,
+                               const AssetArchive &assetArchive,
+                               const std::string &looseAssetRoot)
+    : assets(assetManager), jobs(jobSystem), archive(assetArchive),
+      looseRoot(looseAssetRoot) {}
+
+AssetResidency::~AssetResidency() {
+  jobs.wait(decodeJobs); // Jobs write into the groups' decodes
+  for (Group &group : groups) {
+    for (std::unique_ptr<Decode> &decode : group.decodes) {
+      if (decode->image)
+        SDL_FreeSurface(decode->image);
+    }
+    evict(group);
+  }
+  assets.setResidency(nullptr);
+}
+
+void AssetResidency::addEntry(const AssetManifestEntry &manifest) {
+  if (manifest.group.empty() || manifest.kind == AssetKind::Font) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "AssetResidency: '%s' can't be loaded lazily; skipped.",
+                manifest.name.c_str());
+    return;
+  }
+  auto found = std::find_if(groups.begin(), groups.end(), [&](const Group &g) {
+    return g.name == manifest.group;
+  });
+  if (found == groups.end()) {
+    groups.emplace_back();
+    groups.back().name = manifest.group;
+    found = groups.end() - 1;
+  }
+  int groupIndex = static_cast<int>(found - groups.begin());
+
+  Entry entry;
+  entry.manifest = manifest;
+  entry.id = internAssetName(manifest.name);
+  entry.group = groupIndex;
+  found->entries.push_back(entries.size());
+  entries.push_back(entry);
+  if (groupOfId.size() <= entry.id.index) {
+    groupOfId.resize(entry.id.index + 1, -1);
+    failedIds.resize(entry.id.index + 1, false);
+  }
+  groupOfId[entry.id.index] = groupIndex;
+}
+
+bool AssetResidency::touch(AssetId id) {
+  int groupIndex = groupIndexOf(id);
+  if (groupIndex < 0)
+    return false;
+  Group &group = groups[groupIndex];
+  group.lastUsed = frame;
+  if (group.state == GroupState::Unloaded)
+    request(group);
+  return !failedIds[id.index];
+}
+
+void AssetResidency::prefetch(const std::vector<std::string> &names) {
+  for (Group &group : groups) {
+    if (std::find(names.begin(), names.end(), group.name) == names.end())
+      continue;
+    // Counts as a use so it isn't the first thing evicted
+    group.lastUsed = frame;
+    if (group.state == GroupState::Unloaded) {
+      SDL_Log("AssetResidency: prefetching '%s'.", group.name.c_str());
+      request(group);
+    }
+  }
+}
+
+void AssetResidency::request(Group &group) {
+  group.state = GroupState::Loading;
+  group.decodes.clear();
+  for (size_t index : group.entries) {
+    group.decodes.push_back(std::make_unique<Decode>());
+    Decode *target = group.decodes.back().get();
+    target->entry = index;
+    const Entry *entry = &entries[index];
+    const void *data = nullptr;
+    size_t size = 0;
+    std::string path = looseRoot + entry->manifest.path;
+    if (archive.isOpen()) {
+      data = archive.data(entry->manifest);
+      size = static_cast<size_t>(entry->manifest.size);
+      path = entry->manifest.path;
+    }
+    jobs.submit(
+        [target, entry, data, size, path]() {
+          target->image = decodeAssetImage(
+              path, data, size, entry->manifest.kind == AssetKind::Sprite,
+              target->error);
+          target->decoded.store(true, std::memory_order_release);
+        },
+        &decodeJobs);
+  }
+}
+
+void AssetResidency::update() {
+  for (Group &group : groups) {
+    if (group.state != GroupState::Loading)
+      continue;
+    bool allDecoded = std::all_of(
+        group.decodes.begin(), group.decodes.end(),
+        [](const std::unique_ptr<Decode> &decode) {
+          return decode->decoded.load(std::memory_order_acquire);
+        });
+    if (allDecoded)
+      finishLoading(group);
+  }
+  evictToBudget();
+  frame++;
+}
+
+void AssetResidency::finishLoading(Group &group) {
+  Uint32 start = SDL_GetTicks();
+  std::vector<std::pair<std::string, SDL_Surface *>> spriteImages;
+  group.bytes = 0;
+  for (std::unique_ptr<Decode> &decode : group.decodes) {
+    const Entry &entry = entries[decode->entry];
+    SDL_Surface *image = decode->image;
+    decode->image = nullptr;
+    if (!image) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                   "AssetResidency: failed to load '%s' (group '%s'): %s",
+                   entry.manifest.name.c_str(), group.name.c_str(),
+                   decode->error.c_str());
+      failedIds[entry.id.index] = true;
+      continue;
+    }
+    if (entry.manifest.kind == AssetKind::Sprite) {
+      spriteImages.emplace_back(entry.manifest.name, image);
+    } else if (assets.addTexture(entry.manifest.name, image)) {
+      group.bytes += textureBytes(assets.getTexture(entry.id));
+    } else {
+      failedIds[entry.id.index] = true;
+    }
+  }
+  group.decodes.clear();
+
+  if (!spriteImages.empty()) {
+    group.atlas = std::make_unique<TextureAtlas>();
+    if (!group.atlas->build(assets.getRenderer(), spriteImages, 2048)) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                   "AssetResidency: failed to build the atlas for group "
+                   "'%s'.",
+                   group.name.c_str());
+    }
+    for (auto &named : spriteImages)
+      SDL_FreeSurface(named.second);
+    // A failed build can still have packed some pages; whatever isn't in
+    // the atlas is missing until the group is next loaded
+    for (size_t index : group.entries) {
+      const Entry &entry = entries[index];
+      if (entry.manifest.kind != AssetKind::Sprite)
+        continue;
+      const AtlasSprite *sprite = group.atlas->find(entry.manifest.name);
+      assets.setSprite(entry.id, sprite);
+      if (!sprite)
+        failedIds[entry.id.index] = true;
+    }
+    group.bytes += group.atlas->getMemoryBytes();
+  }
+
+  group.state = GroupState::Resident;
+  residentBytes += group.bytes;
+  SDL_Log("AssetResidency: loaded '%s' (%zu KB) in %u ms; %zu KB resident.",
+          group.name.c_str(), group.bytes / 1024, SDL_GetTicks() - start,
+          residentBytes / 1024);
+}
+
+void AssetResidency::evict(Group &group) {
+  if (group.state != GroupState::Resident)
+    return;
+  for (size_t index : group.entries) {
+    const Entry &entry = entries[index];
+    if (entry.manifest.kind == AssetKind::Sprite)
+      assets.setSprite(entry.id, nullptr);
+    else
+      assets.unloadTexture(entry.id);
+    failedIds[entry.id.index] = false; // Tried again on the next load
+  }
+  group.atlas.reset();
+  residentBytes -= group.bytes;
+  group.bytes = 0;
+  group.state = GroupState::Unloaded;
+}
+
+void AssetResidency::evictToBudget() {
+  if (budgetBytes == 0 || residentBytes <= budgetBytes)
+    return;
+  std::vector<Group *> candidates;
+  for (Group &group : groups) {
+    // Recently used groups stay, or a working set over budget would be
+    // evicted and reloaded every frame
+    if (group.state == GroupState::Resident &&
+        group.lastUsed + ASSET_MIN_IDLE_FRAMES <= frame)
+      candidates.push_back(&group);
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Group *a, const Group *b) {
+              return a->lastUsed < b->lastUsed;
+            });
+  for (Group *group : candidates) {
+    if (residentBytes <= budgetBytes)
+      break;
+    SDL_Log("AssetResidency: evicting '%s' (%zu KB, unused for %llu "
+            "frames).",
+            group->name.c_str(), group->bytes / 1024,
+            static_cast<unsigned long long>(frame - group->lastUsed));
+    evict(*group);
+  }
+}
+
+bool AssetResidency::replaceSprite(AssetId id, SDL_Surface *image) {
+  int groupIndex = groupIndexOf(id);
+  if (groupIndex < 0)
+    return false;
+  Group &group = groups[groupIndex];
+  if (group.state != GroupState::Resident || !group.atlas)
+    return false; // Read afresh when it's next loaded
+  return group.atlas->replace(assetNameOf(id), image);
+}
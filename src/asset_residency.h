@@ -0,0 +1,115 @@
+// src/asset_residency.h
+#ifndef ASSET_RESIDENCY_H
+#define ASSET_RESIDENCY_H
+
+#include <SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "asset_id.h"       // For AssetId
+#include "asset_manifest.h" // For AssetManifestEntry
+#include "job_system.h"     // For JobSystem / JobCounter
+#include "texture_atlas.h"  // For each group's atlas
+
+class AssetArchive;
+class AssetManager;
+
+// Frames a group must go unused before it can be evicted
+const uint64_t ASSET_MIN_IDLE_FRAMES = 120;
+
+// --- Asset Residency ---
+// Keeps the manifest's grouped assets (see asset_manifest.h) in memory only
+// while they're in use. A group is the unit of loading and eviction: one
+// enemy archetype's frames, one screen's art.
+//
+// The first lookup of any asset in a group (through AssetManager's getters)
+// queues the whole group for decoding on the job system; until it's
+// uploaded, lookups get a transparent placeholder. A group's sprites get an
+// atlas of their own so it can be freed as a piece.
+//
+// Each lookup stamps the group with the current frame. When the resident
+// groups' textures add up to more than the budget, the least recently used
+// groups are evicted, but only ones idle for ASSET_MIN_IDLE_FRAMES; if what's
+// in use is bigger than the budget, the budget gives. Core (ungrouped)
+// assets aren't counted and are never evicted.
+class AssetResidency {
+public:
+  // Entries with a non-empty path are read from looseRoot + path, or from
+  // the archive when it's open.
+  AssetResidency(AssetManager &assets, JobSystem &jobs,
+                 const AssetArchive &archive, const std::string &looseRoot);
+  // Waits for decodes still running and unloads every group.
+  ~AssetResidency();
+  AssetResidency(const AssetResidency &) = delete;
+  AssetResidency &operator=(const AssetResidency &) = delete;
+
+  // Adds a grouped manifest entry. Textures and sprites only.
+  void addEntry(const AssetManifestEntry &entry);
+  void setBudget(size_t bytes) { budgetBytes = bytes; }
+
+  // Marks id's group used this frame, requesting it if it isn't loaded.
+  // Returns false if id isn't in any group, or its group loaded without it
+  // (so the caller reports it missing rather than showing the placeholder).
+  bool touch(AssetId id);
+  bool isLazy(AssetId id) const { return groupIndexOf(id) >= 0; }
+  // Starts loading groups before anything asks for them. Unknown names are
+  // ignored, so content sets can name groups that don't exist yet.
+  void prefetch(const std::vector<std::string> &groups);
+
+  // Main thread, once per frame before drawing: uploads groups whose
+  // decodes have all finished, then evicts down to the budget.
+  void update();
+
+  // Hot reload of a resident group's sprite; false if it can't be done.
+  bool replaceSprite(AssetId id, SDL_Surface *image);
+
+  size_t getResidentBytes() const { return residentBytes; }
+
+private:
+  enum class GroupState { Unloaded, Loading, Resident };
+  struct Entry {
+    AssetManifestEntry manifest;
+    AssetId id;
+    int group = -1;
+  };
+  struct Decode {
+    size_t entry = 0;
+    SDL_Surface *image = nullptr; // Written by the job
+    std::string error;            // Ditto, when image is nullptr
+    std::atomic<bool> decoded{false};
+  };
+  struct Group {
+    std::string name;
+    std::vector<size_t> entries;
+    GroupState state = GroupState::Unloaded;
+    uint64_t lastUsed = 0;
+    size_t bytes = 0;
+    std::vector<std::unique_ptr<Decode>> decodes; // While Loading
+    std::unique_ptr<TextureAtlas> atlas;          // While Resident
+  };
+
+  int groupIndexOf(AssetId id) const {
+    return id.index < groupOfId.size() ? groupOfId[id.index] : -1;
+  }
+  void request(Group &group);
+  void finishLoading(Group &group);
+  void evict(Group &group);
+  void evictToBudget();
+
+  AssetManager &assets;
+  JobSystem &jobs;
+  const AssetArchive &archive;
+  std::string looseRoot;
+  std::vector<Entry> entries;
+  std::vector<Group> groups;
+  std::vector<int> groupOfId; // Group index per AssetId, -1 for core
+  std::vector<bool> failedIds; // Per AssetId: its resident group lacks it
+  JobCounter decodeJobs;
+  size_t budgetBytes = 0;
+  size_t residentBytes = 0;
+  uint64_t frame = 1;
+};
+
+#endif // ASSET_RESIDENCY_H
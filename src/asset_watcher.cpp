@@ -0,0 +1,189 @@
+// src/asset_watcher.cpp
+#include "asset_watcher.h"
+#include "asset_loader.h" // For decodeAssetImage
+#include "asset_manager.h"
+#include <algorithm>
+#include <set>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+AssetWatcher::AssetWatcher(AssetManager &assetManager, JobSystem &jobSystem)
+    : assets(assetManager), jobs(jobSystem) {}
+
+AssetWatcher::~AssetWatcher() {
+  jobs.wait(decodeJobs); // Jobs write into inFlight
+  for (std::unique_ptr<Reload> &reload : inFlight) {
+    if (reload->image)
+      SDL_FreeSurface(reload->image);
+  }
+#ifdef __linux__
+  if (watchFd >= 0)
+    close(watchFd); // Drops every watch with it
+#endif
+}
+
+bool AssetWatcher::start(const std::string &assetRoot,
+                         const std::vector<AssetManifestEntry> &entries) {
+#ifdef __linux__
+  if (watchFd >= 0)
+    return true;
+  watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (watchFd < 0) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "AssetWatcher: inotify_init1 failed: %s",
+                 std::strerror(errno));
+    return false;
+  }
+
+  std::set<std::string> directories;
+  for (const AssetManifestEntry &entry : entries) {
+    Watched file;
+    file.entry = entry;
+    file.id = internAssetName(entry.name);
+    file.fullPath = assetRoot + entry.path;
+    size_t slash = file.fullPath.find_last_of('/');
+    directories.insert(slash == std::string::npos
+                           ? std::string(".")
+                           : file.fullPath.substr(0, slash));
+    watched.push_back(file);
+  }
+  // Editors often save by writing a temporary file and renaming it over the
+  // original, so watch directories for both kinds of arrival.
+  for (const std::string &directory : directories) {
+    int wd = inotify_add_watch(watchFd, directory.c_str(),
+                               IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) {
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "AssetWatcher: can't watch '%s': %s", directory.c_str(),
+                  std::strerror(errno));
+      continue;
+    }
+    watchedDirs[wd] = directory;
+  }
+  SDL_Log("AssetWatcher: watching %zu files in %zu directories.",
+          watched.size(), watchedDirs.size());
+  return true;
+#else
+  (void)assetRoot;
+  (void)entries;
+  SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+              "AssetWatcher: hot reload needs inotify and is Linux-only.");
+  return false;
+#endif
+}
+
+void AssetWatcher::readEvents(std::vector<std::string> &changedPaths) {
+#ifdef __linux__
+  alignas(inotify_event) char buffer[4096];
+  for (;;) {
+    ssize_t length = read(watchFd, buffer, sizeof(buffer));
+    if (length <= 0)
+      break; // EAGAIN: nothing more this frame
+    for (char *at = buffer; at < buffer + length;) {
+      const inotify_event *event = reinterpret_cast<inotify_event *>(at);
+      at += sizeof(inotify_event) + event->len;
+      auto dir = watchedDirs.find(event->wd);
+      if (dir == watchedDirs.end() || event->len == 0)
+        continue;
+      std::string path = dir->second + "/" + event->name;
+      if (std::find(changedPaths.begin(), changedPaths.end(), path) ==
+          changedPaths.end())
+        changedPaths.push_back(path);
+    }
+  }
+#else
+  (void)changedPaths;
+#endif
+}
+
+// Runs on a worker: file I/O and decoding only, nothing that touches the
+// renderer or FreeType.
+void AssetWatcher::decode(const Watched &watched, Reload &reload) {
+  const AssetManifestEntry &entry = watched.entry;
+  if (entry.kind == AssetKind::Font) {
+    SDL_RWops *file = SDL_RWFromFile(watched.fullPath.c_str(), "rb");
+    Sint64 size = file ? SDL_RWsize(file) : -1;
+    if (size > 0) {
+      reload.fileData.resize(static_cast<size_t>(size));
+      if (SDL_RWread(file, &reload.fileData[0], 1, reload.fileData.size()) !=
+          reload.fileData.size())
+        reload.fileData.clear();
+    }
+    if (file)
+      SDL_RWclose(file);
+    if (reload.fileData.empty())
+      reload.error = SDL_GetError();
+    return;
+  }
+
+  reload.image = decodeAssetImage(watched.fullPath, nullptr, 0,
+                                  entry.kind == AssetKind::Sprite,
+                                  reload.error);
+}
+
+int AssetWatcher::poll() {
+  if (watchFd < 0)
+    return 0;
+
+  // --- Start a decode per changed file ---
+  std::vector<std::string> changedPaths;
+  readEvents(changedPaths);
+  for (const std::string &path : changedPaths) {
+    for (size_t i = 0; i < watched.size(); ++i) {
+      if (watched[i].fullPath != path)
+        continue;
+      auto reload = std::make_unique<Reload>();
+      reload->watched = i;
+      reload->generation = ++watched[i].generation;
+      Reload *target = reload.get();
+      const Watched *file = &watched[i];
+      inFlight.push_back(std::move(reload));
+      jobs.submit(
+          [file, target]() {
+            decode(*file, *target);
+            target->decoded.store(true, std::memory_order_release);
+          },
+          &decodeJobs);
+    }
+  }
+
+  // --- Swap in whatever finished; never wait on the rest ---
+  int spritesSwapped = 0;
+  for (size_t i = 0; i < inFlight.size();) {
+    Reload &reload = *inFlight[i];
+    if (!reload.decoded.load(std::memory_order_acquire)) {
+      ++i;
+      continue;
+    }
+    const Watched &file = watched[reload.watched];
+    const AssetManifestEntry &entry = file.entry;
+    if (reload.generation != file.generation) {
+      // Saved again since; a newer decode is on its way
+      if (reload.image)
+        SDL_FreeSurface(reload.image);
+    } else if (!reload.error.empty()) {
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "AssetWatcher: couldn't reload '%s' from '%s': %s",
+                  entry.name.c_str(), file.fullPath.c_str(),
+                  reload.error.c_str());
+      if (reload.image)
+        SDL_FreeSurface(reload.image);
+    } else if (entry.kind == AssetKind::Font) {
+      assets.reloadFont(entry.name, std::move(reload.fileData),
+                        entry.fontSize);
+    } else if (entry.kind == AssetKind::Sprite) {
+      if (assets.reloadSprite(file.id, reload.image))
+        spritesSwapped++;
+    } else {
+      assets.reloadTexture(file.id, reload.image);
+    }
+    reload.image = nullptr;
+    inFlight.erase(inFlight.begin() + i);
+  }
+  return spritesSwapped;
+}
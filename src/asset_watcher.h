@@ -0,0 +1,76 @@
+// src/asset_watcher.h
+#ifndef ASSET_WATCHER_H
+#define ASSET_WATCHER_H
+
+#include <SDL.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "asset_id.h"       // For AssetId
+#include "asset_manifest.h" // For AssetManifestEntry
+#include "job_system.h"     // For JobSystem / JobCounter
+
+class AssetManager;
+
+// --- Asset Watcher ---
+// Development aid (--hot-reload): watches the directories of the loose asset
+// files and, when one is saved, decodes it again on the job system and
+// swaps it into the AssetManager under the same name and AssetId. Anything
+// that looks its asset up each frame shows the new one on the next frame.
+//
+// Textures and fonts are replaced outright. Sprites are rewritten in place
+// in their atlas page, so they have to keep their size; anything else needs
+// a restart.
+//
+// Uses inotify, so it only works on Linux; elsewhere start() says so and
+// returns false.
+class AssetWatcher {
+public:
+  AssetWatcher(AssetManager &assets, JobSystem &jobs);
+  // Waits for decodes still running and stops watching.
+  ~AssetWatcher();
+  AssetWatcher(const AssetWatcher &) = delete;
+  AssetWatcher &operator=(const AssetWatcher &) = delete;
+
+  // Watches the files `entries` list under assetRoot (loose manifest
+  // entries; see openAssetSources).
+  bool start(const std::string &assetRoot,
+             const std::vector<AssetManifestEntry> &entries);
+  bool isWatching() const { return watchFd >= 0; }
+
+  // Main thread, once per frame before drawing: reads file events, starts a
+  // decode per changed file and swaps in the ones that finished. Returns how
+  // many sprites were swapped (the caller redraws whatever baked them in).
+  int poll();
+
+private:
+  struct Watched {
+    AssetManifestEntry entry;
+    AssetId id;
+    std::string fullPath;
+    int generation = 0; // Bumped per change; older decodes are dropped
+  };
+  struct Reload {
+    size_t watched = 0;
+    int generation = 0;
+    SDL_Surface *image = nullptr; // Textures and sprites
+    std::string fileData;         // Fonts
+    std::string error;
+    std::atomic<bool> decoded{false};
+  };
+
+  void readEvents(std::vector<std::string> &changedPaths);
+  static void decode(const Watched &watched, Reload &reload);
+
+  AssetManager &assets;
+  JobSystem &jobs;
+  std::vector<Watched> watched;
+  std::map<int, std::string> watchedDirs; // Watch descriptor -> directory
+  std::vector<std::unique_ptr<Reload>> inFlight;
+  JobCounter decodeJobs;
+  int watchFd = -1;
+};
+
+#endif // ASSET_WATCHER_H
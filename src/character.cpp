@@ -4,6 +4,7 @@
 #include "enemy.h"
 #include "game_data.h"
 #include "projectile.h"
+#include "turn_scheduler.h" // For BASE_ACTION_COST
 #include "utils.h"
 #include "visibility.h"
 #include <algorithm> // For std::max/min
@@ -61,6 +62,9 @@ PlayerCharacter::PlayerCharacter(CharacterType t, int initialTileX,
     // Add male frames here if/when you create them
     idleFrameTextureNames = {/* e.g., "male_mage_idle_1", ... */};
   }
+  idleFrameIds = internAssetNames(idleFrameTextureNames);
+  walkFrameIds = internAssetNames(walkFrameTextureNames);
+  targetingFrameIds = internAssetNames(targetingFrameTextureNames);
 }
 
 // --- NEW: Getter Methods ---
@@ -80,6 +84,12 @@ int PlayerCharacter::GetEffectiveAgility() const {
   return baseAgility + (level - 1) * AGILITY_PER_LEVEL;
 }
 
+int PlayerCharacter::GetActionCost() const {
+  int gained = GetEffectiveAgility() - baseAgility;
+  return std::max(MIN_ACTION_COST,
+                  BASE_ACTION_COST - gained * ACTION_COST_PER_AGILITY);
+}
+
 // --- NEW: Stat Calculation ---
 void PlayerCharacter::RecalculateStats() {
   // Calculate effective core stats (using getters for clarity, though could
@@ -232,7 +242,7 @@ void PlayerCharacter::takeDamage(int amount) {
 
 // Modify castSpell to use calculated spellDamageModifier and check calculated
 maxMana bool PlayerCharacter::castSpell(int spellIndex, int castTargetX, int
-castTargetY, std::vector<Enemy>& enemies, std::vector<Projectile>& projectiles,
+castTargetY, EnemyStore& enemies, std::vector<Projectile>& projectiles,
     SDL_Texture* projectileTexture) {
 
     // ... (Check spellIndex validity) ...
@@ -363,6 +373,7 @@ void PlayerCharacter::update(float deltaTime, GameData &gameData) {
           currentVisualTileY, // Use current visual tile Y
           gameData.hallwayVisibilityDistance,
           gameData.visibilityMap); // Pass the visibility map from gameData
+      gameData.terrainCache.invalidateFog();
     }
     // --- END Per-Frame Visibility Update ---
 
@@ -397,20 +408,21 @@ void PlayerCharacter::update(float deltaTime, GameData &gameData) {
           oldTileY >= 0 && oldTileY < gameData.currentLevel.height) {
         // Check if it was *supposed* to be occupied by the player before
         // clearing This check might be overly complex depending on grid update
-        // strategy. gameData.occupationGrid[oldTileY][oldTileX] = false; //
+        // strategy. gameData.occupancy.vacate(oldTileX, oldTileY); //
         // Simple clear
       }
       // Set new position (check bounds) - This should already be true from move
       // initiation
       if (targetTileX >= 0 && targetTileX < gameData.currentLevel.width &&
           targetTileY >= 0 && targetTileY < gameData.currentLevel.height) {
-        if (!gameData.occupationGrid[targetTileY][targetTileX]) {
+        if (gameData.occupancy.at(targetTileX, targetTileY).kind !=
+            OccupantKind::Player) {
           SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                       "Player finished move at [%d,%d] but grid wasn't marked "
                       "occupied!",
                       targetTileX, targetTileY);
-          gameData.occupationGrid[targetTileY][targetTileX] =
-              true; // Ensure it's set
+          gameData.occupancy.place(targetTileX, targetTileY,
+                                   Occupant::player()); // Ensure it's set
         }
       } else {
         SDL_LogWarn(
@@ -438,6 +450,7 @@ void PlayerCharacter::update(float deltaTime, GameData &gameData) {
                        targetTileY, // Use final logical Y
                        gameData.hallwayVisibilityDistance,
                        gameData.visibilityMap);
+      gameData.terrainCache.invalidateFog();
 
     } else {
       // Interpolate visual position during movement
@@ -533,7 +546,7 @@ void PlayerCharacter::takeDamage(int amount) {
 }
 // Placeholder for castSpell - NEEDS LATER MODIFICATION for damage based on Int
 bool PlayerCharacter::castSpell(int spellIndex, int castTargetX,
-                                int castTargetY, std::vector<Enemy> &enemies,
+                                int castTargetY, EnemyStore &enemies,
                                 std::vector<Projectile> &projectiles,
                                 AssetManager *assets) // Changed parameter type
 {
@@ -577,22 +590,22 @@ bool PlayerCharacter::castSpell(int spellIndex, int castTargetX,
         spell.targetType == SpellTargetType::Area) {
 
       // --- Find Target Enemy ID (for homing projectiles) ---
-      int targetId = -1; // Default: -1 indicates no specific enemy target
-                         // (e.g., targeting a tile)
+      EnemyHandle targetHandle; // Default: invalid, no specific enemy target
+                                // (e.g., targeting a tile)
       // Only search for an enemy ID if the spell specifically targets enemies
       if (spell.targetType == SpellTargetType::Enemy) {
         for (const auto &enemy : enemies) {
           // Check if a living enemy exists at the target logical coordinates
           if (enemy.health > 0 && enemy.x == castTargetX &&
               enemy.y == castTargetY) {
-            targetId = enemy.id; // Store the ID of the found enemy
-            SDL_Log("CastSpell: Found target Enemy ID %d at [%d,%d].", targetId,
+            targetHandle = enemy.handle; // Store the handle of the found enemy
+            SDL_Log("CastSpell: Found target Enemy ID %d at [%d,%d].", enemy.id,
                     castTargetX, castTargetY);
             break; // Stop searching once found
           }
         }
         // Log if no enemy was found at the targeted tile
-        if (targetId == -1) {
+        if (!targetHandle.isValid()) {
           SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                       "CastSpell: Targeted enemy at [%d,%d] but no living "
                       "enemy found there.",
@@ -611,10 +624,12 @@ bool PlayerCharacter::castSpell(int spellIndex, int castTargetX,
       else
         projectileTextureName = spell.iconName; // Fallback to icon name? Risky.
 
+      AssetId projTextureId;
       SDL_Texture *projTexture = nullptr;
       if (assets &&
           !projectileTextureName.empty()) { // Check if assets pointer is valid
-        projTexture = assets->getTexture(projectileTextureName);
+        projTextureId = internAssetName(projectileTextureName);
+        projTexture = assets->getTexture(projTextureId);
       }
 
       if (projTexture) {
@@ -637,10 +652,10 @@ bool PlayerCharacter::castSpell(int spellIndex, int castTargetX,
             ProjectileType::Firebolt; // Determine type based on spell if needed
 
         // Add the projectile to the active list
-        projectiles.emplace_back(pType, projTexture, projWidth, projHeight,
+        projectiles.emplace_back(pType, projTextureId, projWidth, projHeight,
                                  startVisualX, startVisualY, targetVisualX,
                                  targetVisualY, projectileSpeed,
-                                 calculatedDamage, targetId);
+                                 calculatedDamage, targetHandle);
         SDL_Log("CastSpell: Launched '%s' projectile towards [%d,%d] with %d "
                 "damage.",
                 spell.name.c_str(), castTargetX, castTargetY, calculatedDamage);
@@ -2,6 +2,7 @@
 #ifndef CHARACTER_H
 #define CHARACTER_H
 
+#include "asset_id.h"   // For interned frame keys
 #include "projectile.h" // Include projectile definition for casting spells
 #include "spell.h"      // Include your spell definitions
 #include <SDL.h> // For SDL_Texture* forward declaration if needed, or include fully
@@ -11,7 +12,8 @@
 // Forward declaration to avoid circular dependency if AssetManager is only used
 // for pointer/ref in header
 class AssetManager;
-class Enemy;     // Forward declare Enemy
+class Enemy;      // Forward declare Enemy
+class EnemyStore; // Forward declare EnemyStore
 struct GameData; // Forward declare GameData
 
 // --- Constants for Leveling (Example Placeholder Values) ---
@@ -26,6 +28,8 @@ const int HP_PER_VITALITY = 10;
 const int MANA_PER_INTELLIGENCE = 5;
 const float MANA_REGEN_PER_SPIRIT = 0.1f;
 const float SPEED_MOD_PER_AGILITY = 0.005f;
+const int ACTION_COST_PER_AGILITY = 2; // Game time saved per agility point gained
+const int MIN_ACTION_COST = 40;
 
 enum class CharacterType { FemaleMage, MaleMage };
 
@@ -78,10 +82,12 @@ struct PlayerCharacter {
       4.0f; // Frames per second (adjust as needed), made non-const
   std::vector<std::string>
       idleFrameTextureNames; // Holds the keys for all idle frames
+  std::vector<AssetId> idleFrameIds; // The same keys interned, for rendering
 
   // ADDED: Walking Animation Data
   std::vector<std::string>
       walkFrameTextureNames; // Holds keys for walking frames
+  std::vector<AssetId> walkFrameIds;
   float walkAnimationTimer = 0.0f;
   int currentWalkFrame = 0;
   float walkAnimationSpeed =
@@ -90,6 +96,7 @@ struct PlayerCharacter {
   // ADDED: Targeting Animation Data
   std::vector<std::string>
       targetingFrameTextureNames; // Holds keys for targeting frames
+  std::vector<AssetId> targetingFrameIds;
   float targetingAnimationTimer = 0.0f;
   int currentTargetingFrame = 0;
   float targetingAnimationSpeed =
@@ -121,12 +128,15 @@ struct PlayerCharacter {
   int GetEffectiveIntelligence() const;
   int GetEffectiveSpirit() const;
   int GetEffectiveAgility() const;
+  // Game time one action takes (see turn_scheduler.h); agility gained since
+  // level 1 makes it shorter, so enemies get fewer actions per player turn
+  int GetActionCost() const;
 
   // --- Spellcasting Methods ---
   bool canCastSpell(int spellIndex) const;
   // Pass AssetManager by pointer or reference if needed for textures
   bool castSpell(int spellIndex, int targetX, int targetY,
-                 std::vector<Enemy> &enemies,
+                 EnemyStore &enemies,
                  std::vector<Projectile> &projectiles,
                  AssetManager *assets); // Pass AssetManager
   const Spell &getSpell(int spellIndex) const;
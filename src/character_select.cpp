@@ -1,10 +1,9 @@
 #include "character_select.h"
 #include <SDL.h>
 #include <SDL_ttf.h>
-#include <SDL_image.h>
 #include <string>
 
-void displayCharacterSelect(SDL_Renderer* renderer, TTF_Font* font, int selectedIndex, int windowWidth, int windowHeight, Uint8 alpha) {
+void displayCharacterSelect(SDL_Renderer* renderer, TTF_Font* font, SDL_Texture* femaleMageTexture, SDL_Texture* maleMageTexture, int selectedIndex, int windowWidth, int windowHeight, Uint8 alpha) {
     SDL_SetRenderDrawColor(renderer, 50, 50, 50, alpha); // Apply alpha to background
     SDL_RenderClear(renderer);
 
@@ -15,36 +14,12 @@ void displayCharacterSelect(SDL_Renderer* renderer, TTF_Font* font, int selected
     SDL_Color textColorWithAlpha = {textColor.r, textColor.g, textColor.b, alpha};
     SDL_Color highlightColorWithAlpha = {highlightColor.r, highlightColor.g, highlightColor.b, alpha};
 
-    // Load the male mage avatar
-    SDL_Texture* maleMageTexture = nullptr;
-    SDL_Surface* maleSurface = IMG_Load("../assets/sprites/male_mage.png"); // Adjust path as needed
-    if (maleSurface) {
-        maleMageTexture = SDL_CreateTextureFromSurface(renderer, maleSurface);
-        SDL_FreeSurface(maleSurface);
-        if (maleMageTexture) {
-            SDL_SetTextureAlphaMod(maleMageTexture, alpha); // Apply alpha to texture
-            SDL_SetTextureBlendMode(maleMageTexture, SDL_BLENDMODE_BLEND); // Set blend mode
-        } else {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CreateTextureFromSurface failed for male_mage.png! SDL_Error: %s\n", SDL_GetError());
+    // The avatars are loaded once with everything else (see assets/manifest.txt)
+    for (SDL_Texture* avatar : {femaleMageTexture, maleMageTexture}) {
+        if (avatar) {
+            SDL_SetTextureAlphaMod(avatar, alpha); // Apply alpha to texture
+            SDL_SetTextureBlendMode(avatar, SDL_BLENDMODE_BLEND); // Set blend mode
         }
-    } else {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "IMG_Load failed for male_mage.png! IMG_Error: %s\n", IMG_GetError());
-    }
-
-    // Load the female mage avatar
-    SDL_Texture* femaleMageTexture = nullptr;
-    SDL_Surface* femaleSurface = IMG_Load("../assets/sprites/female_mage.png"); // Adjust path as needed
-    if (femaleSurface) {
-        femaleMageTexture = SDL_CreateTextureFromSurface(renderer, femaleSurface);
-        SDL_FreeSurface(femaleSurface);
-        if (femaleMageTexture) {
-            SDL_SetTextureAlphaMod(femaleMageTexture, alpha); // Apply alpha to texture
-            SDL_SetTextureBlendMode(femaleMageTexture, SDL_BLENDMODE_BLEND); // Set blend mode
-        } else {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CreateTextureFromSurface failed for female_mage.png! SDL_Error: %s\n", SDL_GetError());
-        }
-    } else {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "IMG_Load failed for female_mage.png! IMG_Error: %s\n", IMG_GetError());
     }
 
     // Calculate scaled dimensions for the avatars
@@ -111,8 +86,4 @@ void displayCharacterSelect(SDL_Renderer* renderer, TTF_Font* font, int selected
     SDL_DestroyTexture(textTexture);
 
     SDL_RenderPresent(renderer);
-
-    // Clean up textures (we'll do this properly later)
-    // SDL_DestroyTexture(maleMageTexture);
-    // SDL_DestroyTexture(femaleMageTexture);
 }
\ No newline at end of file
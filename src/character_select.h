@@ -4,6 +4,7 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 
-void displayCharacterSelect(SDL_Renderer* renderer, TTF_Font* font, int selectedIndex, int windowWidth, int windowHeight, Uint8 alpha); // Added alpha parameter
+// The avatar textures belong to the caller (the AssetManager).
+void displayCharacterSelect(SDL_Renderer* renderer, TTF_Font* font, SDL_Texture* femaleMageTexture, SDL_Texture* maleMageTexture, int selectedIndex, int windowWidth, int windowHeight, Uint8 alpha); // Added alpha parameter
 
 #endif // CHARACTER_SELECT_H
\ No newline at end of file
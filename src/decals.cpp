@@ -0,0 +1,75 @@
+// src/decals.cpp
+#include "decals.h"
+#include "game_data.h"
+#include <algorithm>
+#include <cmath>
+
+const char *const DECAL_SPRITE_NAME = "decal_blob";
+
+SDL_Surface *createDecalSurface(int size) {
+  SDL_Surface *surface =
+      SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+  if (!surface) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Failed to create decal surface: %s", SDL_GetError());
+    return nullptr;
+  }
+  const float centre = (size - 1) * 0.5f;
+  const float radius = size * 0.5f;
+  Uint8 *pixels = static_cast<Uint8 *>(surface->pixels);
+  for (int y = 0; y < size; ++y) {
+    Uint8 *row = pixels + y * surface->pitch;
+    for (int x = 0; x < size; ++x) {
+      float dx = x - centre;
+      float dy = y - centre;
+      float angle = std::atan2(dy, dx);
+      // A few lobes so the edge looks splattered rather than round
+      float edge = radius * (0.78f + 0.10f * std::sin(angle * 5.0f) +
+                             0.07f * std::sin(angle * 9.0f + 1.3f));
+      float t = std::sqrt(dx * dx + dy * dy) / edge; // 0 centre, 1 edge
+      float alpha = std::min(1.0f, std::max(0.0f, (1.0f - t) / 0.35f));
+      row[x * 4 + 0] = 255;
+      row[x * 4 + 1] = 255;
+      row[x * 4 + 2] = 255;
+      row[x * 4 + 3] = static_cast<Uint8>(alpha * 255.0f);
+    }
+  }
+  return surface;
+}
+
+void addDecal(GameData &gameData, DecalType type, float worldX, float worldY,
+              SDL_Color tint) {
+  Decal decal;
+  decal.type = type;
+  decal.x = worldX;
+  decal.y = worldY;
+
+  float tileSize = static_cast<float>(
+      std::min(gameData.tileWidth, gameData.tileHeight));
+  SDL_Color base = {255, 255, 255, 255};
+  switch (type) {
+  case DecalType::Scorch:
+    base = {30, 22, 16, 190};
+    decal.size = tileSize * 1.1f;
+    break;
+  case DecalType::Blood:
+    base = {120, 12, 12, 170};
+    decal.size = tileSize * 0.45f;
+    break;
+  case DecalType::Remains:
+    base = {70, 150, 60, 160};
+    decal.size = tileSize * 0.8f;
+    break;
+  }
+  decal.color = {static_cast<Uint8>(base.r * tint.r / 255),
+                 static_cast<Uint8>(base.g * tint.g / 255),
+                 static_cast<Uint8>(base.b * tint.b / 255),
+                 static_cast<Uint8>(base.a * tint.a / 255)};
+  // Vary the shape a little; decals at the same spot still look the same
+  unsigned int hash = ((unsigned int)worldX * 2654435761u) ^
+                      ((unsigned int)worldY * 3063691763u);
+  decal.flip = static_cast<SDL_RendererFlip>(hash >> 30);
+  decal.size *= 0.85f + 0.3f * ((hash >> 8) % 100) / 100.0f;
+
+  gameData.terrainCache.addDecal(decal);
+}
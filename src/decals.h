@@ -0,0 +1,43 @@
+// src/decals.h
+#ifndef DECALS_H
+#define DECALS_H
+
+#include <SDL.h>
+
+// Forward declarations
+struct GameData;
+
+enum class DecalType : unsigned char {
+  Scorch,  // Where a fireball landed
+  Blood,   // Where the player was hurt
+  Remains, // Where an enemy died, in its colour
+};
+
+// --- Decals ---
+// Marks left on the floor for the rest of the floor. They are baked into
+// the terrain chunk they land on (see TerrainCache) when that chunk is next
+// drawn, so a floor covered in them costs no more to draw than a clean one.
+// All decals share one generated soft blob sprite, tinted and sized per type.
+struct Decal {
+  DecalType type = DecalType::Scorch;
+  float x = 0.0f; // Centre in level pixels
+  float y = 0.0f;
+  float size = 0.0f; // Side in pixels
+  SDL_Color color = {255, 255, 255, 255};
+  SDL_RendererFlip flip = SDL_FLIP_NONE;
+};
+
+// Atlas name of the blob every decal is drawn with.
+extern const char *const DECAL_SPRITE_NAME;
+
+// Makes the blob: white with a ragged, soft-edged alpha falloff. The caller
+// owns the surface (AssetManager::addSprite takes it).
+SDL_Surface *createDecalSurface(int size);
+
+// Leaves a decal of the given type centred on (worldX, worldY) in level
+// pixels. tint multiplies the type's colour (e.g. an enemy's tint for its
+// remains).
+void addDecal(GameData &gameData, DecalType type, float worldX, float worldY,
+              SDL_Color tint = {255, 255, 255, 255});
+
+#endif // DECALS_H
@@ -1,10 +1,12 @@
 // src/enemy.cpp
 
 #include "enemy.h"
+#include "enemy_ai.h"
 #include "asset_manager.h"
 #include "character.h" // Include character.h for PlayerCharacter definition
 #include "game_data.h" // Include game_data.h for GameData and IntendedAction
 #include "level.h"
+#include "render_queue.h"
 #include "utils.h"
 #include <SDL.h>
 #include <cmath>
@@ -16,86 +18,25 @@
 int Enemy::nextId = 0;
 
 // --- Constructor Implementation (Assign ID) ---
-Enemy::Enemy(int uniqueId, EnemyType eType, int startX, int startY, int tileW,
-             int tileH)
+Enemy::Enemy(int uniqueId, EnemyType eType, int startX, int startY)
     : id(uniqueId), // Assign the unique ID
-      type(eType), x(startX), y(startY), isMoving(false), startTileX(startX),
-      startTileY(startY), targetTileX(startX), targetTileY(startY),
-      moveProgress(0.0f), moveTimer(0.0f),
-      isAttacking(false),
-      idleAnimationTimer(0.0f),
-      attackStartX(0.0f), attackStartY(0.0f),
-      attackTargetX(0.0f), attackTargetY(0.0f),
-      lungeDistanceRatio(0.4f),
-      currentIdleFrame(0), tileWidth(tileW), tileHeight(tileH),
-      // +++ Initialize facing direction +++
-      currentFacingDirection(FacingDirection::Left) // Default to Left
-      // +++++++++++++++++++++++++++++++++++++
-       {
-  // Initialize visual position
-  visualX = startX * tileWidth + tileWidth / 2.0f;
-  visualY = startY * tileHeight + tileHeight / 2.0f;
-
-  // Set attributes based on EnemyType
-  switch (type) {
-  case EnemyType::SLIME:
-    health = 20;
-    maxHealth = 20;
-    width = static_cast<int>(tileW * 0.8); // Ensure width/height are int
-    height = static_cast<int>(tileH * 0.8);
-    arcanaValue = 12;
-    textureName = "slime_texture";
-    moveDuration = 0.7f;
-    baseAttackDamage = 8;
-    idleAnimationSpeed = 8.0f; // Slimes might animate slowly
-    walkAnimationSpeed = 8.0f;
-    attackAnimationSpeed = 16.0f;
-    lungeDistanceRatio = 0.6f; // Slime might make smaller lunges
-
-    // --- ADDED: Initialize Slime Idle Frames ---
-    idleFrameTextureNames = {
-        "slime_idle_1", "slime_idle_2", "slime_idle_3",
-        "slime_idle_4", "slime_idle_5", "slime_idle_6",
-        "slime_idle_7", "slime_idle_8", "slime_idle_9"}; // Example names
-
-    // --- ADDED: Initialize Slime Walk Frames (9 frames) ---
-    walkFrameTextureNames = {"slime_walk_1", "slime_walk_2", "slime_walk_3",
-                             "slime_walk_4", "slime_walk_5", "slime_walk_6",
-                             "slime_walk_7", "slime_walk_8", "slime_walk_9"};
-
-    // --- ADDED: Initialize Slime Attack Frames (9 frames) ---
-    attackFrameTextureNames = {
-        "slime_attack_1", "slime_attack_2", "slime_attack_3",
-        "slime_attack_4", "slime_attack_5", "slime_attack_6",
-        "slime_attack_7", "slime_attack_8", "slime_attack_9"}; // Example names
-    // -----------------------------------------
-
-    // Calculate total duration for one loop of attack animation
-    if (attackAnimationSpeed > 0 && !attackFrameTextureNames.empty()) {
-      attackAnimationDuration =
-          (1.0f / attackAnimationSpeed) * attackFrameTextureNames.size();
-    } else {
-      attackAnimationDuration =
-          0.5f; // Default duration if speed/frames invalid
-    }
+      x(startX), y(startY), targetTileX(startX), targetTileY(startY),
+      homeX(startX), homeY(startY), type(eType) {
+  const EnemyArchetype &arch = archetype();
+  health = arch.maxHealth;
+  maxHealth = arch.maxHealth;
+  arcanaValue = arch.arcanaValue;
+  baseAttackDamage = arch.baseAttackDamage;
 
-    break;
-  default:
-    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                 "Unknown EnemyType encountered in constructor!");
-    health = 10;
-    maxHealth = 10;
-    width = tileW / 2;
-    height = tileH / 2;
-    arcanaValue = 5;
-    textureName = "";
-    moveDuration = 0.3f;
-    baseAttackDamage = 10;
-    break;
-  }
   SDL_Log("Enemy %d created: Type %d, HP %d, Pos (%d, %d), Texture '%s'", id,
-          (int)type, health, x, y, textureName.c_str());
+          (int)type, health, x, y, arch.textureName.c_str());
 }
+
+EnemyPresentation::EnemyPresentation(const EnemyArchetype &arch, int tileX,
+                                     int tileY)
+    : visualX(tileX * arch.tileWidth + arch.tileWidth / 2.0f),
+      visualY(tileY * arch.tileHeight + arch.tileHeight / 2.0f),
+      startTileX(tileX), startTileY(tileY) {}
 // ------------------------------------------
 
 // --- NEW: planAction Implementation ---
@@ -103,131 +44,30 @@ Enemy::Enemy(int uniqueId, EnemyType eType, int startX, int startY, int tileW,
 IntendedAction Enemy::planAction(const Level &levelData,
                                  const PlayerCharacter &player,
                                  const GameData &gameData) const {
-    IntendedAction plannedAction; // Start with ActionType::None
-    plannedAction.enemyId = this->id; // Store the enemy's ID
-
     // Don't plan if already moving or attacking (shouldn't happen if called correctly, but safe)
     if (isMoving || isAttacking) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Enemy %d planAction called while moving/attacking. Returning None.", id);
-        return plannedAction; // Return ActionType::None
+        IntendedAction plannedAction; // ActionType::None
+        plannedAction.enemyHandle = this->handle;
+        return plannedAction;
     }
 
-    // --- Check Visibility (using const gameData) ---
-    float visibility = 0.0f;
-    if (isWithinBounds(x, y, gameData.currentLevel.width, gameData.currentLevel.height) &&
-        y < (int)gameData.visibilityMap.size() && x < (int)gameData.visibilityMap[y].size()) {
-        visibility = gameData.visibilityMap[y][x];
-    }
-    bool isVisible = (visibility > 0.0f);
-
-    // --- AI Logic (Similar to takeAction, but returns intent) ---
-    if (isVisible) {
-        // Visible Logic: Plan Attack or Move
-        int playerTileX = player.targetTileX; // Use player's logical position
-        int playerTileY = player.targetTileY;
-        int dx = playerTileX - x;
-        int dy = playerTileY - y;
-
-        // Check Adjacency for Attack Plan
-        if (std::abs(dx) <= 1 && std::abs(dy) <= 1 && (dx != 0 || dy != 0)) {
-            plannedAction.type = ActionType::Attack;
-            plannedAction.targetX = playerTileX; // Store player tile coords
-            plannedAction.targetY = playerTileY;
-            SDL_Log("Enemy %d [%d,%d] plans ATTACK on player at [%d,%d]", id, x, y, playerTileX, playerTileY);
-        } else {
-            // Not Adjacent: Plan to Move Towards Player
-            int moveX = 0, moveY = 0;
-            if (std::abs(dx) > std::abs(dy)) {
-                moveX = (dx > 0) ? 1 : -1;
-            } else if (dy != 0) {
-                moveY = (dy > 0) ? 1 : -1;
-            } else if (dx != 0) { // Only move horizontally if dy is 0
-                moveX = (dx > 0) ? 1 : -1;
-            }
-
-            int nextX = x + moveX;
-            int nextY = y + moveY;
-
-            // Check primary direction validity (using gameData.occupationGrid)
-            // IMPORTANT: Use the *current* occupation grid for planning.
-            bool primaryMoveValid =
-                isWithinBounds(nextX, nextY, levelData.width, levelData.height) &&
-                levelData.tiles[nextY][nextX] != '#' &&
-                !gameData.occupationGrid[nextY][nextX]; // Check CURRENT occupation
-
-            if (primaryMoveValid) {
-                plannedAction.type = ActionType::Move;
-                plannedAction.targetX = nextX;
-                plannedAction.targetY = nextY;
-                SDL_Log("Enemy %d [%d,%d] plans MOVE to [%d,%d] (Primary)", id, x, y, nextX, nextY);
-            } else {
-                // Try alternative axis if primary failed
-                int altMoveX = 0, altMoveY = 0;
-                if (moveX != 0) { // Primary was horizontal, try vertical
-                    if (dy != 0) altMoveY = (dy > 0) ? 1 : -1;
-                } else if (moveY != 0) { // Primary was vertical, try horizontal
-                     if (dx != 0) altMoveX = (dx > 0) ? 1 : -1;
-                }
-                // If primary was zero (shouldn't happen unless dx=dy=0), stay put
-
-                int altNextX = x + altMoveX;
-                int altNextY = y + altMoveY;
-
-                if (altMoveX != 0 || altMoveY != 0) { // Check if alternative is possible
-                    bool altMoveValid =
-                        isWithinBounds(altNextX, altNextY, levelData.width, levelData.height) &&
-                        levelData.tiles[altNextY][altNextX] != '#' &&
-                        !gameData.occupationGrid[altNextY][altNextX]; // Check CURRENT occupation
-                    if (altMoveValid) {
-                        plannedAction.type = ActionType::Move;
-                        plannedAction.targetX = altNextX;
-                        plannedAction.targetY = altNextY;
-                        SDL_Log("Enemy %d [%d,%d] plans MOVE to [%d,%d] (Alt)", id, x, y, altNextX, altNextY);
-                    } else {
-                        plannedAction.type = ActionType::Wait; // Blocked
-                        SDL_Log("Enemy %d [%d,%d] plans WAIT (Blocked Alt)", id, x, y);
-                    }
-                } else {
-                    plannedAction.type = ActionType::Wait; // Blocked
-                    SDL_Log("Enemy %d [%d,%d] plans WAIT (Blocked Primary, No Alt)", id, x, y);
-                }
-            }
-        }
-    } else {
-        // Invisible Logic: Plan Random Walk
-        int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
-        int randIndex = rand() % 4;
-        int nextX = x + directions[randIndex][0];
-        int nextY = y + directions[randIndex][1];
-
-        bool isValidMove =
-            isWithinBounds(nextX, nextY, levelData.width, levelData.height) &&
-            levelData.tiles[nextY][nextX] != '#' &&
-            !gameData.occupationGrid[nextY][nextX]; // Check CURRENT occupation
-
-        if (isValidMove) {
-            plannedAction.type = ActionType::Move;
-            plannedAction.targetX = nextX;
-            plannedAction.targetY = nextY;
-            SDL_Log("Enemy %d [%d,%d] plans INVISIBLE MOVE to [%d,%d]", id, x, y, nextX, nextY);
-        } else {
-            plannedAction.type = ActionType::Wait; // Cannot move randomly
-            SDL_Log("Enemy %d [%d,%d] plans INVISIBLE WAIT (Blocked)", id, x, y);
-        }
-    }
-
-    return plannedAction;
+    // Level and player are read from gameData.aiInputs, built for this turn
+    (void)levelData;
+    (void)player;
+    return chooseEnemyAction(*this, gameData);
 }
 // ----------------------------------
 
 // --- update Implementation (With added movement debugging) ---
-void Enemy::update(float deltaTime, GameData& gameData) {
+void Enemy::update(float deltaTime, EnemyPresentation &look) {
+    const EnemyArchetype &arch = archetype();
 
     if (isAttacking) {
-        attackAnimationTimer += deltaTime;
+        look.attackAnimationTimer += deltaTime;
         // Ensure duration is positive before division
-        float currentAttackDuration = attackAnimationDuration > 0.0f ? attackAnimationDuration : 1.0f; // Avoid div by zero
-        float attackProgress = std::min(attackAnimationTimer / currentAttackDuration, 1.0f); // Overall progress 0-1
+        float currentAttackDuration = arch.attackAnimationDuration > 0.0f ? arch.attackAnimationDuration : 1.0f; // Avoid div by zero
+        float attackProgress = std::min(look.attackAnimationTimer / currentAttackDuration, 1.0f); // Overall progress 0-1
 
 
         // --- Calculate Lunge/Retreat Interpolation ---
@@ -238,42 +78,42 @@ void Enemy::update(float deltaTime, GameData& gameData) {
         if (lungePhaseDuration <= 0.0f || retreatPhaseDuration <= 0.0f) {
              SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Enemy %d attack animation duration is zero or negative! Aborting attack update.", id);
              isAttacking = false; // Force exit attacking state
-             visualX = attackStartX; // Snap back
-             visualY = attackStartY;
-             attackAnimationTimer = 0.0f; currentAttackFrame = 0;
+             look.visualX = look.attackStartX; // Snap back
+             look.visualY = look.attackStartY;
+             look.attackAnimationTimer = 0.0f; look.currentAttackFrame = 0;
              return;
         }
 
-        float currentLungeTargetX = attackStartX + (attackTargetX - attackStartX) * lungeDistanceRatio;
-        float currentLungeTargetY = attackStartY + (attackTargetY - attackStartY) * lungeDistanceRatio;
+        float currentLungeTargetX = look.attackStartX + (look.attackTargetX - look.attackStartX) * arch.lungeDistanceRatio;
+        float currentLungeTargetY = look.attackStartY + (look.attackTargetY - look.attackStartY) * arch.lungeDistanceRatio;
 
-        if (attackAnimationTimer <= lungePhaseDuration) {
+        if (look.attackAnimationTimer <= lungePhaseDuration) {
             // --- Lunge Phase ---
-            float lungeProgress = attackAnimationTimer / lungePhaseDuration; // Progress within lunge phase (0-1)
+            float lungeProgress = look.attackAnimationTimer / lungePhaseDuration; // Progress within lunge phase (0-1)
             // Non-linear interpolation for abruptness (e.g., quadratic ease-out: 1 - (1-p)^2 )
             float easedProgress = 1.0f - (1.0f - lungeProgress) * (1.0f - lungeProgress);
-            visualX = attackStartX + (currentLungeTargetX - attackStartX) * easedProgress;
-            visualY = attackStartY + (currentLungeTargetY - attackStartY) * easedProgress;
+            look.visualX = look.attackStartX + (currentLungeTargetX - look.attackStartX) * easedProgress;
+            look.visualY = look.attackStartY + (currentLungeTargetY - look.attackStartY) * easedProgress;
 
         } else {
             // --- Retreat Phase ---
-            float retreatTimer = attackAnimationTimer - lungePhaseDuration; // Time elapsed in retreat phase
+            float retreatTimer = look.attackAnimationTimer - lungePhaseDuration; // Time elapsed in retreat phase
             float retreatProgress = retreatTimer / retreatPhaseDuration; // Progress within retreat phase (0-1)
             // Linear interpolation for slower retreat
-            visualX = currentLungeTargetX + (attackStartX - currentLungeTargetX) * retreatProgress;
-            visualY = currentLungeTargetY + (attackStartY - currentLungeTargetY) * retreatProgress;
+            look.visualX = currentLungeTargetX + (look.attackStartX - currentLungeTargetX) * retreatProgress;
+            look.visualY = currentLungeTargetY + (look.attackStartY - currentLungeTargetY) * retreatProgress;
         }
 
 
         // --- Update Attack Animation Frame ---
-        if (!attackFrameTextureNames.empty() && attackAnimationSpeed > 0) {
-            float frameDuration = 1.0f / attackAnimationSpeed;
+        if (arch.attackFrameCount > 0 && arch.attackAnimationSpeed > 0) {
+            float frameDuration = 1.0f / arch.attackAnimationSpeed;
              if (frameDuration > 0) { // Safety check
-                currentAttackFrame = static_cast<int>(floor(attackAnimationTimer / frameDuration));
+                look.currentAttackFrame = static_cast<int>(floor(look.attackAnimationTimer / frameDuration));
                 // Ensure frame index stays within bounds, especially at the very end
-                currentAttackFrame = std::min(currentAttackFrame, (int)attackFrameTextureNames.size() - 1);
+                look.currentAttackFrame = std::min(look.currentAttackFrame, arch.attackFrameCount - 1);
              } else {
-                 currentAttackFrame = 0; // Default if speed is invalid
+                 look.currentAttackFrame = 0; // Default if speed is invalid
              }
         }
 
@@ -281,12 +121,12 @@ void Enemy::update(float deltaTime, GameData& gameData) {
         if (attackProgress >= 1.0f) {
             isAttacking = false; // Animation finished
             // Snap visual position back precisely to the starting tile center
-            visualX = attackStartX;
-            visualY = attackStartY;
+            look.visualX = look.attackStartX;
+            look.visualY = look.attackStartY;
             // Reset all animation states
-            attackAnimationTimer = 0.0f; currentAttackFrame = 0;
-            idleAnimationTimer = 0.0f; currentIdleFrame = 0;
-            walkAnimationTimer = 0.0f; currentWalkFrame = 0;
+            look.attackAnimationTimer = 0.0f; look.currentAttackFrame = 0;
+            look.idleAnimationTimer = 0.0f; look.currentIdleFrame = 0;
+            look.walkAnimationTimer = 0.0f; look.currentWalkFrame = 0;
              SDL_Log("Enemy %d finished attack animation.", id);
         }
         // While attacking, don't process movement or idle animation updates below
@@ -296,67 +136,67 @@ void Enemy::update(float deltaTime, GameData& gameData) {
     // --- Update Movement (Only if not attacking) ---
     if (isMoving) {
         // +++ MOVEMENT DEBUG LOGGING START +++
-        moveTimer += deltaTime;
+        look.moveTimer += deltaTime;
 
         // Safety check for moveDuration
-        if (moveDuration <= 0.0f) {
-             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Enemy %d moveDuration is zero or negative (%.4f)! Aborting move.", id, moveDuration);
+        if (arch.moveDuration <= 0.0f) {
+             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Enemy %d moveDuration is zero or negative (%.4f)! Aborting move.", id, arch.moveDuration);
              isMoving = false; // Force exit moving state
              // Snap to target tile logically and visually
              x = targetTileX;
              y = targetTileY;
-             visualX = targetTileX * tileWidth + tileWidth / 2.0f;
-             visualY = targetTileY * tileHeight + tileHeight / 2.0f;
-             moveTimer = 0.0f;
-             moveProgress = 0.0f;
-             walkAnimationTimer = 0.0f; currentWalkFrame = 0;
+             look.visualX = targetTileX * arch.tileWidth + arch.tileWidth / 2.0f;
+             look.visualY = targetTileY * arch.tileHeight + arch.tileHeight / 2.0f;
+             look.moveTimer = 0.0f;
+             look.moveProgress = 0.0f;
+             look.walkAnimationTimer = 0.0f; look.currentWalkFrame = 0;
              return; // Stop further processing this frame
         }
 
-        moveProgress = moveTimer / moveDuration;
+        look.moveProgress = look.moveTimer / arch.moveDuration;
 
         //SDL_Log("DEBUG_MOVE: Enemy %d Moving | Timer: %.4f | Duration: %.4f | Progress: %.4f",
-        //        id, moveTimer, moveDuration, moveProgress); // Reduce log spam
+        //        id, look.moveTimer, moveDuration, look.moveProgress); // Reduce log spam
         // +++ MOVEMENT DEBUG LOGGING END +++
 
 
         // Update Walk Animation
-        if (!walkFrameTextureNames.empty() && walkAnimationSpeed > 0) {
-            walkAnimationTimer += deltaTime;
-            float walkFrameDuration = 1.0f / walkAnimationSpeed;
-            if (walkFrameDuration > 0 && walkAnimationTimer >= walkFrameDuration) {
-                 walkAnimationTimer -= walkFrameDuration;
-                 currentWalkFrame = (currentWalkFrame + 1) % walkFrameTextureNames.size();
+        if (arch.walkFrameCount > 0 && arch.walkAnimationSpeed > 0) {
+            look.walkAnimationTimer += deltaTime;
+            float walkFrameDuration = 1.0f / arch.walkAnimationSpeed;
+            if (walkFrameDuration > 0 && look.walkAnimationTimer >= walkFrameDuration) {
+                 look.walkAnimationTimer -= walkFrameDuration;
+                 look.currentWalkFrame = (look.currentWalkFrame + 1) % arch.walkFrameCount;
             }
         } else {
-             currentWalkFrame = 0; // Default if no frames/speed
+             look.currentWalkFrame = 0; // Default if no frames/speed
         }
         // Reset idle state
-        idleAnimationTimer = 0.0f; currentIdleFrame = 0;
+        look.idleAnimationTimer = 0.0f; look.currentIdleFrame = 0;
 
         // +++ MOVEMENT DEBUG LOGGING START +++
-        //SDL_Log("DEBUG_MOVE: Enemy %d Checking Completion | Progress: %.4f", id, moveProgress); // Reduce log spam
+        //SDL_Log("DEBUG_MOVE: Enemy %d Checking Completion | Progress: %.4f", id, look.moveProgress); // Reduce log spam
         // +++ MOVEMENT DEBUG LOGGING END +++
 
-        if (moveProgress >= 1.0f) {
+        if (look.moveProgress >= 1.0f) {
              // +++ MOVEMENT DEBUG LOGGING START +++
              SDL_Log("DEBUG_MOVE: Enemy %d COMPLETING Move | Old Logical: [%d,%d] | New Logical: [%d,%d]",
-                     id, startTileX, startTileY, targetTileX, targetTileY);
+                     id, look.startTileX, look.startTileY, targetTileX, targetTileY);
              // +++ MOVEMENT DEBUG LOGGING END +++
 
              // Snap logical position
              x = targetTileX;
              y = targetTileY;
              // Snap visual position exactly
-             visualX = targetTileX * tileWidth + tileWidth / 2.0f;
-             visualY = targetTileY * tileHeight + tileHeight / 2.0f;
+             look.visualX = targetTileX * arch.tileWidth + arch.tileWidth / 2.0f;
+             look.visualY = targetTileY * arch.tileHeight + arch.tileHeight / 2.0f;
 
              // Reset movement state
              isMoving = false;
-             moveProgress = 0.0f; // Reset progress
-             moveTimer = 0.0f;    // Reset timer
-             walkAnimationTimer = 0.0f; currentWalkFrame = 0; // Reset walk anim
-             idleAnimationTimer = 0.0f; currentIdleFrame = 0; // Reset idle anim
+             look.moveProgress = 0.0f; // Reset progress
+             look.moveTimer = 0.0f;    // Reset timer
+             look.walkAnimationTimer = 0.0f; look.currentWalkFrame = 0; // Reset walk anim
+             look.idleAnimationTimer = 0.0f; look.currentIdleFrame = 0; // Reset idle anim
 
              // +++ MOVEMENT DEBUG LOGGING START +++
              SDL_Log("DEBUG_MOVE: Enemy %d Move COMPLETE. isMoving = false.", id);
@@ -364,91 +204,92 @@ void Enemy::update(float deltaTime, GameData& gameData) {
 
         } else {
              // +++ MOVEMENT DEBUG LOGGING START +++
-            // SDL_Log("DEBUG_MOVE: Enemy %d Interpolating | Progress: %.4f", id, moveProgress); // Can be spammy
+            // SDL_Log("DEBUG_MOVE: Enemy %d Interpolating | Progress: %.4f", id, look.moveProgress); // Can be spammy
              // +++ MOVEMENT DEBUG LOGGING END +++
 
             // Interpolate visual position
-            float startVisualX = startTileX * tileWidth + tileWidth / 2.0f;
-            float startVisualY = startTileY * tileHeight + tileHeight / 2.0f;
-            float targetVisualX = targetTileX * tileWidth + tileWidth / 2.0f;
-            float targetVisualY = targetTileY * tileHeight + tileHeight / 2.0f;
+            float startVisualX = look.startTileX * arch.tileWidth + arch.tileWidth / 2.0f;
+            float startVisualY = look.startTileY * arch.tileHeight + arch.tileHeight / 2.0f;
+            float targetVisualX = targetTileX * arch.tileWidth + arch.tileWidth / 2.0f;
+            float targetVisualY = targetTileY * arch.tileHeight + arch.tileHeight / 2.0f;
 
-            visualX = startVisualX + (targetVisualX - startVisualX) * moveProgress;
-            visualY = startVisualY + (targetVisualY - startVisualY) * moveProgress;
+            look.visualX = startVisualX + (targetVisualX - startVisualX) * look.moveProgress;
+            look.visualY = startVisualY + (targetVisualY - startVisualY) * look.moveProgress;
         }
     }
     // --- Update Idle Animation (Only if not attacking AND not moving) ---
     else { // Enemy is Idle
         // Update Idle Animation
-        if (!idleFrameTextureNames.empty() && idleAnimationSpeed > 0) {
-             idleAnimationTimer += deltaTime;
-             float idleFrameDuration = 1.0f / idleAnimationSpeed;
-             if (idleFrameDuration > 0 && idleAnimationTimer >= idleFrameDuration) {
-                 idleAnimationTimer -= idleFrameDuration;
-                 currentIdleFrame = (currentIdleFrame + 1) % idleFrameTextureNames.size();
+        if (arch.idleFrameCount > 0 && arch.idleAnimationSpeed > 0) {
+             look.idleAnimationTimer += deltaTime;
+             float idleFrameDuration = 1.0f / arch.idleAnimationSpeed;
+             if (idleFrameDuration > 0 && look.idleAnimationTimer >= idleFrameDuration) {
+                 look.idleAnimationTimer -= idleFrameDuration;
+                 look.currentIdleFrame = (look.currentIdleFrame + 1) % arch.idleFrameCount;
              }
         } else {
-             currentIdleFrame = 0; // Default if no frames/speed
+             look.currentIdleFrame = 0; // Default if no frames/speed
         }
 
         // Reset other animation states
-        walkAnimationTimer = 0.0f; currentWalkFrame = 0;
-        attackAnimationTimer = 0.0f; currentAttackFrame = 0;
+        look.walkAnimationTimer = 0.0f; look.currentWalkFrame = 0;
+        look.attackAnimationTimer = 0.0f; look.currentAttackFrame = 0;
         // Ensure visual matches logical when idle
-        visualX = x * tileWidth + tileWidth / 2.0f;
-        visualY = y * tileHeight + tileHeight / 2.0f;
+        look.visualX = x * arch.tileWidth + arch.tileWidth / 2.0f;
+        look.visualY = y * arch.tileHeight + arch.tileHeight / 2.0f;
     }
 }
 
 
-void Enemy::startAttackAnimation(const GameData& gameData) { // Now requires GameData
+void Enemy::startAttackAnimation(const GameData& gameData,
+                                 EnemyPresentation &look) {
     if (!isAttacking && !isMoving) {
         SDL_Log("Enemy %d starting attack animation.", id);
         isAttacking = true;
-        attackAnimationTimer = 0.0f;
-        currentAttackFrame = 0;
+        look.attackAnimationTimer = 0.0f;
+        look.currentAttackFrame = 0;
 
         // --- Capture Start and Target Positions ---
-        attackStartX = visualX; // Current visual position is the start
-        attackStartY = visualY;
+        look.attackStartX = look.visualX; // Current visual position is the start
+        look.attackStartY = look.visualY;
         // Target the player's current visual position
-        attackTargetX = gameData.currentGamePlayer.x;
-        attackTargetY = gameData.currentGamePlayer.y;
-        SDL_Log("   Attack Start: [%.1f, %.1f], Target: [%.1f, %.1f]", attackStartX, attackStartY, attackTargetX, attackTargetY);
+        look.attackTargetX = gameData.currentGamePlayer.x;
+        look.attackTargetY = gameData.currentGamePlayer.y;
+        SDL_Log("   Attack Start: [%.1f, %.1f], Target: [%.1f, %.1f]", look.attackStartX, look.attackStartY, look.attackTargetX, look.attackTargetY);
         // ------------------------------------------
 
         // Reset other animations
-        idleAnimationTimer = 0.0f; currentIdleFrame = 0;
-        walkAnimationTimer = 0.0f; currentWalkFrame = 0;
+        look.idleAnimationTimer = 0.0f; look.currentIdleFrame = 0;
+        look.walkAnimationTimer = 0.0f; look.currentWalkFrame = 0;
     } else {
          SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Enemy %d failed to start attack animation (already attacking/moving?).", id);
     }
 }
 
 // --- startMove Implementation (Update facing direction) ---
-void Enemy::startMove(int targetX, int targetY) {
+void Enemy::startMove(int targetX, int targetY, EnemyPresentation &look) {
   // Only start if not already moving and target is different
   if (!isMoving && (targetX != x || targetY != y)) {
-    startTileX = x; // Current logical pos is the start
-    startTileY = y;
+    look.startTileX = x; // Current logical pos is the start
+    look.startTileY = y;
     targetTileX = targetX; // Target logical pos
     targetTileY = targetY;
     isMoving = true;
-    moveProgress = 0.0f;
-    moveTimer = 0.0f;
+    look.moveProgress = 0.0f;
+    look.moveTimer = 0.0f;
 
     // +++ Update Facing Direction +++
-    if (targetTileX > startTileX) {
-        currentFacingDirection = FacingDirection::Right;
-    } else if (targetTileX < startTileX) {
-        currentFacingDirection = FacingDirection::Left;
+    if (targetTileX > look.startTileX) {
+        look.currentFacingDirection = EnemyPresentation::FacingDirection::Right;
+    } else if (targetTileX < look.startTileX) {
+        look.currentFacingDirection = EnemyPresentation::FacingDirection::Left;
     }
-    // If targetTileX == startTileX, direction remains unchanged (vertical move)
+    // If targetTileX == look.startTileX, direction remains unchanged (vertical move)
     // +++++++++++++++++++++++++++++++
 
     SDL_Log("Enemy %d starting move animation from [%d,%d] to [%d,%d] (Facing: %s)", id,
-            startTileX, startTileY, targetTileX, targetTileY,
-            (currentFacingDirection == FacingDirection::Right ? "Right" : "Left"));
+            look.startTileX, look.startTileY, targetTileX, targetTileY,
+            (look.currentFacingDirection == EnemyPresentation::FacingDirection::Right ? "Right" : "Left"));
   } else if (isMoving) {
     SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                 "Enemy %d told to startMove while already moving.", id);
@@ -459,98 +300,91 @@ void Enemy::startMove(int targetX, int targetY) {
   }
 }
 
-// --- Render Implementation (Use SDL_RenderCopyEx for flipping) ---
-void Enemy::render(SDL_Renderer *renderer, AssetManager &assets, int cameraX,
-                   int cameraY, float visibilityAlpha) const {
+// --- Render Implementation (queued; flip and tint are per vertex) ---
+void Enemy::render(RenderQueue &queue, const AssetManager &assets,
+                   const EnemyPresentation &look, int cameraX, int cameraY,
+                   float visibilityAlpha) const {
+  const EnemyArchetype &arch = archetype();
 
-  SDL_Texture *textureToRender = nullptr;
-  std::string keyToUse;
+  const AtlasSprite *spriteToRender = nullptr;
+  AssetId keyToUse;
 
   // Determine which texture to use: Attack -> Walk -> Idle -> Base
-  if (isAttacking && !attackFrameTextureNames.empty()) {
+  if (isAttacking && !arch.attackFrameIds.empty()) {
     // Use current attack frame if attacking and frames available
-    if (currentAttackFrame >= 0 &&
-        currentAttackFrame < attackFrameTextureNames.size()) {
-      keyToUse = attackFrameTextureNames[currentAttackFrame];
+    if (look.currentAttackFrame >= 0 &&
+        look.currentAttackFrame < static_cast<int>(arch.attackFrameIds.size())) {
+      keyToUse = arch.attackFrameIds[look.currentAttackFrame];
     } else {
-      keyToUse = textureName; // Fallback
+      keyToUse = arch.textureId; // Fallback
       SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                   "Enemy %d: Invalid attack frame index %d.", id,
-                  currentAttackFrame);
+                  look.currentAttackFrame);
     }
-  } else if (isMoving && !walkFrameTextureNames.empty()) {
+  } else if (isMoving && !arch.walkFrameIds.empty()) {
     // Use current walk frame if moving and frames available
-    if (currentWalkFrame >= 0 &&
-        currentWalkFrame < walkFrameTextureNames.size()) {
-      keyToUse = walkFrameTextureNames[currentWalkFrame];
+    if (look.currentWalkFrame >= 0 &&
+        look.currentWalkFrame < static_cast<int>(arch.walkFrameIds.size())) {
+      keyToUse = arch.walkFrameIds[look.currentWalkFrame];
     } else {
-      keyToUse = textureName; // Fallback
+      keyToUse = arch.textureId; // Fallback
       SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                   "Enemy %d: Invalid walk frame index %d.", id,
-                  currentWalkFrame);
+                  look.currentWalkFrame);
     }
-  } else if (!isMoving && !idleFrameTextureNames.empty()) {
+  } else if (!isMoving && !arch.idleFrameIds.empty()) {
     // Use current idle frame if idle and frames available
-    if (currentIdleFrame >= 0 &&
-        currentIdleFrame < idleFrameTextureNames.size()) {
-      keyToUse = idleFrameTextureNames[currentIdleFrame];
+    if (look.currentIdleFrame >= 0 &&
+        look.currentIdleFrame < static_cast<int>(arch.idleFrameIds.size())) {
+      keyToUse = arch.idleFrameIds[look.currentIdleFrame];
     } else {
-      keyToUse = textureName; // Fallback
+      keyToUse = arch.textureId; // Fallback
       SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                   "Enemy %d: Invalid idle frame index %d.", id,
-                  currentIdleFrame);
+                  look.currentIdleFrame);
     }
   } else {
     // Use base texture if no specific animation applies or frames are missing
-    keyToUse = textureName;
+    keyToUse = arch.textureId;
   }
 
-  // Get the texture from the asset manager
-  if (!keyToUse.empty()) {
-    textureToRender = assets.getTexture(keyToUse);
+  // Get the sprite from the atlas (an array index)
+  if (keyToUse.isValid()) {
+    spriteToRender = assets.getSprite(keyToUse);
   }
 
   // Calculate destination rectangle
-  SDL_Rect destRect;
-  destRect.w = width;
-  destRect.h = height;
+  SDL_FRect destRect;
+  destRect.w = static_cast<float>(arch.width);
+  destRect.h = static_cast<float>(arch.height);
   // Center the texture on the visual position
-  destRect.x = static_cast<int>(visualX - destRect.w / 2.0f) - cameraX;
-  destRect.y = static_cast<int>(visualY - destRect.h / 2.0f) - cameraY;
+  destRect.x = static_cast<float>(
+      static_cast<int>(look.visualX - destRect.w / 2.0f) - cameraX);
+  destRect.y = static_cast<float>(
+      static_cast<int>(look.visualY - destRect.h / 2.0f) - cameraY);
 
-  // Render the chosen texture or fallback
-  if (textureToRender) {
+  // Render the chosen sprite or fallback
+  if (spriteToRender) {
     Uint8 alpha = static_cast<Uint8>(visibilityAlpha * 255);
-    SDL_SetTextureAlphaMod(textureToRender, alpha);
-    SDL_SetTextureBlendMode(textureToRender, SDL_BLENDMODE_BLEND);
+    // Frames are shared between archetypes; the tint rides on the vertices
+    SDL_Color color = {arch.tintR, arch.tintG, arch.tintB, alpha};
 
     // +++ Determine Flip based on Facing Direction +++
     SDL_RendererFlip flip = SDL_FLIP_NONE; // Default: no flip (faces left)
-    if (currentFacingDirection == FacingDirection::Right) {
+    if (look.currentFacingDirection == EnemyPresentation::FacingDirection::Right) {
         flip = SDL_FLIP_HORIZONTAL; // Flip horizontally if facing right
     }
     // ++++++++++++++++++++++++++++++++++++++++++++++++
 
-    // +++ Use SDL_RenderCopyEx with Flip +++
-    SDL_RenderCopyEx(renderer, textureToRender,
-                     nullptr,     // Source rect (entire texture)
-                     &destRect,   // Destination rect
-                     0.0,         // Angle (no rotation)
-                     nullptr,     // Center of rotation (not needed)
-                     flip);       // Apply flip
-    // ++++++++++++++++++++++++++++++++++++++
+    // Sorted with the other actors by its feet
+    queue.sprite(RenderLayer::Actors, destRect.y + destRect.h, *spriteToRender,
+                 destRect, color, flip);
 
   } else {
-    // Fallback rendering
-    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                "Enemy texture key '%s' not found for enemy %d, drawing "
-                "fallback rectangle.",
-                keyToUse.c_str(), id);
+    // Fallback rendering (getSprite has already reported the missing key)
     Uint8 alpha = static_cast<Uint8>(visibilityAlpha * 255);
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, alpha); // Red fallback
-    SDL_RenderFillRect(renderer, &destRect);
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    queue.fillRect(RenderLayer::Actors, destRect.y + destRect.h, destRect,
+                   {255, 0, 0, alpha}); // Red fallback
   }
 }
 
@@ -4,8 +4,10 @@
 #define ENEMY_H
 
 #include <SDL.h>
+#include <cstdint>
 #include <string>
-#include <vector> // Added for animation frame names
+#include "enemy_archetype.h" // For EnemyType and shared per-type data
+#include "enemy_slot_map.h"  // For EnemyHandle
 
 // Forward declarations
 struct PlayerCharacter;
@@ -13,93 +15,106 @@ struct Level;
 struct GameData;
 struct IntendedAction;
 class AssetManager;
+class RenderQueue;
 
-enum class EnemyType { SLIME };
+// How much simulation an enemy gets this turn (see enemy_activity.h).
+enum class ActivityTier : unsigned char {
+  Full,    // Planned, animated, updated every frame
+  Coarse,  // Planned every turn, moves snap into place, no per-frame update
+  Dormant  // Asleep: neither planned nor updated until woken
+};
+
+// Where an enemy is drawn and how far through its animations it is. Only
+// Enemy::update, render and the start* calls touch it; turn logic never does,
+// so it's kept out of Enemy in EnemyStore's cold array.
+struct EnemyPresentation {
+  enum class FacingDirection : unsigned char { Left, Right };
+
+  float visualX = 0.0f;
+  float visualY = 0.0f;
+  int startTileX = 0; // Tile the current move started from
+  int startTileY = 0;
+  float moveProgress = 0.0f;
+  float moveTimer = 0.0f;
+  FacingDirection currentFacingDirection = FacingDirection::Left;
+
+  // --- Animation State ---
+  float idleAnimationTimer = 0.0f;
+  int currentIdleFrame = 0;
+  float walkAnimationTimer = 0.0f;
+  int currentWalkFrame = 0;
+  float attackAnimationTimer = 0.0f;
+  int currentAttackFrame = 0;
+  float attackStartX = 0.0f;  // Visual X position when attack started
+  float attackStartY = 0.0f;  // Visual Y position when attack started
+  float attackTargetX = 0.0f; // Target visual X for the lunge (player pos)
+  float attackTargetY = 0.0f; // Target visual Y for the lunge (player pos)
 
+  EnemyPresentation() = default;
+  // Standing still on (tileX, tileY).
+  EnemyPresentation(const EnemyArchetype &arch, int tileX, int tileY);
+};
+
+// Per-instance turn state: what planning, scheduling, resolution and the
+// activity, squad and influence passes read. Anything shared by every enemy
+// of a type lives in its EnemyArchetype, and per-frame presentation in its
+// EnemyPresentation.
 class Enemy {
 public:
+  // --- Scheduling (see turn_scheduler.h) ---
+  int64_t nextActTime = -1; // Game time of the next action (-1 = not scheduled yet)
+
   // --- Unique ID ---
-  int id; // Unique ID for targeting
+  EnemyHandle handle; // Stable reference for lookups; assigned by syncEnemySlots
+  int id;             // Unique ID (logging, per-enemy random rolls)
 
   // --- Core Attributes ---
-  EnemyType type;
   int health;
-  int maxHealth;
-  int width;
-  int height;
-  int arcanaValue;
-  std::string textureName;
-  float moveDuration;
-  int baseAttackDamage;
+  int maxHealth;        // Per instance: floor scaling changes it
+  int arcanaValue;      // Per instance: floor scaling changes it
+  int baseAttackDamage; // Per instance: floor scaling changes it
 
   // --- Positional & State ---
   int x; // Logical tile X
   int y; // Logical tile Y
-  float visualX;
-  float visualY;
-  bool isMoving;
-  int startTileX;
-  int startTileY;
-  int targetTileX;
+  int targetTileX; // Where the current move ends
   int targetTileY;
-  float moveProgress;
-  float moveTimer;
+  int homeX; // Spawn tile, for guarding behaviours
+  int homeY;
+
+  // --- Activity ---
+  int alertTurns = 0; // Turns left at full activity after being woken by noise
+  int squadSlot = -1;  // Index into gameData.squad.slots this turn (-1 = acting alone)
+  int influenceX = -1; // Tile last stamped into the influence maps (-1 = none)
+  int influenceY = -1;
+
+  EnemyType type; // Selects the archetype
+  ActivityTier activityTier = ActivityTier::Full;
+  bool isMoving = false;
   bool isAttacking = false;
-
-  // --- Context ---
-  int tileWidth;
-  int tileHeight;
-
-  // --- Facing Direction ---
-  enum class FacingDirection { Left, Right };
-  FacingDirection currentFacingDirection;
-
-  // --- ADDED: Idle Animation ---
-  std::vector<std::string> idleFrameTextureNames; // Keys for idle frames
-  float idleAnimationTimer = 0.0f;
-  int currentIdleFrame = 0;
-  float idleAnimationSpeed =
-      4.0f; // Frames per second for idle (adjust per enemy type)
-
-  // --- ADDED: Walk Animation ---
-  std::vector<std::string> walkFrameTextureNames; // Keys for walk frames
-  float walkAnimationTimer = 0.0f;
-  int currentWalkFrame = 0;
-  float walkAnimationSpeed =
-      4.0f; // Frames per second for walking (adjust per enemy type)
-
-  // --- ADDED: Attack Animation ---
-  std::vector<std::string> attackFrameTextureNames; // Keys for attack frames
-  float attackAnimationTimer = 0.0f;
-  int currentAttackFrame = 0;
-  float attackAnimationSpeed =
-      10.0f; // Attack might be faster (adjust per enemy type)
-  float attackAnimationDuration =
-      0.0f; // Will be calculated based on speed and frame count
-            // --- ADDED: Attack Movement Variables ---
-  float attackStartX = 0.0f;  // Visual X position when attack started
-  float attackStartY = 0.0f;  // Visual Y position when attack started
-  float attackTargetX = 0.0f; // Target visual X for the lunge (player pos)
-  float attackTargetY = 0.0f; // Target visual Y for the lunge (player pos)
-  float lungeDistanceRatio =
-      0.4f; // How far towards the target to lunge (e.g., 40%)
-  // --- END ADDED ---
+  bool actsThisTurn = false; // Came due this turn; only these are planned
 
   // --- Constructor ---
-  Enemy(int uniqueId, EnemyType type, int startX, int startY, int tileW,
-        int tileH);
+  // Allocation-free: stats and size come from the type's archetype.
+  Enemy(int uniqueId, EnemyType type, int startX, int startY);
+
+  // Shared data for this enemy's type.
+  const EnemyArchetype &archetype() const { return getEnemyArchetype(type); }
 
   // --- Planning Function ---
+  // Utility-scored choice over the archetype's behaviours (see enemy_ai.h)
   IntendedAction planAction(const Level &levelData,
                             const PlayerCharacter &player,
                             const GameData &gameData) const;
 
   // --- Action Execution & Update ---
-  void update(float deltaTime, GameData &gameData);
-  void render(SDL_Renderer *renderer, AssetManager &assets, int cameraX,
-              int cameraY, float visibilityAlpha) const;
-  void startMove(int targetX, int targetY);
-  void startAttackAnimation(const GameData &gameData);
+  // `look` is this enemy's entry in gameData.enemies' presentation array.
+  void update(float deltaTime, EnemyPresentation &look);
+  void render(RenderQueue &queue, const AssetManager &assets,
+              const EnemyPresentation &look, int cameraX, int cameraY,
+              float visibilityAlpha) const;
+  void startMove(int targetX, int targetY, EnemyPresentation &look);
+  void startAttackAnimation(const GameData &gameData, EnemyPresentation &look);
   void takeDamage(int amount);
   int GetAttackDamage() const;
   void applyFloorScaling(int currentFloorIndex, float scalingFactorPerFloor);
@@ -114,4 +129,9 @@ private:
   static int nextId;
 };
 
+// 88 bytes on 64-bit builds (168 with the presentation state inline).
+static_assert(sizeof(Enemy) <= 88, "Enemy is walked by every per-turn pass; "
+                                   "put presentation state in "
+                                   "EnemyPresentation");
+
 #endif // ENEMY_H
@@ -0,0 +1,73 @@
+// src/enemy_activity.cpp
+#include "enemy_activity.h"
+#include "enemy.h"
+#include "game_data.h"
+#include "utils.h" // For isWithinBounds
+#include <SDL.h>
+#include <algorithm>
+#include <cstdlib>
+
+// Chebyshev distance: the number of 8-way steps between two tiles.
+static int tileDistance(int ax, int ay, int bx, int by) {
+  return std::max(std::abs(ax - bx), std::abs(ay - by));
+}
+
+void updateEnemyActivityTiers(GameData &gameData) {
+  const int playerX = gameData.currentGamePlayer.targetTileX;
+  const int playerY = gameData.currentGamePlayer.targetTileY;
+  int tierCounts[3] = {0, 0, 0};
+
+  for (auto &enemy : gameData.enemies) {
+    if (enemy.health <= 0)
+      continue;
+
+    if (enemy.alertTurns > 0)
+      enemy.alertTurns--;
+
+    bool isVisible = false;
+    if (isWithinBounds(enemy.x, enemy.y, gameData.currentLevel.width,
+                       gameData.currentLevel.height) &&
+        enemy.y < (int)gameData.visibilityMap.size() &&
+        enemy.x < (int)gameData.visibilityMap[enemy.y].size()) {
+      isVisible = gameData.visibilityMap[enemy.y][enemy.x] > 0.0f;
+    }
+
+    int distance = tileDistance(enemy.x, enemy.y, playerX, playerY);
+    if (isVisible || enemy.alertTurns > 0 || enemy.isMoving ||
+        enemy.isAttacking || distance <= gameData.enemyFullActivityRadius) {
+      enemy.activityTier = ActivityTier::Full;
+    } else if (distance <= gameData.enemyCoarseActivityRadius) {
+      enemy.activityTier = ActivityTier::Coarse;
+    } else {
+      enemy.activityTier = ActivityTier::Dormant;
+    }
+    tierCounts[static_cast<int>(enemy.activityTier)]++;
+  }
+
+  SDL_Log("DEBUG: Enemy activity tiers: %d full, %d coarse, %d dormant.",
+          tierCounts[0], tierCounts[1], tierCounts[2]);
+}
+
+int emitNoise(GameData &gameData, int tileX, int tileY, int radius) {
+  std::vector<int> &reached = gameData.noiseReachedScratch;
+  reached.clear();
+  gameData.noiseMap.propagate(gameData.currentLevel.tiles, tileX, tileY, 1.0f,
+                              radius, gameData.turnNumber, &reached);
+
+  int woken = 0;
+  const int width = gameData.noiseMap.getWidth();
+  for (int index : reached) {
+    Enemy *enemy = findEnemy(
+        gameData, gameData.occupancy.enemyAt(index % width, index / width));
+    if (enemy == nullptr || enemy->health <= 0)
+      continue;
+    if (enemy->activityTier != ActivityTier::Full)
+      woken++;
+    enemy->activityTier = ActivityTier::Full;
+    enemy->alertTurns = std::max(enemy->alertTurns, gameData.enemyAlertTurns);
+  }
+  if (woken > 0) {
+    SDL_Log("Noise at [%d,%d] woke %d enemies.", tileX, tileY, woken);
+  }
+  return woken;
+}
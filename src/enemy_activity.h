@@ -0,0 +1,28 @@
+// src/enemy_activity.h
+#ifndef ENEMY_ACTIVITY_H
+#define ENEMY_ACTIVITY_H
+
+// Forward declarations
+struct GameData;
+
+// --- Enemy Activity Tiers ---
+// Enemies are simulated at one of three levels of detail so the cost of a turn
+// follows what the player can see rather than how many enemies are on the
+// floor:
+//   Full    - visible, alerted, or within enemyFullActivityRadius.
+//   Coarse  - within enemyCoarseActivityRadius: planned each turn, but their
+//             moves are committed instantly and they get no per-frame update.
+//   Dormant - further out: skipped by planning and the per-frame update.
+// Tiers are recomputed at the start of each enemy planning phase, so walking
+// towards a sleeping enemy wakes it. Noise (emitNoise) wakes the enemies it
+// reaches regardless of distance for enemyAlertTurns turns.
+
+// Assigns every living enemy its tier for this turn and counts down alerts.
+void updateEnemyActivityTiers(GameData &gameData);
+
+// Noise at (tileX, tileY): spreads up to radius steps through walkable tiles
+// into gameData.noiseMap (walls stop it), and enemies on the tiles it reaches
+// go to full activity for enemyAlertTurns turns. Returns how many were woken.
+int emitNoise(GameData &gameData, int tileX, int tileY, int radius);
+
+#endif // ENEMY_ACTIVITY_H
@@ -0,0 +1,407 @@
+// src/enemy_ai.cpp
+#include "enemy_ai.h"
+#include "enemy.h"
+#include "enemy_squad.h"
+#include "game_data.h" // For GameData and IntendedAction
+#include "utils.h"     // For isWithinBounds
+#include <SDL.h>
+#include <algorithm>
+#include <cstdlib>
+
+// Stand-in distance for tiles the field doesn't reach
+static const float FAR_AWAY = 1000.0f;
+
+static const char *behaviorName(AiBehavior behavior) {
+  switch (behavior) {
+  case AiBehavior::Wait:         return "WAIT";
+  case AiBehavior::Wander:       return "WANDER";
+  case AiBehavior::Chase:        return "CHASE";
+  case AiBehavior::MeleeAttack:  return "MELEE";
+  case AiBehavior::RangedAttack: return "RANGED";
+  case AiBehavior::Flee:         return "FLEE";
+  case AiBehavior::Guard:        return "GUARD";
+  case AiBehavior::Investigate:  return "INVESTIGATE";
+  case AiBehavior::Track:        return "TRACK";
+  }
+  return "?";
+}
+
+float ResponseCurve::evaluate(float x) const {
+  float y = 0.0f;
+  switch (type) {
+  case CurveType::Constant:  y = a; break;
+  case CurveType::Linear:    y = a * x + b; break;
+  case CurveType::StepBelow: y = (x <= a) ? 1.0f : 0.0f; break;
+  case CurveType::StepAbove: y = (x >= a) ? 1.0f : 0.0f; break;
+  }
+  return std::max(0.0f, std::min(1.0f, y));
+}
+
+int AiTurnInputs::distanceAt(int x, int y) const {
+  if (x < 0 || y < 0 || x >= width || y >= height ||
+      playerDistance.size() != static_cast<size_t>(width) * height)
+    return UNREACHABLE;
+  return playerDistance[y * width + x];
+}
+
+// --- Per-turn inputs ---
+
+void buildAiTurnInputs(GameData &gameData) {
+  AiTurnInputs &ai = gameData.aiInputs;
+  const Level &level = gameData.currentLevel;
+  ai.width = level.width;
+  ai.height = level.height;
+  ai.playerX = gameData.currentGamePlayer.targetTileX;
+  ai.playerY = gameData.currentGamePlayer.targetTileY;
+  ai.playerDistance.assign(static_cast<size_t>(ai.width) * ai.height,
+                           AiTurnInputs::UNREACHABLE);
+  ai.frontier.clear();
+
+  if (!isWithinBounds(ai.playerX, ai.playerY, ai.width, ai.height))
+    return;
+
+  // Breadth-first over floor tiles from the player
+  ai.playerDistance[ai.playerY * ai.width + ai.playerX] = 0;
+  ai.frontier.push_back(ai.playerY * ai.width + ai.playerX);
+  const int stepX[4] = {0, 0, -1, 1};
+  const int stepY[4] = {-1, 1, 0, 0};
+  for (size_t head = 0; head < ai.frontier.size(); ++head) {
+    int index = ai.frontier[head];
+    int x = index % ai.width;
+    int y = index / ai.width;
+    int nextDistance = ai.playerDistance[index] + 1;
+    for (int d = 0; d < 4; ++d) {
+      int nx = x + stepX[d];
+      int ny = y + stepY[d];
+      if (!isWithinBounds(nx, ny, ai.width, ai.height) ||
+          level.tiles[ny][nx] == '#')
+        continue;
+      int nextIndex = ny * ai.width + nx;
+      if (ai.playerDistance[nextIndex] != AiTurnInputs::UNREACHABLE)
+        continue;
+      ai.playerDistance[nextIndex] = nextDistance;
+      ai.frontier.push_back(nextIndex);
+    }
+  }
+}
+
+// Mixes the per-turn planning seed with an enemy ID. Planning can run on any
+// worker thread in any order, so it must not touch the shared rand() state.
+static unsigned int planningRoll(unsigned int seed, int enemyId) {
+  unsigned int h = seed ^ (static_cast<unsigned int>(enemyId) * 0x9E3779B9u);
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+// Per-enemy view of the turn inputs, indexed by AiInput.
+struct AiInputValues {
+  float values[static_cast<int>(AiInput::Count)];
+  int rangeToPlayer; // Chebyshev distance; range checks for ranged attacks
+
+  float operator[](AiInput input) const {
+    return values[static_cast<int>(input)];
+  }
+};
+
+static AiInputValues gatherAiInputs(const Enemy &enemy,
+                                    const GameData &gameData) {
+  const AiTurnInputs &ai = gameData.aiInputs;
+  AiInputValues in;
+
+  float visibility = 0.0f;
+  if (isWithinBounds(enemy.x, enemy.y, gameData.currentLevel.width,
+                     gameData.currentLevel.height) &&
+      enemy.y < (int)gameData.visibilityMap.size() &&
+      enemy.x < (int)gameData.visibilityMap[enemy.y].size()) {
+    visibility = gameData.visibilityMap[enemy.y][enemy.x];
+  }
+
+  int fieldDistance = ai.distanceAt(enemy.x, enemy.y);
+  in.rangeToPlayer = std::max(std::abs(enemy.x - ai.playerX),
+                              std::abs(enemy.y - ai.playerY));
+  int homeDistance = std::max(std::abs(enemy.x - enemy.homeX),
+                              std::abs(enemy.y - enemy.homeY));
+
+  in.values[static_cast<int>(AiInput::PlayerDistance)] =
+      fieldDistance == AiTurnInputs::UNREACHABLE
+          ? FAR_AWAY
+          : static_cast<float>(fieldDistance);
+  in.values[static_cast<int>(AiInput::Visible)] = visibility > 0.0f ? 1.0f : 0.0f;
+  in.values[static_cast<int>(AiInput::Adjacent)] =
+      in.rangeToPlayer == 1 ? 1.0f : 0.0f;
+  in.values[static_cast<int>(AiInput::HealthRatio)] =
+      enemy.maxHealth > 0
+          ? static_cast<float>(enemy.health) / enemy.maxHealth
+          : 0.0f;
+  in.values[static_cast<int>(AiInput::HomeDistance)] =
+      static_cast<float>(homeDistance);
+  in.values[static_cast<int>(AiInput::Noise)] =
+      gameData.noiseMap.sample(enemy.x, enemy.y, gameData.turnNumber);
+  in.values[static_cast<int>(AiInput::Scent)] =
+      gameData.scentMap.sample(enemy.x, enemy.y, gameData.turnNumber);
+  int threatPeak = gameData.playerInfluenceRadius + 1; // Kernel centre weight
+  in.values[static_cast<int>(AiInput::PlayerThreat)] =
+      static_cast<float>(gameData.playerThreat.at(enemy.x, enemy.y)) /
+      threatPeak;
+  int ownDensity = enemy.influenceX == enemy.x && enemy.influenceY == enemy.y
+                       ? ALLY_DENSITY_RADIUS + 1
+                       : 0;
+  in.values[static_cast<int>(AiInput::AllyDensity)] = static_cast<float>(
+      gameData.allyDensity.at(enemy.x, enemy.y) - ownDensity);
+  return in;
+}
+
+// Hard preconditions that data can't override: you can't bite someone who
+// isn't next to you or shoot someone you can't see.
+static bool isBehaviorPossible(AiBehavior behavior, const AiInputValues &in,
+                               const EnemyArchetype &arch) {
+  switch (behavior) {
+  case AiBehavior::MeleeAttack:
+    return in[AiInput::Adjacent] > 0.0f;
+  case AiBehavior::RangedAttack:
+    return arch.rangedAttackRange > 0 && in[AiInput::Visible] > 0.0f &&
+           in.rangeToPlayer <= arch.rangedAttackRange;
+  case AiBehavior::Chase:
+  case AiBehavior::Flee:
+    return in[AiInput::PlayerDistance] < FAR_AWAY;
+  default:
+    return true;
+  }
+}
+
+// --- Behaviour execution ---
+
+// True if (tileX, tileY) is currently held by another enemy. Such a tile may
+// be free by the time this enemy moves, if its occupant leaves in the same turn.
+static bool isHeldByEnemy(int tileX, int tileY, const GameData &gameData) {
+  return gameData.occupancy.at(tileX, tileY).kind == OccupantKind::Enemy;
+}
+
+static bool isOpenTile(int tileX, int tileY, const GameData &gameData) {
+  const Level &level = gameData.currentLevel;
+  return isWithinBounds(tileX, tileY, level.width, level.height) &&
+         level.tiles[tileY][tileX] != '#' &&
+         !gameData.occupancy.isBlocked(tileX, tileY);
+}
+
+static void planMove(IntendedAction &plan, int tileX, int tileY) {
+  plan.type = ActionType::Move;
+  plan.targetX = tileX;
+  plan.targetY = tileY;
+}
+
+// Steps to the neighbour with the lowest (towards) or highest (!towards)
+// value of a distance field, the less exposed one on a tie. When every better tile is taken while closing
+// in, queue up behind an enemy that may step away this turn; the reservation
+// pass turns that back into WAIT if it stays.
+template <typename DistanceFn>
+static bool stepAlongField(const Enemy &enemy, const GameData &gameData,
+                           DistanceFn distanceAt, int unreachable,
+                           bool towards, IntendedAction &plan) {
+  const int current = distanceAt(enemy.x, enemy.y);
+  const int stepX[4] = {0, 0, -1, 1};
+  const int stepY[4] = {-1, 1, 0, 0};
+  int bestOpen = -1, bestOpenDistance = current;
+  int bestHeld = -1, bestHeldDistance = current;
+
+  int bestOpenThreat = 0;
+  for (int d = 0; d < 4; ++d) {
+    int nx = enemy.x + stepX[d];
+    int ny = enemy.y + stepY[d];
+    int distance = distanceAt(nx, ny);
+    if (distance == unreachable)
+      continue;
+    // Between equally good steps, keep out of the player's line of fire
+    int threat = gameData.playerThreat.at(nx, ny);
+    bool better = towards ? distance < bestOpenDistance
+                          : distance > bestOpenDistance;
+    bool asGoodButSafer =
+        bestOpen >= 0 && distance == bestOpenDistance && threat < bestOpenThreat;
+    if ((better || asGoodButSafer) && isOpenTile(nx, ny, gameData)) {
+      bestOpen = d;
+      bestOpenDistance = distance;
+      bestOpenThreat = threat;
+    } else if (towards && distance < bestHeldDistance &&
+               isHeldByEnemy(nx, ny, gameData)) {
+      bestHeld = d;
+      bestHeldDistance = distance;
+    }
+  }
+
+  int chosen = bestOpen >= 0 ? bestOpen : bestHeld;
+  if (chosen < 0)
+    return false;
+  planMove(plan, enemy.x + stepX[chosen], enemy.y + stepY[chosen]);
+  return true;
+}
+
+static bool stepAlongPlayerField(const Enemy &enemy, const GameData &gameData,
+                                 bool towards, IntendedAction &plan) {
+  const AiTurnInputs &ai = gameData.aiInputs;
+  return stepAlongField(
+      enemy, gameData, [&](int x, int y) { return ai.distanceAt(x, y); },
+      AiTurnInputs::UNREACHABLE, towards, plan);
+}
+
+// Walks to the slot assignSquadSlots gave this enemy; once there, holds it.
+static bool stepToSquadSlot(const Enemy &enemy, const GameData &gameData,
+                            IntendedAction &plan) {
+  const SquadSlot &slot = gameData.squad.slots[enemy.squadSlot];
+  if (enemy.x == slot.x && enemy.y == slot.y)
+    return true; // Holding: plan stays WAIT
+  return stepAlongField(
+      enemy, gameData, [&](int x, int y) { return slot.distanceFrom(x, y); },
+      SquadSlot::UNREACHABLE, true, plan);
+}
+
+// Steps to the open neighbour where the stimulus is strongest, if any is
+// stronger than here.
+static bool climbStimulus(const Enemy &enemy, const GameData &gameData,
+                          const StimulusMap &map, IntendedAction &plan) {
+  const int stepX[4] = {0, 0, -1, 1};
+  const int stepY[4] = {-1, 1, 0, 0};
+  float best = map.sample(enemy.x, enemy.y, gameData.turnNumber);
+  int chosen = -1;
+  for (int d = 0; d < 4; ++d) {
+    int nx = enemy.x + stepX[d];
+    int ny = enemy.y + stepY[d];
+    float value = map.sample(nx, ny, gameData.turnNumber);
+    if (value > best && isOpenTile(nx, ny, gameData)) {
+      best = value;
+      chosen = d;
+    }
+  }
+  if (chosen < 0)
+    return false;
+  planMove(plan, enemy.x + stepX[chosen], enemy.y + stepY[chosen]);
+  return true;
+}
+
+// Greedy step towards a tile, primary axis first. No field needed.
+static bool stepTowards(const Enemy &enemy, const GameData &gameData,
+                        int goalX, int goalY, IntendedAction &plan) {
+  int dx = goalX - enemy.x;
+  int dy = goalY - enemy.y;
+  int primaryX = 0, primaryY = 0, altX = 0, altY = 0;
+  if (std::abs(dx) >= std::abs(dy)) {
+    primaryX = (dx > 0) - (dx < 0);
+    altY = (dy > 0) - (dy < 0);
+  } else {
+    primaryY = (dy > 0) - (dy < 0);
+    altX = (dx > 0) - (dx < 0);
+  }
+  if ((primaryX != 0 || primaryY != 0) &&
+      isOpenTile(enemy.x + primaryX, enemy.y + primaryY, gameData)) {
+    planMove(plan, enemy.x + primaryX, enemy.y + primaryY);
+    return true;
+  }
+  if ((altX != 0 || altY != 0) &&
+      isOpenTile(enemy.x + altX, enemy.y + altY, gameData)) {
+    planMove(plan, enemy.x + altX, enemy.y + altY);
+    return true;
+  }
+  return false;
+}
+
+static bool wander(const Enemy &enemy, const GameData &gameData,
+                   IntendedAction &plan) {
+  const int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+  int randIndex = planningRoll(gameData.planningSeed, enemy.id) % 4;
+  int nextX = enemy.x + directions[randIndex][0];
+  int nextY = enemy.y + directions[randIndex][1];
+  if (isOpenTile(nextX, nextY, gameData) ||
+      isHeldByEnemy(nextX, nextY, gameData)) { // Wander after the enemy in the way
+    planMove(plan, nextX, nextY);
+    return true;
+  }
+  return false;
+}
+
+IntendedAction chooseEnemyAction(const Enemy &enemy, const GameData &gameData) {
+  IntendedAction plan;
+  plan.enemyHandle = enemy.handle;
+  plan.type = ActionType::Wait;
+
+  const EnemyArchetype &arch = enemy.archetype();
+  const AiInputValues in = gatherAiInputs(enemy, gameData);
+
+  // --- Score ---
+  AiBehavior best = AiBehavior::Wait;
+  float bestScore = 0.0f;
+  for (const BehaviorScorer &scorer : arch.behaviors) {
+    if (!isBehaviorPossible(scorer.behavior, in, arch))
+      continue;
+    float score = scorer.weight;
+    for (const Consideration &consideration : scorer.considerations) {
+      score *= consideration.curve.evaluate(in[consideration.input]);
+      if (score <= 0.0f)
+        break;
+    }
+    if (score > bestScore) {
+      bestScore = score;
+      best = scorer.behavior;
+    }
+  }
+
+  // --- Act ---
+  const int playerX = gameData.aiInputs.playerX;
+  const int playerY = gameData.aiInputs.playerY;
+  bool planned = true;
+  switch (best) {
+  case AiBehavior::MeleeAttack:
+    plan.type = ActionType::Attack;
+    plan.targetX = playerX;
+    plan.targetY = playerY;
+    break;
+  case AiBehavior::RangedAttack:
+    plan.type = ActionType::CastSpell;
+    plan.targetX = playerX;
+    plan.targetY = playerY;
+    plan.spellIndex = 0; // Archetypes have a single ranged attack
+    break;
+  case AiBehavior::Chase:
+    // Squad members close in on their own slot rather than the player
+    if (enemy.squadSlot >= 0 &&
+        enemy.squadSlot < (int)gameData.squad.slots.size())
+      planned = stepToSquadSlot(enemy, gameData, plan);
+    else
+      planned = stepAlongPlayerField(enemy, gameData, true, plan);
+    break;
+  case AiBehavior::Flee:
+    planned = stepAlongPlayerField(enemy, gameData, false, plan);
+    break;
+  case AiBehavior::Guard:
+    if (in[AiInput::HomeDistance] > arch.guardRadius)
+      planned = stepTowards(enemy, gameData, enemy.homeX, enemy.homeY, plan);
+    break;
+  case AiBehavior::Investigate:
+    planned = climbStimulus(enemy, gameData, gameData.noiseMap, plan);
+    break;
+  case AiBehavior::Track:
+    planned = climbStimulus(enemy, gameData, gameData.scentMap, plan);
+    break;
+  case AiBehavior::Wander:
+    planned = wander(enemy, gameData, plan);
+    break;
+  case AiBehavior::Wait:
+    break;
+  }
+
+  // Debug priority: this runs for every enemy every turn, on the workers
+  if (plan.type == ActionType::Move) {
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION,
+                 "Enemy %d [%d,%d] chooses %s (%.2f): MOVE to [%d,%d]",
+                 enemy.id, enemy.x, enemy.y, behaviorName(best), bestScore,
+                 plan.targetX, plan.targetY);
+  } else {
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION,
+                 "Enemy %d [%d,%d] chooses %s (%.2f)%s", enemy.id, enemy.x,
+                 enemy.y, behaviorName(best), bestScore,
+                 planned ? "" : ": blocked, WAIT");
+  }
+  return plan;
+}
@@ -0,0 +1,101 @@
+// src/enemy_ai.h
+#ifndef ENEMY_AI_H
+#define ENEMY_AI_H
+
+#include <vector>
+
+// Forward declarations
+struct GameData;
+struct IntendedAction;
+class Enemy;
+
+// --- Utility AI ---
+// Each archetype lists the behaviours it knows, and each behaviour lists the
+// considerations that score it. A consideration reads one AiInput and maps it
+// through a ResponseCurve to [0, 1]; a behaviour's score is its weight times
+// the product of its considerations. The highest score wins and is turned
+// into an IntendedAction.
+//
+// Inputs are gathered once per enemy per turn (gatherAiInputs) from data
+// built once per turn for everyone (AiTurnInputs), so adding behaviours or
+// considerations only adds a few multiplies per enemy.
+
+// What a consideration looks at. Distances are in tiles.
+enum class AiInput {
+  PlayerDistance, // Walking distance along the per-turn distance field
+  Visible,        // 1 if the player can see this enemy (and so it sees them)
+  Adjacent,       // 1 if next to the player (diagonals included)
+  HealthRatio,    // health / maxHealth
+  HomeDistance,   // Chebyshev distance from the spawn tile
+  Noise,          // gameData.noiseMap at the enemy's tile (0..1)
+  Scent,          // gameData.scentMap at the enemy's tile (0..1)
+  PlayerThreat,   // gameData.playerThreat here, scaled to 0..1 (1 = next to the player)
+  AllyDensity,    // gameData.allyDensity here, minus the enemy's own stamp
+  Count
+};
+
+enum class CurveType {
+  Constant,  // Always a
+  Linear,    // a * x + b
+  StepBelow, // 1 if x <= a, else 0
+  StepAbove  // 1 if x >= a, else 0
+};
+
+struct ResponseCurve {
+  CurveType type = CurveType::Constant;
+  float a = 1.0f;
+  float b = 0.0f;
+
+  float evaluate(float x) const; // Result is clamped to [0, 1]
+};
+
+struct Consideration {
+  AiInput input;
+  ResponseCurve curve;
+};
+
+// What an enemy can choose to do this turn.
+enum class AiBehavior {
+  Wait,
+  Wander,      // Random step (seeded per turn, thread-safe)
+  Chase,       // Step down the player distance field
+  MeleeAttack, // Hit the player; only valid when adjacent
+  RangedAttack,// Cast at the player; only valid within rangedAttackRange and visible
+  Flee,        // Step up the player distance field
+  Guard,       // Hold position near the spawn tile, walking back if it strayed
+  Investigate, // Step towards louder noise
+  Track        // Follow the player's scent trail
+};
+
+struct BehaviorScorer {
+  AiBehavior behavior = AiBehavior::Wait;
+  float weight = 1.0f;
+  std::vector<Consideration> considerations; // Empty = always weight
+};
+
+// --- Per-turn batched inputs ---
+// Built once at the start of Planning_EnemyAI and then read (never written)
+// by every planAction call, so the workers can share it.
+struct AiTurnInputs {
+  int width = 0;
+  int height = 0;
+  int playerX = -1;
+  int playerY = -1;
+  // Steps from the player over floor tiles (4-way, ignores creatures);
+  // UNREACHABLE for walls and cut-off areas. Index y * width + x.
+  std::vector<int> playerDistance;
+  std::vector<int> frontier; // BFS scratch, kept to avoid reallocating
+
+  static const int UNREACHABLE = -1;
+
+  int distanceAt(int x, int y) const;
+};
+
+// Rebuilds gameData.aiInputs for this turn. Main thread, before planning.
+void buildAiTurnInputs(GameData &gameData);
+
+// Scores the enemy's archetype behaviours and turns the winner into a plan.
+// Reads gameData only, so it is safe to call from planning workers.
+IntendedAction chooseEnemyAction(const Enemy &enemy, const GameData &gameData);
+
+#endif // ENEMY_AI_H
@@ -0,0 +1,190 @@
+// src/enemy_archetype.cpp
+#include "enemy_archetype.h"
+#include <SDL.h>
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+static EnemyArchetype archetypes[ENEMY_TYPE_COUNT];
+static bool archetypesBuilt = false;
+
+// Frame keys "<prefix>1" .. "<prefix><count>"
+static std::vector<std::string> frameNames(const std::string &prefix,
+                                           int count) {
+  std::vector<std::string> names;
+  names.reserve(count);
+  for (int i = 1; i <= count; ++i) {
+    names.push_back(prefix + std::to_string(i));
+  }
+  return names;
+}
+
+// Fills the derived fields (frame counts, attack duration, pixel size, asset
+// ids).
+static void finishArchetype(EnemyArchetype &archetype, float sizeRatio) {
+  archetype.width = static_cast<int>(archetype.tileWidth * sizeRatio);
+  archetype.height = static_cast<int>(archetype.tileHeight * sizeRatio);
+  archetype.idleFrameCount = static_cast<int>(archetype.idleFrameTextureNames.size());
+  archetype.walkFrameCount = static_cast<int>(archetype.walkFrameTextureNames.size());
+  archetype.attackFrameCount =
+      static_cast<int>(archetype.attackFrameTextureNames.size());
+  if (!archetype.textureName.empty())
+    archetype.textureId = internAssetName(archetype.textureName);
+  archetype.idleFrameIds = internAssetNames(archetype.idleFrameTextureNames);
+  archetype.walkFrameIds = internAssetNames(archetype.walkFrameTextureNames);
+  archetype.attackFrameIds = internAssetNames(archetype.attackFrameTextureNames);
+  if (!archetype.projectileTextureName.empty())
+    archetype.projectileTextureId =
+        internAssetName(archetype.projectileTextureName);
+
+  // Calculate total duration for one loop of attack animation
+  if (archetype.attackAnimationSpeed > 0 && archetype.attackFrameCount > 0) {
+    archetype.attackAnimationDuration =
+        (1.0f / archetype.attackAnimationSpeed) * archetype.attackFrameCount;
+  } else {
+    archetype.attackAnimationDuration =
+        0.5f; // Default duration if speed/frames invalid
+  }
+}
+
+// Shorthands for declaring behaviours below
+static Consideration consider(AiInput input, CurveType type, float a,
+                              float b = 0.0f) {
+  return Consideration{input, ResponseCurve{type, a, b}};
+}
+static BehaviorScorer behavior(AiBehavior kind, float weight,
+                               std::vector<Consideration> considerations = {}) {
+  return BehaviorScorer{kind, weight, std::move(considerations)};
+}
+
+void buildEnemyArchetypes(int tileWidth, int tileHeight) {
+  // --- Slime ---
+  EnemyArchetype &slime = archetypes[static_cast<int>(EnemyType::SLIME)];
+  slime = EnemyArchetype();
+  slime.type = EnemyType::SLIME;
+  slime.tileWidth = tileWidth;
+  slime.tileHeight = tileHeight;
+  slime.maxHealth = 20;
+  slime.arcanaValue = 12;
+  slime.baseAttackDamage = 8;
+  slime.moveDuration = 0.7f;
+  slime.textureName = "slime_texture";
+  slime.assetGroup = "slime"; // Shared with the spitter
+  slime.idleFrameTextureNames = frameNames("slime_idle_", 9);
+  slime.walkFrameTextureNames = frameNames("slime_walk_", 9);
+  slime.attackFrameTextureNames = frameNames("slime_attack_", 9);
+  slime.idleAnimationSpeed = 8.0f; // Slimes might animate slowly
+  slime.walkAnimationSpeed = 8.0f;
+  slime.attackAnimationSpeed = 16.0f;
+  slime.lungeDistanceRatio = 0.6f; // Slime might make smaller lunges
+  // Bite when next to the player, chase them while they're in sight, break
+  // off when nearly dead, follow noise or scent when they're not, and wander
+  // otherwise.
+  slime.behaviors = {
+      behavior(AiBehavior::MeleeAttack, 1.0f,
+               {consider(AiInput::Visible, CurveType::StepAbove, 1.0f)}),
+      // ...unless there are friends around to hold the line
+      behavior(AiBehavior::Flee, 1.2f,
+               {consider(AiInput::Visible, CurveType::StepAbove, 1.0f),
+                consider(AiInput::HealthRatio, CurveType::StepBelow, 0.2f),
+                consider(AiInput::AllyDensity, CurveType::Linear, -0.25f,
+                         1.0f)}),
+      behavior(AiBehavior::Chase, 0.6f,
+               {consider(AiInput::Visible, CurveType::StepAbove, 1.0f)}),
+      // Out of sight: head for noise, else sniff out the trail
+      behavior(AiBehavior::Investigate, 0.4f,
+               {consider(AiInput::Visible, CurveType::StepBelow, 0.0f),
+                consider(AiInput::Noise, CurveType::StepAbove, 0.1f)}),
+      behavior(AiBehavior::Track, 0.3f,
+               {consider(AiInput::Visible, CurveType::StepBelow, 0.0f),
+                consider(AiInput::Scent, CurveType::StepAbove, 0.05f)}),
+      behavior(AiBehavior::Wander, 0.1f),
+  };
+  slime.squadRing = 1; // Surround the player
+  slime.spawnWeight = 3;
+  finishArchetype(slime, 0.8f);
+
+  // --- Spitter ---
+  // A tinted slime that keeps its distance and spits fire. Holds its ground
+  // near where it spawned until the player shows up.
+  EnemyArchetype &spitter = archetypes[static_cast<int>(EnemyType::SPITTER)];
+  spitter = slime;
+  spitter.type = EnemyType::SPITTER;
+  spitter.maxHealth = 12;
+  spitter.arcanaValue = 15;
+  spitter.baseAttackDamage = 5;
+  spitter.actionCost = 150; // Sluggish: acts two turns in three
+  spitter.tintR = 140;
+  spitter.tintG = 255;
+  spitter.tintB = 120;
+  spitter.rangedAttackRange = 5;
+  spitter.projectileTextureName = "fireball";
+  spitter.guardRadius = 2;
+  spitter.behaviors = {
+      behavior(AiBehavior::Flee, 1.0f,
+               {consider(AiInput::Visible, CurveType::StepAbove, 1.0f),
+                consider(AiInput::PlayerDistance, CurveType::StepBelow, 2.0f)}),
+      // Prefer shooting from further out: 0.5 at point blank up to 0.9
+      behavior(AiBehavior::RangedAttack, 1.0f,
+               {consider(AiInput::PlayerDistance, CurveType::Linear, 0.08f,
+                         0.5f)}),
+      behavior(AiBehavior::Chase, 0.4f,
+               {consider(AiInput::Visible, CurveType::StepAbove, 1.0f)}),
+      behavior(AiBehavior::Investigate, 0.3f,
+               {consider(AiInput::Visible, CurveType::StepBelow, 0.0f),
+                consider(AiInput::Noise, CurveType::StepAbove, 0.1f)}),
+      behavior(AiBehavior::Guard, 0.2f),
+  };
+  spitter.squadRing = 4; // Spread out just inside spitting range
+  spitter.spawnWeight = 1;
+  finishArchetype(spitter, 0.7f);
+
+  archetypesBuilt = true;
+  SDL_Log("Built %d enemy archetype(s) for %dx%d tiles.", ENEMY_TYPE_COUNT,
+          tileWidth, tileHeight);
+}
+
+const EnemyArchetype &getEnemyArchetype(EnemyType type) {
+  if (!archetypesBuilt) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Enemy archetypes used before buildEnemyArchetypes()!");
+  }
+  int index = static_cast<int>(type);
+  if (index < 0 || index >= ENEMY_TYPE_COUNT) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Unknown EnemyType %d; using the first archetype.", index);
+    index = 0;
+  }
+  return archetypes[index];
+}
+
+EnemyType pickEnemySpawnType(int roll) {
+  int totalWeight = 0;
+  for (const EnemyArchetype &archetype : archetypes)
+    totalWeight += std::max(0, archetype.spawnWeight);
+  if (totalWeight <= 0)
+    return EnemyType::SLIME;
+
+  int pick = std::abs(roll) % totalWeight;
+  for (const EnemyArchetype &archetype : archetypes) {
+    pick -= std::max(0, archetype.spawnWeight);
+    if (pick < 0)
+      return archetype.type;
+  }
+  return EnemyType::SLIME;
+}
+
+std::vector<std::string> floorAssetGroups(int floorIndex) {
+  // Every type can spawn on every floor for now; depth-gated types would
+  // be filtered here
+  (void)floorIndex;
+  std::vector<std::string> groups;
+  for (const EnemyArchetype &archetype : archetypes) {
+    if (archetype.spawnWeight <= 0 || archetype.assetGroup.empty())
+      continue;
+    if (std::find(groups.begin(), groups.end(), archetype.assetGroup) ==
+        groups.end())
+      groups.push_back(archetype.assetGroup);
+  }
+  return groups;
+}
@@ -0,0 +1,79 @@
+// src/enemy_archetype.h
+#ifndef ENEMY_ARCHETYPE_H
+#define ENEMY_ARCHETYPE_H
+
+#include <SDL.h> // For Uint8
+#include <string>
+#include <vector>
+#include "asset_id.h" // For AssetId
+#include "enemy_ai.h" // For BehaviorScorer
+#include "turn_scheduler.h" // For BASE_ACTION_COST
+
+enum class EnemyType { SLIME, SPITTER };
+const int ENEMY_TYPE_COUNT = 2; // Keep in sync with EnemyType
+
+// --- Enemy Archetype ---
+// Everything that is the same for every enemy of a type: base stats, render
+// size, animation frames and timings, and the behaviours its AI scores. Built once at startup; each Enemy only
+// stores its EnemyType and looks the rest up here.
+struct EnemyArchetype {
+  EnemyType type = EnemyType::SLIME;
+
+  // --- Base Stats (before floor scaling) ---
+  int maxHealth = 10;
+  int arcanaValue = 5;
+  int baseAttackDamage = 10;
+  float moveDuration = 0.3f; // Seconds per tile (animation only)
+  int actionCost = BASE_ACTION_COST; // Game time per action; higher is slower
+
+  // --- Size ---
+  int tileWidth = 0;  // Tile size the archetype was built for
+  int tileHeight = 0;
+  int width = 0;      // Render size in pixels
+  int height = 0;
+
+  // --- Animation ---
+  std::string textureName; // Fallback texture when no animation frame applies
+  std::vector<std::string> idleFrameTextureNames;
+  std::vector<std::string> walkFrameTextureNames;
+  std::vector<std::string> attackFrameTextureNames;
+  // The names above interned once when the archetype is built; render uses these
+  AssetId textureId;
+  std::vector<AssetId> idleFrameIds;
+  std::vector<AssetId> walkFrameIds;
+  std::vector<AssetId> attackFrameIds;
+  int idleFrameCount = 0;
+  int walkFrameCount = 0;
+  int attackFrameCount = 0;
+  float idleAnimationSpeed = 4.0f;   // Frames per second
+  float walkAnimationSpeed = 4.0f;
+  float attackAnimationSpeed = 10.0f;
+  float attackAnimationDuration = 0.5f; // One loop of the attack animation
+  float lungeDistanceRatio = 0.4f;      // How far towards the target to lunge
+  Uint8 tintR = 255, tintG = 255, tintB = 255; // Colour mod for shared sprites
+  std::string assetGroup; // Manifest group its frames load with (see AssetResidency)
+
+  // --- Behaviour (see enemy_ai.h) ---
+  std::vector<BehaviorScorer> behaviors;
+  int rangedAttackRange = 0; // Tiles; 0 = no ranged attack (deals baseAttackDamage)
+  std::string projectileTextureName;
+  AssetId projectileTextureId; // Interned projectileTextureName
+  int guardRadius = 3;       // Guard walks back once it strays further than this
+  int squadRing = 0;         // Preferred distance from the player in a squad (0 = acts alone, see enemy_squad.h)
+
+  // --- Spawning ---
+  int spawnWeight = 1; // Relative chance when a level picks an enemy type
+};
+
+// Builds the registry for the given tile size. Call once at startup, before
+// any enemy is spawned.
+void buildEnemyArchetypes(int tileWidth, int tileHeight);
+// Archetype for a type. The registry must have been built.
+const EnemyArchetype &getEnemyArchetype(EnemyType type);
+// Weighted pick by spawnWeight from a caller-supplied random number.
+EnemyType pickEnemySpawnType(int roll);
+// Asset groups a floor's enemies can need: the content set to prefetch
+// before that floor is generated.
+std::vector<std::string> floorAssetGroups(int floorIndex);
+
+#endif // ENEMY_ARCHETYPE_H
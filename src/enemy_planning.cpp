@@ -0,0 +1,244 @@
+// src/enemy_planning.cpp
+#include "enemy_planning.h"
+#include "enemy.h"
+#include "game_data.h" // For GameData and IntendedAction
+#include "job_system.h"
+#include "reservation_table.h"
+#include "spatial_grid.h"
+#include "utils.h"     // For isWithinBounds
+#include <SDL.h>
+#include <algorithm>
+
+// Plans one contiguous block of the due list. Only touches
+// outActions[begin..end).
+static void planEnemyRange(const GameData &gameData,
+                           std::vector<IntendedAction> &outActions,
+                           size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    const Enemy *due = findEnemy(gameData, gameData.dueEnemies[i]);
+    if (due == nullptr || due->activityTier == ActivityTier::Dormant) {
+      outActions[i].type = ActionType::None; // Gone, or asleep
+      continue;
+    }
+    const Enemy &enemy = *due;
+    if (enemy.health > 0 && !enemy.isMoving) {
+      outActions[i] = enemy.planAction(gameData.currentLevel,
+                                       gameData.currentGamePlayer, gameData);
+    } else {
+      // Dead or still animating a move: no action this turn
+      outActions[i].type = ActionType::None;
+      if (enemy.isMoving) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                    "Enemy %d was already moving during planning phase? "
+                    "Setting action to None.",
+                    enemy.id);
+      }
+    }
+  }
+}
+
+void planEnemyActions(const GameData &gameData, JobSystem &jobs,
+                      std::vector<IntendedAction> &outActions, size_t begin,
+                      size_t end) {
+  end = std::min(end, std::min(gameData.dueEnemies.size(), outActions.size()));
+  // Contiguous chunks; the calling thread helps until they're all planned
+  jobs.parallelFor(begin, end, PARALLEL_PLANNING_MIN_ENEMIES,
+                   [&](size_t chunkBegin, size_t chunkEnd) {
+                     planEnemyRange(gameData, outActions, chunkBegin, chunkEnd);
+                   });
+}
+
+bool planEnemyActionsSliced(GameData &gameData, Uint32 budgetUs) {
+  const unsigned int threadCount = gameData.jobs.getThreadCount();
+  size_t total = std::min(gameData.dueEnemies.size(),
+                          gameData.enemyIntendedActions.size());
+  size_t cursor = static_cast<size_t>(std::max(0, gameData.currentEnemyPlanningIndex));
+
+  if (budgetUs == 0) {
+    planEnemyActions(gameData, gameData.jobs, gameData.enemyIntendedActions,
+                     cursor, total);
+    cursor = total;
+  } else {
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 budgetTicks = frequency * budgetUs / 1000000;
+    const Uint64 sliceStart = SDL_GetPerformanceCounter();
+    size_t planned = 0;
+    size_t sliceSize =
+        PLANNING_FIRST_SLICE_PER_WORKER * std::max(1u, threadCount);
+
+    while (cursor < total) {
+      size_t sliceEnd = std::min(total, cursor + sliceSize);
+      planEnemyActions(gameData, gameData.jobs, gameData.enemyIntendedActions,
+                       cursor, sliceEnd);
+      planned += sliceEnd - cursor;
+      cursor = sliceEnd;
+
+      Uint64 elapsed = SDL_GetPerformanceCounter() - sliceStart;
+      if (elapsed >= budgetTicks)
+        break;
+      // Size the next slice to fit what's left of the budget
+      double ticksPerEnemy =
+          static_cast<double>(elapsed) / static_cast<double>(planned);
+      double fits = ticksPerEnemy > 0.0
+                        ? static_cast<double>(budgetTicks - elapsed) / ticksPerEnemy
+                        : static_cast<double>(total - cursor);
+      sliceSize = std::max<size_t>(1, static_cast<size_t>(fits));
+    }
+  }
+
+  gameData.currentEnemyPlanningIndex = static_cast<int>(cursor);
+  return cursor >= total;
+}
+
+// Visibility of the tile an enemy is standing on (0 when off the map).
+static float enemyTileVisibility(const GameData &gameData, const Enemy &enemy) {
+  if (isWithinBounds(enemy.x, enemy.y, gameData.currentLevel.width,
+                     gameData.currentLevel.height) &&
+      enemy.y < (int)gameData.visibilityMap.size() &&
+      enemy.x < (int)gameData.visibilityMap[enemy.y].size()) {
+    return gameData.visibilityMap[enemy.y][enemy.x];
+  }
+  return 0.0f;
+}
+
+void resolveEnemyPlanConflicts(GameData &gameData) {
+  const int levelW = gameData.currentLevel.width;
+  const int levelH = gameData.currentLevel.height;
+  std::vector<IntendedAction> &actions = gameData.enemyIntendedActions;
+  size_t count = std::min(gameData.dueEnemies.size(), actions.size());
+  // Only entries with a Move plan are looked up, and those enemies exist:
+  // nothing is removed between planning and this pass
+  auto dueEnemy = [&gameData](size_t index) -> Enemy & {
+    return *findEnemy(gameData, gameData.dueEnemies[index]);
+  };
+
+  ReservationTable &claims = gameData.moveClaims;
+  ReservationTable &departures = gameData.moveDepartures;
+  if (claims.getWidth() != levelW || claims.getHeight() != levelH) {
+    claims.reset(levelW, levelH);
+    departures.reset(levelW, levelH);
+  } else {
+    claims.clear();
+    departures.clear();
+  }
+
+  enum MoveState : unsigned char { NotMoving, Pending, OnPath, Succeeded, Failed };
+  std::vector<unsigned char> state(count, NotMoving);
+
+  // --- Claim pass: earlier in the due list wins a contested target ---
+  for (size_t i = 0; i < count; ++i) {
+    IntendedAction &plan = actions[i];
+    if (plan.type != ActionType::Move)
+      continue;
+    const Enemy &enemy = dueEnemy(i);
+
+    if (!isWithinBounds(plan.targetX, plan.targetY, levelW, levelH)) {
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "Enemy %d planned move out of bounds to [%d,%d]. Forcing "
+                  "WAIT.",
+                  enemy.id, plan.targetX, plan.targetY);
+      plan.type = ActionType::Wait;
+      continue;
+    }
+    if (!claims.claim(plan.targetX, plan.targetY, static_cast<int>(i))) {
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "Enemy %d planned move to [%d,%d] but enemy %d claimed it "
+                  "first. Forcing WAIT.",
+                  enemy.id, plan.targetX, plan.targetY,
+                  dueEnemy(claims.claimantAt(plan.targetX, plan.targetY)).id);
+      plan.type = ActionType::Wait;
+      continue;
+    }
+    departures.claim(enemy.x, enemy.y, static_cast<int>(i));
+    state[i] = Pending;
+  }
+
+  // --- Chain pass: moving into an occupied tile only works if it empties ---
+  // Each mover depends on at most one other (whoever is leaving its target),
+  // so the dependencies form simple paths. Walk each path once and give every
+  // enemy on it the outcome at its end. A path that loops back on itself is a
+  // swap or rotation: everyone in it steps at the same time, so it succeeds.
+  std::vector<size_t> path;
+  for (size_t i = 0; i < count; ++i) {
+    if (state[i] != Pending)
+      continue;
+
+    path.clear();
+    size_t current = i;
+    MoveState outcome = Failed;
+    while (true) {
+      if (state[current] == Succeeded || state[current] == Failed) {
+        outcome = static_cast<MoveState>(state[current]);
+        break;
+      }
+      if (state[current] == OnPath) {
+        outcome = Succeeded; // Cycle
+        break;
+      }
+      state[current] = OnPath;
+      path.push_back(current);
+
+      const IntendedAction &plan = actions[current];
+      if (!gameData.occupancy.isBlocked(plan.targetX, plan.targetY)) {
+        outcome = Succeeded; // Free tile
+        break;
+      }
+      int leaver = departures.claimantAt(plan.targetX, plan.targetY);
+      if (leaver == ReservationTable::NO_CLAIMANT) {
+        outcome = Failed; // Wall, player, pedestal or an enemy that stays put
+        break;
+      }
+      current = static_cast<size_t>(leaver);
+    }
+
+    for (size_t index : path) {
+      state[index] = outcome;
+      if (outcome == Failed) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                    "Enemy %d planned move to [%d,%d] but it stays occupied. "
+                    "Forcing WAIT.",
+                    dueEnemy(index).id, actions[index].targetX,
+                    actions[index].targetY);
+        actions[index].type = ActionType::Wait;
+      }
+    }
+  }
+
+  // --- Commit pass ---
+  // Vacate every origin before occupying any target so a follower's new tile
+  // isn't cleared by the enemy it followed.
+  for (size_t i = 0; i < count; ++i) {
+    if (state[i] == Succeeded) {
+      const Enemy &enemy = dueEnemy(i);
+      gameData.occupancy.vacate(enemy.x, enemy.y);
+    }
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (state[i] != Succeeded)
+      continue;
+    Enemy &enemy = dueEnemy(i);
+    const IntendedAction &plan = actions[i];
+    if (!gameData.occupancy.place(plan.targetX, plan.targetY,
+                                  Occupant::forEnemy(enemy.handle))) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                   "Enemy %d won [%d,%d] but the tile is still occupied.",
+                   enemy.id, plan.targetX, plan.targetY);
+    }
+    gameData.spatialGrid.move(
+        {SpatialKind::Enemy, enemy.handle.slot, enemy.handle.generation},
+        enemy.x, enemy.y, plan.targetX, plan.targetY);
+
+    // Unseen and coarse-tier enemies don't animate: move them right away.
+    // Visible ones keep their position until Resolution_Start animates them.
+    if (enemy.activityTier == ActivityTier::Coarse ||
+        enemyTileVisibility(gameData, enemy) <= 0.0f) {
+      EnemyPresentation &look = gameData.enemies.presentationOf(enemy);
+      look.visualX =
+          plan.targetX * gameData.tileWidth + gameData.tileWidth / 2.0f;
+      look.visualY =
+          plan.targetY * gameData.tileHeight + gameData.tileHeight / 2.0f;
+      enemy.x = plan.targetX;
+      enemy.y = plan.targetY;
+    }
+  }
+}
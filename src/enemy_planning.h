@@ -0,0 +1,57 @@
+// src/enemy_planning.h
+#ifndef ENEMY_PLANNING_H
+#define ENEMY_PLANNING_H
+
+#include <SDL.h> // For Uint32
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+struct GameData;
+struct IntendedAction;
+class JobSystem;
+
+// --- Enemy Planning Pipeline ---
+// Only the enemies the scheduler listed in gameData.dueEnemies this turn are
+// planned; gameData.enemyIntendedActions holds one action per entry of that
+// list, in the same order. Planning a turn is split into two stages:
+//   1. Plan:    Enemy::planAction for every due enemy. Reads GameData only and
+//               writes only its own slot of the output vector, so the range
+//               is split across the job system with parallelFor.
+//   2. Resolve: a single-threaded pass over GameData's reservation tables.
+//               The enemy earlier in the due list wins a contested target; a
+//               move into an occupied tile goes through only if its occupant
+//               leaves this turn (follow-chains, swaps and rotations).
+//               Survivors are applied to the occupancy grid; unseen movers are
+//               moved instantly.
+// Because stage 1 never sees another enemy's plan, the result is the same no
+// matter how many workers are used.
+
+// Enemies per parallelFor chunk. Below this the plan stage stays on the
+// calling thread; handing out jobs costs more than a few planAction calls.
+const size_t PARALLEL_PLANNING_MIN_ENEMIES = 64;
+
+// First slice size per worker when planning against a budget. Later slices
+// are sized from the measured per-enemy cost.
+const size_t PLANNING_FIRST_SLICE_PER_WORKER = 16;
+
+// Stage 1: plans due enemies [begin, end) of gameData.dueEnemies into the
+// same slots of outActions (must already be sized to the due list). A
+// single-threaded job system runs it all on the calling thread.
+void planEnemyActions(const GameData &gameData, JobSystem &jobs,
+                      std::vector<IntendedAction> &outActions, size_t begin,
+                      size_t end);
+
+// Stage 1, time-sliced: plans from gameData.currentEnemyPlanningIndex (a
+// position in the due list) onwards until every due enemy is planned or
+// budgetUs microseconds have passed, then stores the resume point back in
+// currentEnemyPlanningIndex. Returns true once all due enemies have a plan.
+// budgetUs == 0 plans everything in one call.
+bool planEnemyActionsSliced(GameData &gameData, Uint32 budgetUs);
+
+// Stage 2: resolves contested tiles, downgrades failed moves to WAIT and
+// applies every surviving move to gameData.occupancy. Resolution_Start
+// then only has to start the animations.
+void resolveEnemyPlanConflicts(GameData &gameData);
+
+#endif // ENEMY_PLANNING_H
@@ -0,0 +1,73 @@
+// src/enemy_slot_map.cpp
+#include "enemy_slot_map.h"
+#include "enemy.h"
+#include "game_data.h" // For GameData::enemies and GameData::enemySlots
+
+EnemyHandle EnemySlotMap::insert(int denseIndex) {
+  EnemyHandle handle;
+  if (!freeSlots.empty()) {
+    handle.slot = freeSlots.back();
+    freeSlots.pop_back();
+  } else {
+    handle.slot = static_cast<uint32_t>(slots.size());
+    slots.emplace_back();
+  }
+  Slot &slot = slots[handle.slot];
+  slot.denseIndex = denseIndex;
+  handle.generation = slot.generation;
+  return handle;
+}
+
+void EnemySlotMap::erase(EnemyHandle handle) {
+  if (indexOf(handle) < 0) return;
+  Slot &slot = slots[handle.slot];
+  slot.denseIndex = -1;
+  slot.generation++; // Outstanding handles to this slot are now stale
+  freeSlots.push_back(handle.slot);
+}
+
+void EnemySlotMap::relocate(EnemyHandle handle, int denseIndex) {
+  if (indexOf(handle) < 0) return;
+  slots[handle.slot].denseIndex = denseIndex;
+}
+
+int EnemySlotMap::indexOf(EnemyHandle handle) const {
+  if (handle.slot >= slots.size()) return -1;
+  const Slot &slot = slots[handle.slot];
+  if (slot.generation != handle.generation) return -1;
+  return slot.denseIndex;
+}
+
+void EnemySlotMap::clear() {
+  freeSlots.clear();
+  for (uint32_t i = 0; i < slots.size(); ++i) {
+    if (slots[i].denseIndex >= 0) {
+      slots[i].denseIndex = -1;
+      slots[i].generation++;
+    }
+    freeSlots.push_back(i);
+  }
+}
+
+Enemy *findEnemy(GameData &gameData, EnemyHandle handle) {
+  int index = gameData.enemySlots.indexOf(handle);
+  if (index < 0 || index >= (int)gameData.enemies.size()) return nullptr;
+  return &gameData.enemies[index];
+}
+
+const Enemy *findEnemy(const GameData &gameData, EnemyHandle handle) {
+  int index = gameData.enemySlots.indexOf(handle);
+  if (index < 0 || index >= (int)gameData.enemies.size()) return nullptr;
+  return &gameData.enemies[index];
+}
+
+void syncEnemySlots(GameData &gameData) {
+  for (int i = 0; i < (int)gameData.enemies.size(); ++i) {
+    Enemy &enemy = gameData.enemies[i];
+    if (gameData.enemySlots.indexOf(enemy.handle) < 0) {
+      enemy.handle = gameData.enemySlots.insert(i);
+    } else {
+      gameData.enemySlots.relocate(enemy.handle, i);
+    }
+  }
+}
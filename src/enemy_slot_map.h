@@ -0,0 +1,64 @@
+// src/enemy_slot_map.h
+#ifndef ENEMY_SLOT_MAP_H
+#define ENEMY_SLOT_MAP_H
+
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+class Enemy;
+struct GameData;
+
+// --- Enemy Handle ---
+// Stable reference to an enemy that survives reordering of gameData.enemies.
+// The generation changes every time a slot is reused, so a handle to an enemy
+// that has since been removed is detected instead of aliasing a newcomer.
+struct EnemyHandle {
+  static const uint32_t INVALID_SLOT = 0xFFFFFFFFu;
+
+  uint32_t slot = INVALID_SLOT;
+  uint32_t generation = 0;
+
+  bool isValid() const { return slot != INVALID_SLOT; }
+  bool operator==(const EnemyHandle &other) const {
+    return slot == other.slot && generation == other.generation;
+  }
+  bool operator!=(const EnemyHandle &other) const { return !(*this == other); }
+};
+
+// --- Enemy Slot Map ---
+// Maps handles to the enemy's current index in gameData.enemies. Freed slots
+// go on a free list and are reused with a bumped generation.
+class EnemySlotMap {
+public:
+  // Registers an enemy stored at denseIndex and returns its new handle.
+  EnemyHandle insert(int denseIndex);
+  // Releases the handle's slot. Stale or invalid handles are ignored.
+  void erase(EnemyHandle handle);
+  // Records that the enemy behind handle now lives at denseIndex.
+  void relocate(EnemyHandle handle, int denseIndex);
+  // Current index in gameData.enemies, or -1 if the handle is stale.
+  int indexOf(EnemyHandle handle) const;
+  // Releases every slot; all handles handed out so far become stale.
+  void clear();
+
+private:
+  struct Slot {
+    int denseIndex = -1; // -1 while the slot is free
+    uint32_t generation = 0;
+  };
+  std::vector<Slot> slots;
+  std::vector<uint32_t> freeSlots;
+};
+
+// --- GameData helpers ---
+// O(1) lookup; nullptr if the enemy has been removed.
+Enemy *findEnemy(GameData &gameData, EnemyHandle handle);
+const Enemy *findEnemy(const GameData &gameData, EnemyHandle handle);
+// Brings the slot map in line with gameData.enemies after enemies were added
+// or the vector was compacted: enemies without a handle get one, everyone
+// else is relocated to their current index. Removed enemies must already
+// have been erase()d from the map.
+void syncEnemySlots(GameData &gameData);
+
+#endif // ENEMY_SLOT_MAP_H
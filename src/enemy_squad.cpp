@@ -0,0 +1,206 @@
+// src/enemy_squad.cpp
+#include "enemy_squad.h"
+#include "enemy.h"
+#include "game_data.h"
+#include "job_system.h"
+#include "utils.h" // For isWithinBounds
+#include <SDL.h>
+#include <algorithm>
+#include <cstdlib>
+
+// Extra cost of an outer-ring slot, so it only wins once the inner ones are
+// taken or much further away
+static const int BACKUP_SLOT_PENALTY = 3;
+// Slot fields built per job. Each is a BFS over at most (2r+1)^2 tiles.
+static const size_t SQUAD_FIELDS_PER_JOB = 4;
+
+int SquadSlot::distanceFrom(int tileX, int tileY) const {
+  int localX = tileX - x + radius;
+  int localY = tileY - y + radius;
+  int side = 2 * radius + 1;
+  if (localX < 0 || localY < 0 || localX >= side || localY >= side ||
+      field.size() != static_cast<size_t>(side) * side)
+    return UNREACHABLE;
+  return field[localY * side + localX];
+}
+
+// Bounded BFS out of the slot. The player's tile blocks: nobody walks
+// through the player to reach the far side.
+static void buildSlotField(SquadSlot &slot, const GameData &gameData,
+                           int radius, std::vector<int> &frontier) {
+  const Level &level = gameData.currentLevel;
+  const int playerX = gameData.aiInputs.playerX;
+  const int playerY = gameData.aiInputs.playerY;
+  const int side = 2 * radius + 1;
+  slot.radius = radius;
+  slot.field.assign(static_cast<size_t>(side) * side, SquadSlot::UNREACHABLE);
+
+  frontier.clear();
+  slot.field[radius * side + radius] = 0;
+  frontier.push_back(radius * side + radius);
+  const int stepX[4] = {0, 0, -1, 1};
+  const int stepY[4] = {-1, 1, 0, 0};
+  for (size_t head = 0; head < frontier.size(); ++head) {
+    int local = frontier[head];
+    int lx = local % side;
+    int ly = local / side;
+    int nextDistance = slot.field[local] + 1;
+    for (int d = 0; d < 4; ++d) {
+      int nlx = lx + stepX[d];
+      int nly = ly + stepY[d];
+      if (nlx < 0 || nly < 0 || nlx >= side || nly >= side)
+        continue;
+      int worldX = slot.x - radius + nlx;
+      int worldY = slot.y - radius + nly;
+      if (!isWithinBounds(worldX, worldY, level.width, level.height) ||
+          level.tiles[worldY][worldX] == '#' ||
+          (worldX == playerX && worldY == playerY))
+        continue;
+      int nextLocal = nly * side + nlx;
+      if (slot.field[nextLocal] != SquadSlot::UNREACHABLE)
+        continue;
+      slot.field[nextLocal] = nextDistance;
+      frontier.push_back(nextLocal);
+    }
+  }
+}
+
+// Candidate tiles on one ring around the player: floor, reachable, and
+// sorted so the ones closest to the player on foot come first.
+static void collectRingTiles(const GameData &gameData, int ring,
+                             std::vector<SquadSlot> &out) {
+  const AiTurnInputs &ai = gameData.aiInputs;
+  const Level &level = gameData.currentLevel;
+  size_t first = out.size();
+  for (int dy = -ring; dy <= ring; ++dy) {
+    for (int dx = -ring; dx <= ring; ++dx) {
+      if (std::max(std::abs(dx), std::abs(dy)) != ring)
+        continue; // Only the ring itself
+      int x = ai.playerX + dx;
+      int y = ai.playerY + dy;
+      if (!isWithinBounds(x, y, level.width, level.height) ||
+          level.tiles[y][x] == '#' ||
+          ai.distanceAt(x, y) == AiTurnInputs::UNREACHABLE)
+        continue;
+      SquadSlot slot;
+      slot.x = x;
+      slot.y = y;
+      out.push_back(slot);
+    }
+  }
+  std::sort(out.begin() + first, out.end(),
+            [&](const SquadSlot &a, const SquadSlot &b) {
+              return ai.distanceAt(a.x, a.y) < ai.distanceAt(b.x, b.y);
+            });
+}
+
+void assignSquadSlots(GameData &gameData) {
+  SquadPlan &squad = gameData.squad;
+  squad.slots.clear();
+  squad.members = 0;
+  squad.assigned = 0;
+
+  const AiTurnInputs &ai = gameData.aiInputs;
+  const int searchRadius = std::max(1, gameData.squadSearchRadius);
+
+  // --- Members: awake, engaged, close enough and willing ---
+  std::vector<size_t> members;
+  int membersPerRing[8] = {0}; // Rings above 7 act alone
+  for (size_t i = 0; i < gameData.enemies.size(); ++i) {
+    Enemy &enemy = gameData.enemies[i];
+    enemy.squadSlot = -1;
+    int ring = enemy.archetype().squadRing;
+    if (enemy.health <= 0 || enemy.isMoving || ring <= 0 || ring >= 8 ||
+        !enemy.actsThisTurn || enemy.activityTier == ActivityTier::Dormant)
+      continue;
+    bool engaged = enemy.alertTurns > 0;
+    if (!engaged && enemy.y < (int)gameData.visibilityMap.size() &&
+        enemy.x < (int)gameData.visibilityMap[enemy.y].size()) {
+      engaged = gameData.visibilityMap[enemy.y][enemy.x] > 0.0f;
+    }
+    int distance = ai.distanceAt(enemy.x, enemy.y);
+    if (!engaged || distance == AiTurnInputs::UNREACHABLE ||
+        distance > searchRadius + ring)
+      continue;
+    members.push_back(i);
+    membersPerRing[ring]++;
+  }
+  squad.members = static_cast<int>(members.size());
+  if (members.empty())
+    return;
+
+  // --- Slots: each ring in use plus the ring outside it as backup ---
+  // Twice as many slots as members on a ring is plenty of choice.
+  std::vector<SquadSlot> ringTiles;
+  for (int ring = 1; ring < 8; ++ring) {
+    if (membersPerRing[ring] == 0)
+      continue;
+    for (int outer = 0; outer <= 1; ++outer) {
+      ringTiles.clear();
+      collectRingTiles(gameData, ring + outer, ringTiles);
+      size_t wanted = static_cast<size_t>(membersPerRing[ring]) * 2;
+      for (size_t t = 0; t < ringTiles.size() && t < wanted; ++t) {
+        if (squad.slots.size() >= static_cast<size_t>(gameData.squadMaxSlots))
+          break;
+        ringTiles[t].ring = ring;
+        ringTiles[t].backup = (outer == 1);
+        squad.slots.push_back(ringTiles[t]);
+      }
+    }
+  }
+
+  // Each slot's field is independent; a chunk of slots shares one frontier
+  gameData.jobs.parallelFor(
+      0, squad.slots.size(), SQUAD_FIELDS_PER_JOB,
+      [&](size_t begin, size_t end) {
+        std::vector<int> frontier;
+        for (size_t s = begin; s < end; ++s) {
+          buildSlotField(squad.slots[s], gameData, searchRadius, frontier);
+        }
+      });
+
+  // --- Greedy min-cost matching ---
+  struct Pairing {
+    int cost;
+    size_t member; // Index into members
+    int slot;
+  };
+  std::vector<Pairing> pairings;
+  pairings.reserve(members.size() * squad.slots.size());
+  for (size_t m = 0; m < members.size(); ++m) {
+    const Enemy &enemy = gameData.enemies[members[m]];
+    int ring = enemy.archetype().squadRing;
+    for (size_t s = 0; s < squad.slots.size(); ++s) {
+      const SquadSlot &slot = squad.slots[s];
+      if (slot.ring != ring)
+        continue;
+      int distance = slot.distanceFrom(enemy.x, enemy.y);
+      if (distance == SquadSlot::UNREACHABLE)
+        continue;
+      int cost = distance + (slot.backup ? BACKUP_SLOT_PENALTY : 0);
+      pairings.push_back({cost, m, static_cast<int>(s)});
+    }
+  }
+  // Ties go to the lower enemy index, then the lower slot, to stay deterministic
+  std::sort(pairings.begin(), pairings.end(),
+            [](const Pairing &a, const Pairing &b) {
+              if (a.cost != b.cost)
+                return a.cost < b.cost;
+              if (a.member != b.member)
+                return a.member < b.member;
+              return a.slot < b.slot;
+            });
+
+  std::vector<bool> slotTaken(squad.slots.size(), false);
+  for (const Pairing &pairing : pairings) {
+    Enemy &enemy = gameData.enemies[members[pairing.member]];
+    if (enemy.squadSlot >= 0 || slotTaken[pairing.slot])
+      continue;
+    enemy.squadSlot = pairing.slot;
+    slotTaken[pairing.slot] = true;
+    squad.assigned++;
+  }
+
+  SDL_Log("Squad: %d engaged enemies, %zu slots, %d assigned.", squad.members,
+          squad.slots.size(), squad.assigned);
+}
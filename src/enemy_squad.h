@@ -0,0 +1,49 @@
+// src/enemy_squad.h
+#ifndef ENEMY_SQUAD_H
+#define ENEMY_SQUAD_H
+
+#include <vector>
+
+// Forward declarations
+struct GameData;
+
+// --- Squad Coordination ---
+// Once per turn, enemies that are engaging the player are handed target
+// tiles ("slots") around them in one matching step, instead of each one
+// stepping greedily at the player and queueing up behind the others.
+//
+// Each archetype with a squadRing > 0 wants to stand that many tiles from the
+// player (1 = surround, more = ranged standoff). Slots are built on that ring
+// and the ring just outside it; outer slots cost more, so they only fill once
+// the inner ring is taken and their holders wait there (holding a corridor
+// instead of shoving into it). Costs are walking distances from a bounded BFS
+// run out of each slot; pairs are matched greedily, cheapest first.
+//
+// The per-enemy planning work is then a lookup in its slot's field.
+
+struct SquadSlot {
+  int x = 0;
+  int y = 0;
+  int ring = 1;        // Chebyshev distance from the player this slot is for
+  bool backup = false; // On the outer ring: hold here until an inner slot frees
+  // Walking distance to the slot over a (2 * radius + 1)^2 window centred on
+  // it; UNREACHABLE outside the window, on walls and on the player's tile.
+  int radius = 0;
+  std::vector<int> field;
+
+  static const int UNREACHABLE = -1;
+
+  int distanceFrom(int tileX, int tileY) const;
+};
+
+struct SquadPlan {
+  std::vector<SquadSlot> slots; // Rebuilt each turn
+  int members = 0;              // Enemies considered this turn
+  int assigned = 0;             // ...of which got a slot
+};
+
+// Rebuilds gameData.squad and sets every enemy's squadSlot (-1 = acting
+// alone). Main thread, after buildAiTurnInputs and before planning.
+void assignSquadSlots(GameData &gameData);
+
+#endif // ENEMY_SQUAD_H
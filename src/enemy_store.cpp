@@ -0,0 +1,19 @@
+// src/enemy_store.cpp
+#include "enemy_store.h"
+
+Enemy &EnemyStore::emplace_back(int uniqueId, EnemyType type, int startX,
+                                int startY) {
+  hot.emplace_back(uniqueId, type, startX, startY);
+  cold.emplace_back(getEnemyArchetype(type), startX, startY);
+  return hot.back();
+}
+
+void EnemyStore::clear() {
+  hot.clear();
+  cold.clear();
+}
+
+void EnemyStore::reserve(size_t count) {
+  hot.reserve(count);
+  cold.reserve(count);
+}
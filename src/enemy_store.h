@@ -0,0 +1,85 @@
+// src/enemy_store.h
+#ifndef ENEMY_STORE_H
+#define ENEMY_STORE_H
+
+#include "enemy.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// --- Enemy Store ---
+// Owns every enemy in the level, split by how often each part is touched:
+//   hot  - the compact Enemy records every per-turn pass walks (position,
+//          health, activity tier, schedule, handle). Iteration and
+//          operator[] read like std::vector<Enemy>.
+//   cold - one EnemyPresentation per enemy (visual position, animation
+//          timers, attack lunge), read only by the per-frame update and
+//          render.
+// The arrays are index-aligned and compacted together. Data shared by a whole
+// type (asset keys, speeds, sizes) is not stored per enemy at all; it lives in
+// the EnemyArchetype registry.
+//
+// The hot side is an array of records rather than one array per field, since
+// Enemy's member functions and the AI read whole enemies.
+class EnemyStore {
+public:
+  using iterator = std::vector<Enemy>::iterator;
+  using const_iterator = std::vector<Enemy>::const_iterator;
+
+  // Constructs an enemy in place. Doesn't allocate while size() < capacity.
+  Enemy &emplace_back(int uniqueId, EnemyType type, int startX, int startY);
+
+  // Removes every enemy matching pred, keeping the survivors in order. pred is
+  // called once per enemy. Returns the number removed.
+  template <typename Predicate> size_t eraseIf(Predicate pred) {
+    size_t write = 0;
+    for (size_t read = 0; read < hot.size(); ++read) {
+      if (pred(static_cast<const Enemy &>(hot[read])))
+        continue;
+      if (write != read) {
+        hot[write] = std::move(hot[read]);
+        cold[write] = cold[read];
+      }
+      ++write;
+    }
+    size_t removed = hot.size() - write;
+    hot.erase(hot.begin() + write, hot.end());
+    cold.erase(cold.begin() + write, cold.end());
+    return removed;
+  }
+
+  void clear();
+  void reserve(size_t count);
+
+  size_t size() const { return hot.size(); }
+  bool empty() const { return hot.empty(); }
+  Enemy &operator[](size_t index) { return hot[index]; }
+  const Enemy &operator[](size_t index) const { return hot[index]; }
+  Enemy &back() { return hot.back(); }
+  const Enemy &back() const { return hot.back(); }
+  iterator begin() { return hot.begin(); }
+  iterator end() { return hot.end(); }
+  const_iterator begin() const { return hot.begin(); }
+  const_iterator end() const { return hot.end(); }
+
+  // Presentation of the enemy at index, or of an enemy stored here.
+  EnemyPresentation &presentation(size_t index) { return cold[index]; }
+  const EnemyPresentation &presentation(size_t index) const {
+    return cold[index];
+  }
+  EnemyPresentation &presentationOf(const Enemy &enemy) {
+    return cold[indexOf(enemy)];
+  }
+  const EnemyPresentation &presentationOf(const Enemy &enemy) const {
+    return cold[indexOf(enemy)];
+  }
+  size_t indexOf(const Enemy &enemy) const {
+    return static_cast<size_t>(&enemy - hot.data());
+  }
+
+private:
+  std::vector<Enemy> hot;
+  std::vector<EnemyPresentation> cold;
+};
+
+#endif // ENEMY_STORE_H
@@ -7,10 +7,25 @@
 #include <vector>
 
 // Include headers for types used AS MEMBERS in GameData
+#include "asset_id.h"   // For AssetId
 #include "character.h"  // For PlayerCharacter
-#include "enemy.h"      // For std::vector<Enemy>
+#include "enemy.h"      // For Enemy
+#include "enemy_store.h" // For EnemyStore
+#include "enemy_ai.h"    // For AiTurnInputs
+#include "enemy_squad.h" // For SquadPlan
 #include "level.h"      // For Level
 #include "projectile.h" // For std::vector<Projectile>
+#include "reservation_table.h" // For per-turn move reservations
+#include "occupancy_grid.h"    // For OccupancyGrid
+#include "spatial_grid.h"      // For SpatialGrid
+#include "stimulus_map.h"      // For noise and scent maps
+#include "influence_map.h"     // For threat and ally density maps
+#include "turn_scheduler.h"    // For TurnScheduler
+#include "task.h"              // For TaskState
+#include "job_system.h"        // For JobSystem
+#include "sprite_batcher.h"    // For SpriteBatcher
+#include "render_queue.h"      // For RenderQueue
+#include "terrain_cache.h"     // For TerrainCache
 #include <SDL.h>        // For SDL_Renderer*, SDL_Texture* etc.
 #include <SDL_ttf.h>    // For TTF_Font*
 
@@ -33,7 +48,7 @@ struct IntendedAction {
     int targetY = -1;       // Target tile Y coordinate (used for Move, Tile-Targeted Spells)
     int targetEntityID = -1;// Placeholder for targeting specific entities (Requires unique IDs on Player/Enemy)
     int spellIndex = -1;    // Index of the spell intended to be cast (from the caster's knownSpells)
-    int enemyId = -1; 
+    EnemyHandle enemyHandle; // Enemy that planned this action (invalid for the player)
     // Consider adding caster information if needed later (e.g., casterID or pointer)
 };
 
@@ -48,6 +63,7 @@ struct ItemDrop {
     int y; // Tile Y coordinate
     ItemType type; // What kind of item it is
     std::string textureName; // Key for the AssetManager
+    AssetId spriteId;        // textureName interned, for rendering
     // Add other properties if needed later (e.g., amount, identifier)
 };
 
@@ -55,6 +71,7 @@ struct RunePedestal {
     int x; // Tile X coordinate
     int y; // Tile Y coordinate
     std::vector<std::string> frameTextureNames; // Keys for animation frames
+    std::vector<AssetId> frameIds;              // The same keys interned
     float animationTimer = 0.0f;
     int currentFrame = 0;
     float animationSpeed = 4.0f; // Frames per second (adjust as needed)
@@ -69,6 +86,7 @@ struct RunePedestal {
         for (int i = 1; i <= 10; ++i) {
             frameTextureNames.push_back("rune_pedestal_" + std::to_string(i));
         }
+        frameIds = internAssetNames(frameTextureNames);
     }
 };
 
@@ -78,7 +96,7 @@ struct RunePedestal {
 enum class TurnPhase {
     // Planning Phase: Actors decide what they want to do.
     Planning_PlayerInput, // Waiting for player input to determine their IntendedAction.
-    Planning_EnemyAI,     // Enemies sequentially determine their IntendedActions.
+    Planning_EnemyAI,     // Enemies determine their IntendedActions (parallel plan, serial conflict pass).
 
     // Action Resolution Phase: Execute the planned actions concurrently.
     // This might span multiple frames for animations.
@@ -102,6 +120,15 @@ enum class GameMenu {
 };
 
 
+// Wall-clock timings for the turn log (0 = not running)
+struct PhaseTimers {
+    Uint32 planningWallClockStart = 0; // Planning_EnemyAI first frame
+    Uint32 enemyPlanningCpuMs = 0;     // Time spent inside planning this turn
+    Uint32 resolutionStart = 0;        // Resolution task started
+    Uint32 resolutionWatchdog = 0;     // Last stall check of the counter
+};
+
+
 // --- Main Game Data Structure ---
 struct GameData {
     // --- Rendering Context ---
@@ -109,25 +136,63 @@ struct GameData {
 
     // --- NEW: Turn Phase & Control ---
     TurnPhase currentPhase = TurnPhase::Planning_PlayerInput; // Start by waiting for player input
-    int currentEnemyPlanningIndex = 0; // Used to iterate through enemies during Planning_EnemyAI phase
+    int currentEnemyPlanningIndex = 0; // Next dueEnemies entry to plan; planning resumes here on the next frame when out of budget
+    unsigned int planningSeed = 0;     // Per-turn seed for enemy random choices (set before planning)
+    int turnNumber = 0;                // Turns completed this run (stimulus maps fade by it)
+    int64_t gameClock = 0;             // Game time; advances by the player's action cost each turn
+    TurnScheduler scheduler;           // Enemies keyed on when they next act
+    std::vector<EnemyHandle> dueEnemies; // Enemies acting this turn (actsThisTurn set)
 
     // --- Entities & Level ---
     // PlayerCharacter needs default constructor or initialization in main.cpp
     PlayerCharacter currentGamePlayer{CharacterType::FemaleMage, 0, 0, 64, 64}; // Example initialization
-    std::vector<Enemy> enemies;                 // Stores all enemies currently in the level
+    EnemyStore enemies;                         // Stores all enemies currently in the level (hot/cold split)
+    EnemySlotMap enemySlots;                    // EnemyHandle -> index into enemies (see syncEnemySlots)
     std::vector<Projectile> activeProjectiles;  // Stores projectiles currently in flight
     std::vector<ItemDrop> droppedItems; // *** NEW: Container for dropped items ***
     Level currentLevel;                         // Holds the current level layout (tiles, dimensions)
     std::optional<RunePedestal> currentPedestal;// Stores the single pedestal for the current level
     std::vector<SDL_Rect> levelRooms;           // Stores the generated room rectangles
     std::vector<std::vector<float>> visibilityMap; // Stores visibility level (0.0 to 1.0) for each tile
-    std::vector<std::vector<bool>> occupationGrid; // Represents the CURRENT occupied state of tiles (walls, entities)
-    // Optional: A separate grid could track *intended* occupation during Planning_EnemyAI
-    // std::vector<std::vector<bool>> intendedOccupationGrid;
+    OccupancyGrid occupancy; // Who occupies each tile right now (walls, player, enemies, pedestal)
+    SpatialGrid spatialGrid; // Enemies, dropped items and projectiles by area, for camera culling
+    // Per-turn move reservations, rebuilt while resolving enemy plans (claimant = enemy index)
+    ReservationTable moveClaims;     // Target tile -> enemy that won it this turn
+    ReservationTable moveDepartures; // Origin tile -> enemy leaving it this turn
+    AiTurnInputs aiInputs; // Shared enemy AI inputs (player distance field), rebuilt each turn before planning
+    SquadPlan squad;       // Slots around the player handed out to engaged enemies each turn
+    StimulusMap noiseMap;  // Spells, impacts and footsteps; spread through walkable tiles
+    StimulusMap scentMap;  // Trail the player leaves behind them
+    std::vector<int> noiseReachedScratch; // Tiles reached by the last emitNoise
+    // Influence maps, restamped incrementally around movers (see influence_map.h)
+    InfluenceMap enemyThreat;   // Enemies that can attack each tile next turn
+    InfluenceMap allyDensity;   // Enemy crowding
+    InfluenceMap playerThreat;  // Exposure to the player's spells
+    int playerInfluenceX = -1;  // Where the player was last stamped into playerThreat
+    int playerInfluenceY = -1;
+    int playerInfluenceRadius = 0;
 
     // --- NEW: Stored Intended Actions ---
     IntendedAction playerIntendedAction;        // Stores the action the player decides on
-    std::vector<IntendedAction> enemyIntendedActions; // Stores actions planned by enemies (resized each turn)
+    std::vector<IntendedAction> enemyIntendedActions; // One planned action per dueEnemies entry, same order
+
+    // --- Turn Resolution ---
+    // Moves and projectiles started this turn that haven't finished. Each one
+    // counts itself off when it completes; the turn ends when this reaches 0.
+    int pendingResolutions = 0;
+    bool playerMovePending = false;            // The player's move is counted above
+    std::vector<EnemyHandle> animatingEnemies; // Enemies whose move is counted above
+    TaskState resolutionTask;                  // Resumable resolution (see task.h)
+    PhaseTimers phaseTimers;
+
+    // --- Worker Threads ---
+    JobSystem jobs; // Started in main() with jobThreads
+
+    // --- Rendering ---
+    SpriteBatcher spriteBatcher; // World sprites in renderScene
+    RenderQueue renderQueue;     // Sorted into spriteBatcher each frame
+    TerrainCache terrainCache;   // Level tiles pre-rendered in chunks
+    std::vector<SpatialEntry> visibleObjects; // Scratch for spatialGrid queries
 
 
     // --- UI / Menu State (Keep relevant parts) ---
@@ -137,6 +202,7 @@ struct GameData {
     int targetIndicatorX = 0;                   // X coordinate for player's targeting reticle
     int targetIndicatorY = 0;                   // Y coordinate for player's targeting reticle
     bool showTargetingReticle = false;          // Controls rendering of the targeting indicator
+    bool showThreatOverlay = false;             // Tint tiles enemies can attack next turn (V)
 
     // Main Menu/Character Select state (Keep for game start flow)
     std::vector<std::string> menuItems = {"Start Game", "Options", "Exit"};
@@ -172,6 +238,24 @@ struct GameData {
     int healthCrystalChancePercent = 50; // *** NEW: Chance (0-100) for a dropped crystal to be RED (Health) ***
     int maxEnemyCount = 100;
     int spawnChancePercent = 15;
+    int jobThreads = 0; // Job system threads including the main thread (0 = auto, 1 = single-threaded for debugging; --single-thread)
+    // Per-frame enemy planning budget in microseconds. Lower keeps frames smooth
+    // with big crowds but spreads the turn over more frames; 0 = plan everyone in one frame.
+    int enemyPlanningBudgetUs = 4000;
+    // Terrain chunks kept as render targets; the least recently drawn is recycled past this
+    int terrainChunkBudget = 24;
+    // Memory for asset groups loaded on demand (see AssetResidency); idle groups are evicted past this. 0 = no limit
+    int assetBudgetMB = 64;
+    // Enemy activity tiers (distances in tiles from the player, see enemy_activity.h)
+    int enemyFullActivityRadius = 10;   // Within this: animated and planned every turn
+    int enemyCoarseActivityRadius = 24; // Within this: planned every turn, moves snap, no animation
+    int noiseWakeRadius = 8;            // Spell casts and impacts carry this many walkable steps
+    int playerStepNoiseRadius = 2;      // Footsteps carry this many steps
+    float noiseDecayPerTurn = 0.25f;    // Noise fades fully in 4 turns
+    float scentDecayPerTurn = 0.04f;    // Scent trail lasts 25 turns
+    int enemyAlertTurns = 5;            // Turns a woken enemy stays at full activity
+    int squadSearchRadius = 12;         // Squad slots are only matched to enemies within this walk
+    int squadMaxSlots = 32;             // Cap on slots built per turn (each costs a bounded BFS)
 
 
     // --- Frame Input Flags --- (Can still be useful in handleEvents)
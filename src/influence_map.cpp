@@ -0,0 +1,196 @@
+// src/influence_map.cpp
+#include "influence_map.h"
+#include "enemy.h"
+#include "game_data.h"
+#include <SDL.h>
+#include <algorithm>
+#include <cstdlib>
+
+// Kernels are cached by radius up to this size; bigger radii are clamped
+static const int MAX_KERNEL_RADIUS = 16;
+
+InfluenceKernel InfluenceKernel::flatSquare(int radius, int weight) {
+  InfluenceKernel kernel;
+  kernel.radius = std::max(0, radius);
+  int side = 2 * kernel.radius + 1;
+  kernel.weights.assign(static_cast<size_t>(side) * side, weight);
+  return kernel;
+}
+
+InfluenceKernel InfluenceKernel::diamondFalloff(int radius) {
+  InfluenceKernel kernel;
+  kernel.radius = std::max(0, radius);
+  int side = 2 * kernel.radius + 1;
+  kernel.weights.assign(static_cast<size_t>(side) * side, 0);
+  for (int dy = -kernel.radius; dy <= kernel.radius; ++dy)
+    for (int dx = -kernel.radius; dx <= kernel.radius; ++dx) {
+      int distance = std::abs(dx) + std::abs(dy);
+      if (distance <= kernel.radius)
+        kernel.weights[(dy + kernel.radius) * side + (dx + kernel.radius)] =
+            kernel.radius + 1 - distance;
+    }
+  return kernel;
+}
+
+InfluenceKernel InfluenceKernel::squareFalloff(int radius) {
+  InfluenceKernel kernel;
+  kernel.radius = std::max(0, radius);
+  int side = 2 * kernel.radius + 1;
+  kernel.weights.assign(static_cast<size_t>(side) * side, 0);
+  for (int dy = -kernel.radius; dy <= kernel.radius; ++dy)
+    for (int dx = -kernel.radius; dx <= kernel.radius; ++dx) {
+      int distance = std::max(std::abs(dx), std::abs(dy));
+      kernel.weights[(dy + kernel.radius) * side + (dx + kernel.radius)] =
+          kernel.radius + 1 - distance;
+    }
+  return kernel;
+}
+
+void InfluenceMap::reset(int w, int h) {
+  width = std::max(0, w);
+  height = std::max(0, h);
+  values.assign(static_cast<size_t>(width) * height, 0);
+}
+
+void InfluenceMap::stamp(int x, int y, const InfluenceKernel &kernel,
+                         int sign) {
+  const int side = 2 * kernel.radius + 1;
+  // Clip the kernel to the map once instead of testing every tile
+  int minX = std::max(0, x - kernel.radius);
+  int maxX = std::min(width - 1, x + kernel.radius);
+  int minY = std::max(0, y - kernel.radius);
+  int maxY = std::min(height - 1, y + kernel.radius);
+  for (int ty = minY; ty <= maxY; ++ty) {
+    const int *kernelRow = &kernel.weights[(ty - y + kernel.radius) * side];
+    int *row = &values[ty * width];
+    for (int tx = minX; tx <= maxX; ++tx)
+      row[tx] += sign * kernelRow[tx - x + kernel.radius];
+  }
+}
+
+int InfluenceMap::at(int x, int y) const {
+  if (x < 0 || y < 0 || x >= width || y >= height)
+    return 0;
+  return values[y * width + x];
+}
+
+// --- Kernel cache ---
+
+static const InfluenceKernel &threatKernel(int radius) {
+  static std::vector<InfluenceKernel> cache;
+  radius = std::max(0, std::min(radius, MAX_KERNEL_RADIUS));
+  if (cache.empty()) {
+    for (int r = 0; r <= MAX_KERNEL_RADIUS; ++r)
+      cache.push_back(InfluenceKernel::flatSquare(r, 1));
+  }
+  return cache[radius];
+}
+
+static const InfluenceKernel &allyKernel() {
+  static const InfluenceKernel kernel =
+      InfluenceKernel::squareFalloff(ALLY_DENSITY_RADIUS);
+  return kernel;
+}
+
+static const InfluenceKernel &playerKernel(int radius) {
+  static std::vector<InfluenceKernel> cache;
+  radius = std::max(0, std::min(radius, MAX_KERNEL_RADIUS));
+  if (cache.empty()) {
+    for (int r = 0; r <= MAX_KERNEL_RADIUS; ++r)
+      cache.push_back(InfluenceKernel::diamondFalloff(r));
+  }
+  return cache[radius];
+}
+
+// Tiles an enemy can hit next turn: its ranged range if it has one, else
+// the eight tiles around it.
+static int enemyThreatRadius(const Enemy &enemy) {
+  const EnemyArchetype &arch = enemy.archetype();
+  return arch.rangedAttackRange > 0 ? arch.rangedAttackRange : 1;
+}
+
+static int playerThreatRadius(const PlayerCharacter &player) {
+  int radius = 0;
+  for (const Spell &spell : player.knownSpells) {
+    if (spell.targetType != SpellTargetType::Self)
+      radius = std::max(radius, spell.range);
+  }
+  return radius;
+}
+
+static void stampEnemy(GameData &gameData, const Enemy &enemy, int x, int y,
+                       int sign) {
+  gameData.enemyThreat.stamp(x, y, threatKernel(enemyThreatRadius(enemy)),
+                             sign);
+  gameData.allyDensity.stamp(x, y, allyKernel(), sign);
+}
+
+void resetInfluenceMaps(GameData &gameData) {
+  const int w = gameData.currentLevel.width;
+  const int h = gameData.currentLevel.height;
+  gameData.enemyThreat.reset(w, h);
+  gameData.allyDensity.reset(w, h);
+  gameData.playerThreat.reset(w, h);
+  gameData.playerInfluenceX = -1;
+  gameData.playerInfluenceY = -1;
+  gameData.playerInfluenceRadius = 0;
+  for (auto &enemy : gameData.enemies) {
+    enemy.influenceX = -1;
+    enemy.influenceY = -1;
+  }
+}
+
+void forgetEnemyInfluence(GameData &gameData, const Enemy &enemy) {
+  if (enemy.influenceX < 0)
+    return;
+  stampEnemy(gameData, enemy, enemy.influenceX, enemy.influenceY, -1);
+}
+
+void updateInfluenceMaps(GameData &gameData) {
+  if (gameData.enemyThreat.getWidth() != gameData.currentLevel.width ||
+      gameData.enemyThreat.getHeight() != gameData.currentLevel.height) {
+    resetInfluenceMaps(gameData);
+  }
+
+  int restamped = 0;
+  for (auto &enemy : gameData.enemies) {
+    // An enemy mid-move already holds its target tile
+    int x = enemy.isMoving ? enemy.targetTileX : enemy.x;
+    int y = enemy.isMoving ? enemy.targetTileY : enemy.y;
+    bool alive = enemy.health > 0;
+    if (alive && enemy.influenceX == x && enemy.influenceY == y)
+      continue;
+    forgetEnemyInfluence(gameData, enemy);
+    enemy.influenceX = -1;
+    enemy.influenceY = -1;
+    if (alive) {
+      stampEnemy(gameData, enemy, x, y, +1);
+      enemy.influenceX = x;
+      enemy.influenceY = y;
+    }
+    restamped++;
+  }
+
+  const PlayerCharacter &player = gameData.currentGamePlayer;
+  int radius = playerThreatRadius(player);
+  if (player.targetTileX != gameData.playerInfluenceX ||
+      player.targetTileY != gameData.playerInfluenceY ||
+      radius != gameData.playerInfluenceRadius) {
+    if (gameData.playerInfluenceX >= 0) {
+      gameData.playerThreat.stamp(gameData.playerInfluenceX,
+                                  gameData.playerInfluenceY,
+                                  playerKernel(gameData.playerInfluenceRadius),
+                                  -1);
+    }
+    gameData.playerThreat.stamp(player.targetTileX, player.targetTileY,
+                                playerKernel(radius), +1);
+    gameData.playerInfluenceX = player.targetTileX;
+    gameData.playerInfluenceY = player.targetTileY;
+    gameData.playerInfluenceRadius = radius;
+    restamped++;
+  }
+
+  if (restamped > 0) {
+    SDL_Log("Influence maps: restamped %d movers.", restamped);
+  }
+}
@@ -0,0 +1,64 @@
+// src/influence_map.h
+#ifndef INFLUENCE_MAP_H
+#define INFLUENCE_MAP_H
+
+#include <vector>
+
+// Forward declarations
+struct GameData;
+class Enemy;
+
+// Radius of the allyDensity kernel; its centre weighs ALLY_DENSITY_RADIUS + 1
+const int ALLY_DENSITY_RADIUS = 2;
+
+// --- Influence Kernel ---
+// A precomputed square of integer weights centred on a tile. Integer weights
+// mean stamping and unstamping cancel exactly, so maps never drift.
+struct InfluenceKernel {
+  int radius = 0;
+  std::vector<int> weights; // (2 * radius + 1)^2, row-major
+
+  // Every tile within Chebyshev `radius` weighs `weight`.
+  static InfluenceKernel flatSquare(int radius, int weight);
+  // Tiles within Manhattan `radius`, weighing radius + 1 - distance.
+  static InfluenceKernel diamondFalloff(int radius);
+  // Tiles within Chebyshev `radius`, weighing radius + 1 - distance.
+  static InfluenceKernel squareFalloff(int radius);
+};
+
+// --- Influence Map ---
+// A grid of summed kernel stamps. Moving an entity is an unstamp at its old
+// tile and a stamp at its new one, so cost follows movers, not map size.
+class InfluenceMap {
+public:
+  void reset(int width, int height);
+  // sign = +1 to add the kernel around (x, y), -1 to remove it again.
+  void stamp(int x, int y, const InfluenceKernel &kernel, int sign);
+  int at(int x, int y) const; // 0 off the map
+
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+
+private:
+  int width = 0;
+  int height = 0;
+  std::vector<int> values;
+};
+
+// --- Tactical maps kept in GameData ---
+//   enemyThreat  - how many enemies can attack each tile next turn (melee
+//                  reach or ranged range, from the enemy's archetype).
+//   allyDensity  - enemy crowding, falling off over two tiles.
+//   playerThreat - how exposed each tile is to the player's spells, highest
+//                  next to the player and fading out to their longest range.
+// Every enemy and the player remember the tile they were last stamped at;
+// updateInfluenceMaps only restamps those that moved, joined or died.
+
+// Clears all three maps for a new level. Call after the level's enemies are in.
+void resetInfluenceMaps(GameData &gameData);
+// Restamps movers. Main thread only (planning workers read the maps).
+void updateInfluenceMaps(GameData &gameData);
+// Removes an enemy's stamps; call before erasing it from gameData.enemies.
+void forgetEnemyInfluence(GameData &gameData, const Enemy &enemy);
+
+#endif // INFLUENCE_MAP_H
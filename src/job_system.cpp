@@ -0,0 +1,224 @@
+// src/job_system.cpp
+#include "job_system.h"
+#include <SDL.h>
+#include <algorithm>
+
+// Extra chunks per thread in parallelFor, so a thread that finishes early
+// has something left to steal.
+static const size_t CHUNKS_PER_THREAD = 4;
+
+struct Job {
+  JobSystem::JobFunction function;
+  JobCounter *counter = nullptr;
+  // Counters in `after` still running, plus one held by submit() itself
+  // until it has registered with all of them.
+  std::atomic<int> unmetDependencies{1};
+};
+
+// Which deque the current thread owns. Threads that aren't workers of the
+// pool (the main thread) share deque 0.
+static thread_local const JobSystem *currentPool = nullptr;
+static thread_local unsigned int currentQueue = 0;
+
+unsigned int defaultJobThreadCount() {
+  unsigned int hardwareThreads = std::thread::hardware_concurrency();
+  return hardwareThreads > 0 ? hardwareThreads : 1; // 0 means "unknown"
+}
+
+JobSystem::~JobSystem() { stop(); }
+
+void JobSystem::start(unsigned int requestedThreads) {
+  stop();
+  threadCount =
+      requestedThreads > 0 ? requestedThreads : defaultJobThreadCount();
+  queues.clear();
+  for (unsigned int i = 0; i < threadCount; ++i) {
+    queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+  }
+  stopping.store(false);
+  for (unsigned int i = 1; i < threadCount; ++i) {
+    workers.emplace_back(&JobSystem::workerLoop, this, i);
+  }
+  SDL_Log("Job system started with %u thread(s)%s.", threadCount,
+          threadCount <= 1 ? " (single-threaded)" : "");
+}
+
+void JobSystem::stop() {
+  if (queues.empty())
+    return;
+  // Finish what was queued so no counter is left waiting forever
+  while (Job *job = takeJob()) {
+    runJob(job);
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    stopping.store(true);
+  }
+  wakeWorkers.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  workers.clear();
+  queues.clear();
+}
+
+void JobSystem::submit(JobFunction function, JobCounter *counter,
+                       std::initializer_list<JobCounter *> after) {
+  Job *job = new Job();
+  job->function = std::move(function);
+  job->counter = counter;
+  if (counter != nullptr)
+    counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+  job->unmetDependencies.fetch_add(static_cast<int>(after.size()));
+  for (JobCounter *dependency : after) {
+    bool parked = false;
+    if (dependency != nullptr) {
+      std::lock_guard<std::mutex> lock(dependency->waitersMutex);
+      if (!dependency->isDone()) {
+        dependency->waiters.push_back(job);
+        parked = true;
+      }
+    }
+    if (!parked)
+      job->unmetDependencies.fetch_sub(1);
+  }
+  // Drop submit()'s own hold; whoever takes the count to zero queues the job
+  if (job->unmetDependencies.fetch_sub(1) == 1)
+    enqueue(job);
+}
+
+void JobSystem::wait(JobCounter &counter) {
+  while (!counter.isDone()) {
+    if (Job *job = takeJob()) {
+      runJob(job);
+    } else {
+      std::this_thread::yield(); // Remaining jobs are running elsewhere
+    }
+  }
+  // The last job may still be inside finishCounter; let it leave first
+  std::lock_guard<std::mutex> lock(counter.waitersMutex);
+}
+
+bool JobSystem::tryRunJob() {
+  Job *job = takeJob();
+  if (!job)
+    return false;
+  runJob(job);
+  return true;
+}
+
+void JobSystem::parallelFor(size_t begin, size_t end, size_t grain,
+                            const RangeFunction &function) {
+  if (begin >= end)
+    return;
+  size_t count = end - begin;
+  grain = std::max<size_t>(1, grain);
+  size_t chunks = std::min((count + grain - 1) / grain,
+                           static_cast<size_t>(threadCount) * CHUNKS_PER_THREAD);
+  if (chunks <= 1 || isSingleThreaded() || queues.empty()) {
+    function(begin, end);
+    return;
+  }
+
+  size_t chunkSize = (count + chunks - 1) / chunks;
+  JobCounter done;
+  for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += chunkSize) {
+    size_t chunkEnd = std::min(end, chunkBegin + chunkSize);
+    submit([&function, chunkBegin, chunkEnd]() {
+      function(chunkBegin, chunkEnd);
+    }, &done);
+  }
+  wait(done);
+}
+
+void JobSystem::enqueue(Job *job) {
+  if (queues.empty()) {
+    // Not started: nobody would ever run it, so run it now
+    runJob(job);
+    return;
+  }
+  unsigned int index = currentPool == this ? currentQueue : 0;
+  {
+    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+    queues[index]->jobs.push_back(job);
+  }
+  queuedJobs.fetch_add(1);
+  if (!workers.empty()) {
+    // Take the sleep lock so a worker between its check and its wait
+    // can't miss the notify
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wakeWorkers.notify_one();
+  }
+}
+
+Job *JobSystem::takeJob() {
+  const size_t queueCount = queues.size();
+  if (queueCount == 0)
+    return nullptr;
+  unsigned int own = currentPool == this ? currentQueue : 0;
+
+  // Newest of our own first...
+  {
+    WorkerQueue &queue = *queues[own];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      Job *job = queue.jobs.back();
+      queue.jobs.pop_back();
+      queuedJobs.fetch_sub(1);
+      return job;
+    }
+  }
+  // ...then the oldest of someone else's
+  for (size_t offset = 1; offset < queueCount; ++offset) {
+    WorkerQueue &victim = *queues[(own + offset) % queueCount];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.jobs.empty()) {
+      Job *job = victim.jobs.front();
+      victim.jobs.pop_front();
+      queuedJobs.fetch_sub(1);
+      return job;
+    }
+  }
+  return nullptr;
+}
+
+void JobSystem::runJob(Job *job) {
+  job->function();
+  if (job->counter != nullptr)
+    finishCounter(*job->counter);
+  delete job;
+}
+
+void JobSystem::finishCounter(JobCounter &counter) {
+  // Decrement under the lock: wait() takes the same lock before returning,
+  // so the counter can't be destroyed while this still holds it.
+  std::vector<Job *> released;
+  {
+    std::lock_guard<std::mutex> lock(counter.waitersMutex);
+    if (counter.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      released.swap(counter.waiters); // Last one out releases the waiters
+    }
+  }
+  for (Job *job : released) {
+    if (job->unmetDependencies.fetch_sub(1) == 1)
+      enqueue(job);
+  }
+}
+
+void JobSystem::workerLoop(unsigned int index) {
+  currentPool = this;
+  currentQueue = index;
+  while (true) {
+    if (Job *job = takeJob()) {
+      runJob(job);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    wakeWorkers.wait(lock, [this]() {
+      return stopping.load() || queuedJobs.load() > 0;
+    });
+    if (stopping.load() && queuedJobs.load() == 0)
+      break;
+  }
+}
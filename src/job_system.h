@@ -0,0 +1,117 @@
+// src/job_system.h
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct Job; // Internal to job_system.cpp
+
+// --- Job Counter ---
+// Counts unfinished jobs. Submitting a job against a counter adds one;
+// the job finishing takes it away. Wait on a counter to join everything
+// submitted to it. Other jobs can be held back until a counter reaches zero,
+// which is how task graphs are built.
+// Don't submit more work against a counter that other jobs are still
+// waiting on; use a fresh one per stage. Only destroy a counter after
+// JobSystem::wait() has returned for it.
+class JobCounter {
+public:
+  JobCounter() = default;
+  JobCounter(const JobCounter &) = delete;
+  JobCounter &operator=(const JobCounter &) = delete;
+
+  bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+  friend class JobSystem;
+  std::atomic<int> pending{0};
+  std::mutex waitersMutex;
+  std::vector<Job *> waiters; // Jobs held back until this reaches zero
+};
+
+// --- Job System ---
+// A fixed pool of worker threads, each with its own deque of jobs. A thread
+// pushes and pops its own jobs at the back (the most recent work is still
+// in cache) and steals from the front of someone else's deque when its own
+// is empty. Threads that aren't workers (the main thread) use deque 0.
+//
+// wait() never blocks while there is work: the waiting thread runs queued
+// jobs itself until the counter reaches zero, so waiting from inside a job
+// cannot deadlock the pool.
+//
+// With one thread there are no workers at all and every job runs on the
+// thread that waits for it, in a fixed order. Use that (--single-thread)
+// when a bug needs to be reproduced deterministically.
+class JobSystem {
+public:
+  using JobFunction = std::function<void()>;
+  using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+  JobSystem() = default;
+  ~JobSystem();
+  JobSystem(const JobSystem &) = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+
+  // threadCount counts the calling thread: 0 = one per hardware thread,
+  // 1 = single-threaded. Restarting stops the old pool first.
+  void start(unsigned int threadCount);
+  // Runs anything still queued, then joins the workers.
+  void stop();
+
+  unsigned int getThreadCount() const { return threadCount; }
+  bool isSingleThreaded() const { return threadCount <= 1; }
+
+  // Queues `function`. If `counter` is set it counts the job until it
+  // finishes. The job doesn't start until every counter in `after` is done.
+  void submit(JobFunction function, JobCounter *counter = nullptr,
+              std::initializer_list<JobCounter *> after = {});
+
+  // Runs queued jobs on this thread until `counter` is done.
+  void wait(JobCounter &counter);
+  // Runs one queued job on this thread, if there is one. For a thread that
+  // must keep doing something else (the main thread drawing a loading
+  // screen) but should still help, and make progress when single-threaded.
+  bool tryRunJob();
+
+  // Splits [begin, end) into chunks of at least `grain` indices and calls
+  // function(chunkBegin, chunkEnd) for each across the pool. The calling
+  // thread helps; returns once every chunk has run. Chunks are contiguous
+  // and never overlap, so writing only to your own indices is safe.
+  void parallelFor(size_t begin, size_t end, size_t grain,
+                   const RangeFunction &function);
+
+private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Job *> jobs;
+  };
+
+  void enqueue(Job *job);
+  Job *takeJob(); // Own deque first, then steal. nullptr if all are empty.
+  void runJob(Job *job);
+  void finishCounter(JobCounter &counter);
+  void workerLoop(unsigned int index);
+
+  unsigned int threadCount = 1;
+  std::vector<std::unique_ptr<WorkerQueue>> queues; // [0] = non-worker threads
+  std::vector<std::thread> workers;
+
+  std::atomic<int> queuedJobs{0}; // Ready jobs sitting in any deque
+  std::atomic<bool> stopping{false};
+  std::mutex sleepMutex;
+  std::condition_variable wakeWorkers;
+};
+
+// Number of threads start(0) picks.
+unsigned int defaultJobThreadCount();
+
+#endif // JOB_SYSTEM_H
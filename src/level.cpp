@@ -21,7 +21,7 @@ int manhattanDistance(const SDL_Rect& room1, const SDL_Rect& room2) {
 }
 
 
-Level generateLevel(int width, int height, int maxRooms, int minRoomSize, int maxRoomSize, std::vector<Enemy>& enemies, int tileW, int tileH,
+Level generateLevel(int width, int height, int maxRooms, int minRoomSize, int maxRoomSize, EnemyStore& enemies,
     std::optional<SDL_Point>& outPedestalPos) {
     Level level;
     level.width = width;
@@ -320,7 +320,7 @@ Level generateLevel(int width, int height, int maxRooms, int minRoomSize, int ma
             if (!occupied) {
                 // *** MODIFIED: Assign unique ID using static member ***
                 int newId = Enemy::getNextId(); // Get next ID using the public static method
-                enemies.emplace_back(newId, EnemyType::SLIME, spawnX, spawnY, tileW, tileH);
+                enemies.emplace_back(newId, pickEnemySpawnType(rand()), spawnX, spawnY);
                 // *****************************************************
                 spawnedCount++;
             }
@@ -4,7 +4,7 @@
 #include <vector>
 #include <string>
 #include <SDL.h>
-#include "enemy.h" // Make sure this is included if Enemy is used in Level
+#include "enemy_store.h" // For EnemyStore (generateLevel spawns into it)
 #include <optional> // For std::optional
 
 struct Level {
@@ -22,7 +22,7 @@ struct Level {
 int manhattanDistance(const SDL_Rect& room1, const SDL_Rect& room2);
 
 // Declaration of the generateLevel function (CRITICAL UPDATE HERE)
-Level generateLevel(int width, int height, int maxRooms, int minRoomSize, int maxRoomSize, std::vector<Enemy>& enemies, int tileW, int tileH,
+Level generateLevel(int width, int height, int maxRooms, int minRoomSize, int maxRoomSize, EnemyStore& enemies,
     std::optional<SDL_Point>& outPedestalPos);
 
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <algorithm> // For std::remove_if, std::max, std::min
 #include <cmath>     // For std::abs
 #include <cstdlib>   // For rand() and srand()
+#include <cstring>   // For strcmp()
 #include <ctime>     // For time()
 #include <memory>    // For std::make_unique if needed (not currently used)
 #include <string>    // For std::string
@@ -12,14 +13,31 @@
 #include <SDL_ttf.h>
 
 // Include project headers
+#include "asset_archive.h"    // For the packed, memory-mapped assets
+#include "asset_loader.h"     // For parallel image decoding at startup
 #include "asset_manager.h"    // Include AssetManager header
+#include "asset_residency.h"  // For loading asset groups on demand
+#include "asset_watcher.h"    // For --hot-reload
 #include "character.h"        // Includes PlayerCharacter definition
 #include "character_select.h" // For character selection screen function
+#include "decals.h"           // For scorch marks, blood and remains
 #include "enemy.h"            // Includes Enemy definition and planAction
+#include "enemy_activity.h"   // For enemy activity tiers and noise wake-ups
+#include "enemy_ai.h"         // For the per-turn AI inputs
+#include "enemy_archetype.h"  // For each floor's asset groups
+#include "enemy_planning.h"   // For the parallel enemy planning pipeline
+#include "enemy_slot_map.h"   // For findEnemy / syncEnemySlots
+#include "enemy_squad.h"      // For squad slot assignment
 #include "game_data.h" // Includes TurnPhase, IntendedAction, GameData struct etc.
+#include "influence_map.h" // For threat / ally density maps
+#include "job_system.h" // For the worker thread pool
 #include "level.h"     // For Level struct and generateLevel function
 #include "menu.h"      // For main menu function
 #include "projectile.h" // For Projectile struct
+#include "render_queue.h"  // For sorted world draw commands
+#include "spatial_grid.h"  // For culling dynamic objects to the camera
+#include "sprite_batcher.h" // For batched world sprites
+#include "turn_scheduler.h" // For the energy-based enemy scheduler
 #include "ui.h"         // For rendering UI elements
 #include "utils.h"      // Includes SDL_Context, helper functions
 #include "visibility.h" // For updateVisibility function
@@ -36,9 +54,12 @@
 void handleEvents(GameData &gameData, AssetManager &assets, bool &running,
                   SDL_Context &context);
 void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime);
+// Generates floor gameData.currentLevelIndex and resets everything tied to
+// the old one. The caller clears the old floor's enemies and projectiles.
+void setUpFloor(GameData &gameData, AssetManager &assets);
 void renderScene(GameData &gameData, AssetManager &assets);
 // Helper function for checking action resolution completion
-bool isResolutionComplete(const GameData &gameData);
+TaskStatus resolveTurn(GameData &gameData, float deltaTime);
 
 // --- Global Application State (Temporary) ---
 // IMPORTANT: Replace this global with proper state management (pass AppState or
@@ -51,6 +72,18 @@ AppState currentAppState = AppState::MainMenu;
 int main(int argc, char *argv[]) {
   srand(static_cast<unsigned int>(time(0)));
   GameData gameData;
+  bool dumpAtlas = false;
+  bool hotReload = false;
+  for (int arg = 1; arg < argc; ++arg) {
+    if (strcmp(argv[arg], "--single-thread") == 0) {
+      gameData.jobThreads = 1; // Every job on the main thread, in a fixed order
+    } else if (strcmp(argv[arg], "--dump-atlas") == 0) {
+      dumpAtlas = true; // Write the packed atlas pages and frame index
+    } else if (strcmp(argv[arg], "--hot-reload") == 0) {
+      hotReload = true; // Reload loose asset files when they're saved
+    }
+  }
+  gameData.jobs.start(static_cast<unsigned int>(std::max(0, gameData.jobThreads)));
   SDL_Context sdlContext =
       initializeSDL(gameData.windowWidth, gameData.windowHeight);
   if (!sdlContext.window || !sdlContext.renderer) {
@@ -69,6 +102,8 @@ int main(int argc, char *argv[]) {
 
   gameData.renderer = sdlContext.renderer;
   {
+    // Declared first so it outlives the fonts, which read from it lazily
+    AssetArchive assetArchive;
     AssetManager assetManager(
         gameData.renderer); // Create AssetManager instance
 
@@ -76,228 +111,97 @@ int main(int argc, char *argv[]) {
     // Player initialized in GameData constructor
 
     // --- Load Assets ---
-    bool loadSuccess = true;
-    loadSuccess &=
-        assetManager.loadTexture("splash", "../assets/splash/splash.png");
-    loadSuccess &= assetManager.loadTexture("start_tile",
-                                            "../assets/sprites/start_tile.png");
-    loadSuccess &= assetManager.loadTexture("exit_tile",
-                                            "../assets/sprites/exit_tile.png");
-    loadSuccess &= assetManager.loadTexture(
-        "reticle", "../assets/sprites/target_reticle.png");
-    loadSuccess &=
-        assetManager.loadTexture("fireball", "../assets/sprites/fireball.PNG");
-    loadSuccess &= assetManager.loadTexture(
-        "fireball_icon", "../assets/sprites/fireball_icon.PNG");
-    loadSuccess &= assetManager.loadTexture(
-        "minor_heal_icon", "../assets/sprites/minor_heal_icon.PNG");
-    loadSuccess &= assetManager.loadTexture("wall_texture",
-                                            "../assets/sprites/wall_1.PNG");
-    loadSuccess &=
-        assetManager.loadTexture("floor_1", "../assets/sprites/floor_1.PNG");
-    loadSuccess &=
-        assetManager.loadTexture("floor_2", "../assets/sprites/floor_2.PNG");
-    loadSuccess &=
-        assetManager.loadFont("main_font", "../assets/fonts/LUMOS.TTF", 36);
-    loadSuccess &=
-        assetManager.loadFont("spellbar_font", "../assets/fonts/LUMOS.TTF", 18);
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_portrait", "../assets/sprites/female_mage_portrait.PNG");
-    loadSuccess &= assetManager.loadTexture(
-        "male_mage_portrait", "../assets/sprites/male_mage_portrait.PNG");
-    loadSuccess &= assetManager.loadTexture("slime_texture",
-                                            "../assets/sprites/slime.PNG");
-    // Idle animation frames
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_idle_1", "../assets/sprites/animations/female_mage/idle/"
-                              "female_mage_idle_0001.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_idle_2", "../assets/sprites/animations/female_mage/idle/"
-                              "female_mage_idle_0002.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_idle_3", "../assets/sprites/animations/female_mage/idle/"
-                              "female_mage_idle_0003.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_idle_4", "../assets/sprites/animations/female_mage/idle/"
-                              "female_mage_idle_0004.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_idle_5", "../assets/sprites/animations/female_mage/idle/"
-                              "female_mage_idle_0005.png");
-
-    // --- ADDED: Load Walking Animation Frames ---
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_walk_1",
-        "../assets/sprites/animations/female_mage/walk/" // Ensure path is
-                                                         // correct
-        "female_mage_walk_0001.png");                    // Example filename
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_walk_2", "../assets/sprites/animations/female_mage/walk/"
-                              "female_mage_walk_0002.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_walk_3", "../assets/sprites/animations/female_mage/walk/"
-                              "female_mage_walk_0003.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_walk_4", "../assets/sprites/animations/female_mage/walk/"
-                              "female_mage_walk_0004.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_walk_5", "../assets/sprites/animations/female_mage/walk/"
-                              "female_mage_walk_0005.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_walk_6", "../assets/sprites/animations/female_mage/walk/"
-                              "female_mage_walk_0006.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_walk_7", "../assets/sprites/animations/female_mage/walk/"
-                              "female_mage_walk_0007.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_walk_8", "../assets/sprites/animations/female_mage/walk/"
-                              "female_mage_walk_0008.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_walk_9", "../assets/sprites/animations/female_mage/walk/"
-                              "female_mage_walk_0009.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_walk_10", "../assets/sprites/animations/female_mage/walk/"
-                               "female_mage_walk_0010.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_walk_11", "../assets/sprites/animations/female_mage/walk/"
-                               "female_mage_walk_0011.png");
-
-    // --- END Load Walking Animation Frames ---
-
-    // --- ADDED: Load Targeting Animation Frames ---
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_target_1",
-        "../assets/sprites/animations/female_mage/targetting/" // Ensure path is
-                                                               // correct
-        "female_mage_targetting_0001.png"); // Example filename
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_target_2",
-        "../assets/sprites/animations/female_mage/targetting/"
-        "female_mage_targetting_0002.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_target_3",
-        "../assets/sprites/animations/female_mage/targetting/"
-        "female_mage_targetting_0003.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_target_4",
-        "../assets/sprites/animations/female_mage/targetting/"
-        "female_mage_targetting_0004.png");
-    loadSuccess &= assetManager.loadTexture(
-        "female_mage_target_5",
-        "../assets/sprites/animations/female_mage/targetting/"
-        "female_mage_targetting_0005.png");
-    // --- END Load Targeting Animation Frames ---
-
-    // Load slime idle animation assests
-    loadSuccess &= assetManager.loadTexture(
-        "slime_idle_1", "../assets/sprites/animations/enemies/slime/idle/"
-                        "slime_idle_0001.png"); // Example path/name
-    loadSuccess &= assetManager.loadTexture(
-        "slime_idle_2",
-        "../assets/sprites/animations/enemies/slime/idle/slime_idle_0002.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_idle_3",
-        "../assets/sprites/animations/enemies/slime/idle/slime_idle_0003.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_idle_4",
-        "../assets/sprites/animations/enemies/slime/idle/slime_idle_0004.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_idle_5",
-        "../assets/sprites/animations/enemies/slime/idle/slime_idle_0005.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_idle_6",
-        "../assets/sprites/animations/enemies/slime/idle/slime_idle_0006.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_idle_7",
-        "../assets/sprites/animations/enemies/slime/idle/slime_idle_0007.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_idle_8",
-        "../assets/sprites/animations/enemies/slime/idle/slime_idle_0008.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_idle_9",
-        "../assets/sprites/animations/enemies/slime/idle/slime_idle_0009.png");
-
-    // Load slime walk animation assets
-    loadSuccess &= assetManager.loadTexture(
-        "slime_walk_1", "../assets/sprites/animations/enemies/slime/walk/"
-                        "slime_walk_0001.png"); // Example path/name
-    loadSuccess &= assetManager.loadTexture(
-        "slime_walk_2",
-        "../assets/sprites/animations/enemies/slime/walk/slime_walk_0002.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_walk_3",
-        "../assets/sprites/animations/enemies/slime/walk/slime_walk_0003.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_walk_4",
-        "../assets/sprites/animations/enemies/slime/walk/slime_walk_0004.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_walk_5",
-        "../assets/sprites/animations/enemies/slime/walk/slime_walk_0005.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_walk_6",
-        "../assets/sprites/animations/enemies/slime/walk/slime_walk_0006.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_walk_7",
-        "../assets/sprites/animations/enemies/slime/walk/slime_walk_0007.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_walk_8",
-        "../assets/sprites/animations/enemies/slime/walk/slime_walk_0008.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_walk_9",
-        "../assets/sprites/animations/enemies/slime/walk/slime_walk_0009.png");
-
-    // Load slime attack animation assets
-    loadSuccess &= assetManager.loadTexture(
-        "slime_attack_1", "../assets/sprites/animations/enemies/slime/attack/"
-                          "slime_attack_0001.png"); // Example path/name
-    loadSuccess &= assetManager.loadTexture(
-        "slime_attack_2", "../assets/sprites/animations/enemies/slime/attack/"
-                          "slime_attack_0002.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_attack_3", "../assets/sprites/animations/enemies/slime/attack/"
-                          "slime_attack_0003.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_attack_4", "../assets/sprites/animations/enemies/slime/attack/"
-                          "slime_attack_0004.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_attack_5", "../assets/sprites/animations/enemies/slime/attack/"
-                          "slime_attack_0005.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_attack_6", "../assets/sprites/animations/enemies/slime/attack/"
-                          "slime_attack_0006.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_attack_7", "../assets/sprites/animations/enemies/slime/attack/"
-                          "slime_attack_0007.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_attack_8", "../assets/sprites/animations/enemies/slime/attack/"
-                          "slime_attack_0008.png");
-    loadSuccess &= assetManager.loadTexture(
-        "slime_attack_9", "../assets/sprites/animations/enemies/slime/attack/"
-                          "slime_attack_0009.png");
-
-    // Load Crystal Textures ***
-    //  Replace paths with your actual crystal image files
-    loadSuccess &= assetManager.loadTexture(
-        "health_crystal_texture",
-        "../assets/sprites/health_crystal.png"); // Example path
-    loadSuccess &= assetManager.loadTexture(
-        "mana_crystal_texture",
-        "../assets/sprites/mana_crystal.png"); // Example path
-
-    // *** NEW: Load Rune Pedestal Animation Frames ***
-    for (int i = 1; i <= 10; ++i) {
-      std::string key = "rune_pedestal_" + std::to_string(i);
-      // Adjust path and filename pattern as needed
-      std::string path = "../assets/sprites/animations/environment/"
-                         "rune_pedestal/rune_pedestal_" +
-                         std::to_string(i) + ".png";
-      loadSuccess &= assetManager.loadTexture(key, path);
-      if (!loadSuccess) {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                    "Failed to load pedestal frame: %s", path.c_str());
-        // Decide if you want to break or just log if a frame fails
+    // What to load is data: assets/manifest.txt, or the index of the
+    // assets.pak packed from it (the pack_assets build target) when one sits
+    // next to the executable. The splash and fonts load right away so the
+    // splash can show progress; every image after them is decoded in
+    // parallel by the AssetLoader, straight out of the mapped archive.
+    const std::string looseAssetRoot = "../assets/";
+    std::string archivePath = "assets.pak";
+    if (char *basePath = SDL_GetBasePath()) {
+      archivePath = std::string(basePath) + archivePath;
+      SDL_free(basePath);
+    }
+    if (hotReload)
+      archivePath.clear(); // Hot reload watches the loose files
+    std::vector<AssetManifestEntry> assetList;
+    bool loadSuccess =
+        openAssetSources(assetArchive, archivePath,
+                         looseAssetRoot + "manifest.txt", assetList);
+    auto openAsset = [&](const AssetManifestEntry &entry) {
+      return assetArchive.isOpen()
+                 ? assetArchive.openEntry(entry)
+                 : SDL_RWFromFile((looseAssetRoot + entry.path).c_str(), "rb");
+    };
+    auto loadsUpFront = [](const AssetManifestEntry &entry) {
+      return entry.kind == AssetKind::Font || entry.name == "splash";
+    };
+    for (const AssetManifestEntry &entry : assetList) {
+      if (entry.kind == AssetKind::Font)
+        loadSuccess &= assetManager.loadFont(entry.name, openAsset(entry),
+                                             entry.fontSize, entry.path);
+      else if (loadsUpFront(entry))
+        loadSuccess &=
+            assetManager.loadTexture(entry.name, openAsset(entry), entry.path);
+    }
+    SDL_Texture *splashTex = assetManager.getTexture("splash");
+    if (splashTex)
+      SDL_SetTextureBlendMode(splashTex, SDL_BLENDMODE_BLEND);
+
+    // Grouped entries wait until something asks for them
+    AssetResidency assetResidency(assetManager, gameData.jobs, assetArchive,
+                                  looseAssetRoot);
+    assetResidency.setBudget(static_cast<size_t>(
+        std::max(0, gameData.assetBudgetMB)) * 1024 * 1024);
+
+    AssetLoader loader(assetManager, gameData.jobs);
+    for (const AssetManifestEntry &entry : assetList) {
+      if (loadsUpFront(entry))
+        continue;
+      if (!entry.group.empty()) {
+        assetResidency.addEntry(entry);
+        continue;
+      }
+      bool isSprite = entry.kind == AssetKind::Sprite;
+      if (assetArchive.isOpen()) {
+        const void *bytes = assetArchive.data(entry);
+        size_t size = static_cast<size_t>(entry.size);
+        if (isSprite)
+          loader.queueSprite(entry.name, bytes, size, entry.path);
+        else
+          loader.queueTexture(entry.name, bytes, size, entry.path);
+      } else if (isSprite) {
+        loader.queueSprite(entry.name, looseAssetRoot + entry.path);
+      } else {
+        loader.queueTexture(entry.name, looseAssetRoot + entry.path);
       }
     }
 
+    // Decode everything queued above, drawing progress over the splash
+    Uint32 loadStart = SDL_GetTicks();
+    loader.start();
+    while (!loader.pump()) {
+      SDL_Event event;
+      while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_QUIT)
+          currentAppState = AppState::Quitting;
+      }
+      if (currentAppState == AppState::Quitting)
+        break;
+      displayLoadingScreen(gameData.renderer, splashTex, loader.progress(),
+                           gameData.windowWidth, gameData.windowHeight);
+    }
+    loadSuccess &= loader.succeeded();
+    SDL_Log("Loaded assets in %u ms.", SDL_GetTicks() - loadStart);
+
+    // Generated rather than loaded: the blob every floor decal is drawn with
+    loadSuccess &=
+        assetManager.addSprite(DECAL_SPRITE_NAME, createDecalSurface(64));
+
+    // Pack every sprite loaded above into atlas pages
+    loadSuccess &= assetManager.buildAtlas(dumpAtlas ? "atlas" : "");
+    assetManager.setResidency(&assetResidency);
+
     if (!loadSuccess) {
       SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                    "Asset loading failed!"); /* Handle error */
@@ -305,9 +209,15 @@ int main(int argc, char *argv[]) {
     SDL_Texture *reticleTex = assetManager.getTexture("reticle");
     if (reticleTex)
       SDL_SetTextureBlendMode(reticleTex, SDL_BLENDMODE_BLEND);
-    SDL_Texture *splashTex = assetManager.getTexture("splash");
-    if (splashTex)
-      SDL_SetTextureBlendMode(splashTex, SDL_BLENDMODE_BLEND);
+
+    AssetWatcher assetWatcher(assetManager, gameData.jobs);
+    if (hotReload)
+      assetWatcher.start(looseAssetRoot, assetList);
+
+    // --- Enemy Archetypes (shared per-type data, built once) ---
+    buildEnemyArchetypes(gameData.tileWidth, gameData.tileHeight);
+    // Room for a full level plus reinforcements, so spawning never reallocates
+    gameData.enemies.reserve(gameData.maxEnemyCount);
 
     bool running = true;
     Uint32 lastFrameTime = SDL_GetTicks();
@@ -336,6 +246,11 @@ int main(int argc, char *argv[]) {
       }
       // ---
 
+      // Edited sprites may already be baked into terrain chunks
+      if (assetWatcher.poll() > 0)
+        gameData.terrainCache.invalidateAll();
+      assetResidency.update();
+
       handleEvents(gameData, assetManager, running, sdlContext);
       if (!running) {
         currentAppState = AppState::Quitting;
@@ -389,6 +304,8 @@ int main(int argc, char *argv[]) {
       case AppState::CharacterSelect:
         displayCharacterSelect(
             gameData.renderer, assetManager.getFont("main_font"),
+            assetManager.getTexture("female_mage"),
+            assetManager.getTexture("male_mage"),
             gameData.selectedCharacterIndex, gameData.windowWidth,
             gameData.windowHeight, gameData.characterSelectAlpha);
         break;
@@ -402,6 +319,8 @@ int main(int argc, char *argv[]) {
       SDL_Delay(1);
     } // End Main Application Loop
   }
+  // Cached render targets belong to the renderer about to be destroyed
+  gameData.terrainCache.releaseTextures();
   cleanupSDL(sdlContext);
   SDL_Log("Exiting gracefully. Farewell, Mortal.");
   return 0;
@@ -428,6 +347,11 @@ void handleEvents(GameData &gameData, AssetManager &assets, bool &running,
       SDL_RenderSetLogicalSize(gameData.renderer, gameData.windowWidth,
                                gameData.windowHeight);
       // Need to consider how this affects camera, UI scaling etc.
+    } else if (event.type == SDL_RENDER_TARGETS_RESET) {
+      // Cached terrain chunks lost their contents; redraw them on demand
+      gameData.terrainCache.invalidateAll();
+    } else if (event.type == SDL_RENDER_DEVICE_RESET) {
+      gameData.terrainCache.releaseTextures();
     }
 
     switch (currentAppState) {
@@ -485,95 +409,14 @@ void handleEvents(GameData &gameData, AssetManager &assets, bool &running,
             gameData.currentGamePlayer = PlayerCharacter(
                 chosenType, 0, 0, gameData.tileWidth, gameData.tileHeight);
             gameData.enemies.clear();
+            gameData.enemySlots.clear();
             gameData.activeProjectiles.clear();
             gameData.currentLevelIndex = 1;
-            Enemy::resetIdCounter(); // Use static method
-            // *** MODIFIED CALL to generateLevel ***
-            std::optional<SDL_Point>
-                pedestalPosOpt; // Variable to receive position
-            gameData.currentLevel =
-                generateLevel(gameData.levelWidth, gameData.levelHeight,
-                              gameData.levelMaxRooms, gameData.levelMinRoomSize,
-                              gameData.levelMaxRoomSize, gameData.enemies,
-                              gameData.tileWidth, gameData.tileHeight,
-                              pedestalPosOpt); // Pass the optional Point
-
-            // *** NEW: Create pedestal object if position was found ***
-            if (pedestalPosOpt.has_value()) {
-              gameData.currentPedestal.emplace(pedestalPosOpt.value().x,
-                                               pedestalPosOpt.value().y);
-              // Mark occupation grid for pedestal (optional, depends if it
-              // blocks movement)
-              // gameData.occupationGrid[pedestalPosOpt.value().y][pedestalPosOpt.value().x]
-              // = true;
-            } else {
-              gameData.currentPedestal
-                  .reset(); // Ensure no pedestal if placement failed
-            }
-            // *** END NEW ***
-            gameData.levelRooms = gameData.currentLevel.rooms;
-            // --- NEW: Apply enemy scaling based on floor ---
-            SDL_Log("Applying enemy scaling for floor %d...",
-                    gameData.currentLevelIndex);
-            for (auto &enemy : gameData.enemies) {
-              enemy.applyFloorScaling(gameData.currentLevelIndex,
-                                      gameData.enemyStatScalingPerFloor);
-            }
-            // --- END Apply enemy scaling ---
-            // Init Occupation Grid
-            gameData.occupationGrid.assign(
-                gameData.currentLevel.height,
-                std::vector<bool>(gameData.currentLevel.width, false));
-            for (int y = 0; y < gameData.currentLevel.height; ++y)
-              for (int x = 0; x < gameData.currentLevel.width; ++x)
-                if (gameData.currentLevel.tiles[y][x] == '#')
-                  gameData.occupationGrid[y][x] = true;
-            // Place player & mark grid
-            gameData.currentGamePlayer.targetTileX =
-                gameData.currentLevel.startCol;
-            gameData.currentGamePlayer.targetTileY =
-                gameData.currentLevel.startRow;
-            gameData.currentGamePlayer.x =
-                gameData.currentGamePlayer.targetTileX * gameData.tileWidth +
-                gameData.tileWidth / 2.0f;
-            gameData.currentGamePlayer.y =
-                gameData.currentGamePlayer.targetTileY * gameData.tileHeight +
-                gameData.tileHeight / 2.0f;
-            gameData.currentGamePlayer.startTileX =
-                gameData.currentGamePlayer.targetTileX;
-            gameData.currentGamePlayer.startTileY =
-                gameData.currentGamePlayer.targetTileY;
-            gameData.currentGamePlayer.isMoving = false;
-            if (isWithinBounds(gameData.currentGamePlayer.targetTileX,
-                               gameData.currentGamePlayer.targetTileY,
-                               gameData.currentLevel.width,
-                               gameData.currentLevel.height))
-              gameData.occupationGrid[gameData.currentGamePlayer.targetTileY]
-                                     [gameData.currentGamePlayer.targetTileX] =
-                  true;
-            // Mark initial enemy positions on grid
-            for (const auto &enemy : gameData.enemies) {
-              if (isWithinBounds(enemy.x, enemy.y, gameData.currentLevel.width,
-                                 gameData.currentLevel.height)) {
-                if (!gameData.occupationGrid[enemy.y][enemy.x]) {
-                  gameData.occupationGrid[enemy.y][enemy.x] = true;
-                } else {
-                  SDL_LogWarn(
-                      SDL_LOG_CATEGORY_APPLICATION,
-                      "Enemy %d spawn location [%d,%d] was already occupied.",
-                      enemy.id, enemy.x, enemy.y);
-                }
-              }
-            }
-            // Init Visibility
-            gameData.visibilityMap.assign(
-                gameData.currentLevel.height,
-                std::vector<float>(gameData.currentLevel.width, 0.0f));
-            updateVisibility(gameData.currentLevel, gameData.levelRooms,
-                             gameData.currentGamePlayer.targetTileX,
-                             gameData.currentGamePlayer.targetTileY,
-                             gameData.hallwayVisibilityDistance,
-                             gameData.visibilityMap);
+            // A new run starts its turn count and game time from zero
+            // before the floor schedules its enemies against the clock
+            gameData.turnNumber = 0;
+            gameData.gameClock = 0;
+            setUpFloor(gameData, assets);
             // Reset gameplay state
             gameData.playerIntendedAction = {};
             gameData.enemyIntendedActions.clear();
@@ -638,7 +481,8 @@ void handleEvents(GameData &gameData, AssetManager &assets, bool &running,
                 if (!gameData.currentGamePlayer.knownSpells.empty() &&
                     gameData.spellSelectIndex >= 0 &&
                     gameData.spellSelectIndex <
-                        gameData.currentGamePlayer.knownSpells.size()) {
+                        static_cast<int>(
+                            gameData.currentGamePlayer.knownSpells.size())) {
                   gameData.currentSpellIndex = gameData.spellSelectIndex;
                   const Spell &spellToCast =
                       gameData.currentGamePlayer.getSpell(
@@ -654,8 +498,6 @@ void handleEvents(GameData &gameData, AssetManager &assets, bool &running,
                       gameData.currentPhase = TurnPhase::Planning_EnemyAI;
                       gameData.currentEnemyPlanningIndex = 0;
                       gameData.enemyIntendedActions.clear();
-                      gameData.enemyIntendedActions.resize(
-                          gameData.enemies.size());
                       SDL_Log("Player plans SELF CAST spell %d. Advancing to "
                               "Enemy Planning.",
                               gameData.currentSpellIndex);
@@ -905,6 +747,13 @@ void handleEvents(GameData &gameData, AssetManager &assets, bool &running,
                   if (event.key.repeat == 0)
                     gameData.currentMenu = GameMenu::CharacterSheet;
                   break;
+                case SDLK_v:
+                  if (event.key.repeat == 0) {
+                    gameData.showThreatOverlay = !gameData.showThreatOverlay;
+                    SDL_Log("Threat overlay %s.",
+                            gameData.showThreatOverlay ? "on" : "off");
+                  }
+                  break;
 
                 // --- Hotkey Logic with Enhanced Logging ---
                 case SDLK_q:
@@ -932,7 +781,8 @@ void handleEvents(GameData &gameData, AssetManager &assets, bool &running,
                   // Check 1: Is the index valid for the known spells?
                   if (spellIndex != -1 &&
                       spellIndex <
-                          gameData.currentGamePlayer.knownSpells.size()) {
+                          static_cast<int>(
+                              gameData.currentGamePlayer.knownSpells.size())) {
                     SDL_Log("DEBUG: Hotkey spell index %d is valid (Known "
                             "Spells: %zu).",
                             spellIndex,
@@ -1020,34 +870,23 @@ void handleEvents(GameData &gameData, AssetManager &assets, bool &running,
                       gameData.currentLevel.tiles[newPlayerTargetY]
                                                  [newPlayerTargetX] != '#') {
 
+                    // Ask the occupancy grid who is there instead of
+                    // scanning the enemy list
+                    Occupant targetOccupant = gameData.occupancy.at(
+                        newPlayerTargetX, newPlayerTargetY);
                     bool enemyOccupiesTarget = false;
-                    // Check grid FIRST before checking specific enemies
-                    if (gameData.occupationGrid[newPlayerTargetY]
-                                               [newPlayerTargetX]) {
-                      // It's occupied, check if it's an enemy
-                      for (const auto &enemy : gameData.enemies) {
-                        if (enemy.x == newPlayerTargetX &&
-                            enemy.y == newPlayerTargetY && enemy.health > 0) {
-                          enemyOccupiesTarget = true;
-                          break;
-                        }
-                      }
-                      // If the loop finishes and enemyOccupiesTarget is still
-                      // false, it means the grid was marked but it wasn't a
-                      // living enemy (Could be a planned move collision, or
-                      // stale data - treat as blocked for now)
-                      if (!enemyOccupiesTarget) {
-                        /*SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                                    "Player move to [%d,%d] blocked by "
-                                    "non-enemy occupation.",
-                                    newPlayerTargetX, newPlayerTargetY);*/
-                        // Decide how to handle this - for now, block the move.
-                        // Alternatively, could allow move if it's e.g. a dead
-                        // enemy spot not cleared yet
-                      }
+                    if (targetOccupant.kind == OccupantKind::Enemy) {
+                      const Enemy *occupyingEnemy =
+                          findEnemy(gameData, targetOccupant.enemy);
+                      enemyOccupiesTarget =
+                          occupyingEnemy != nullptr && occupyingEnemy->health > 0;
                     }
 
-                    if (enemyOccupiesTarget) {
+                    if (targetOccupant.kind == OccupantKind::Pedestal) {
+                      SDL_Log("Player move to [%d,%d] blocked by the rune "
+                              "pedestal. No action planned.",
+                              newPlayerTargetX, newPlayerTargetY);
+                    } else if (enemyOccupiesTarget) {
                       SDL_Log("Player move to [%d,%d] blocked by enemy. No "
                               "action planned.",
                               newPlayerTargetX, newPlayerTargetY);
@@ -1069,25 +908,19 @@ void handleEvents(GameData &gameData, AssetManager &assets, bool &running,
                       gameData.currentGamePlayer.startMove(newPlayerTargetX,
                                                            newPlayerTargetY);
 
-                      // 3. Update occupation grid immediately for enemy
-                      // planning Clear old spot
-                      if (isWithinBounds(oldPlayerTileX, oldPlayerTileY,
-                                         gameData.currentLevel.width,
-                                         gameData.currentLevel.height)) {
-                        gameData
-                            .occupationGrid[oldPlayerTileY][oldPlayerTileX] =
-                            false;
-                        SDL_Log("Cleared player occupation at old pos [%d,%d]",
-                                oldPlayerTileX, oldPlayerTileY);
-                      }
-                      // Set new spot (intended destination)
-                      if (isWithinBounds(newPlayerTargetX, newPlayerTargetY,
-                                         gameData.currentLevel.width,
-                                         gameData.currentLevel.height)) {
-                        gameData.occupationGrid[newPlayerTargetY]
-                                               [newPlayerTargetX] = true;
-                        SDL_Log("Set player occupation at new pos [%d,%d]",
+                      // 3. Update occupancy immediately for enemy planning
+                      if (gameData.occupancy.move(oldPlayerTileX, oldPlayerTileY,
+                                                  newPlayerTargetX,
+                                                  newPlayerTargetY)) {
+                        SDL_Log("Moved player occupancy [%d,%d] -> [%d,%d]",
+                                oldPlayerTileX, oldPlayerTileY,
                                 newPlayerTargetX, newPlayerTargetY);
+                      } else {
+                        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                                    "Player occupancy move [%d,%d] -> [%d,%d] "
+                                    "rejected; grid out of sync?",
+                                    oldPlayerTileX, oldPlayerTileY,
+                                    newPlayerTargetX, newPlayerTargetY);
                       }
                       // *** END IMMEDIATE MOVE INITIATION ***
 
@@ -1120,9 +953,6 @@ void handleEvents(GameData &gameData, AssetManager &assets, bool &running,
                 gameData.currentPhase = TurnPhase::Planning_EnemyAI;
                 gameData.currentEnemyPlanningIndex = 0;
                 gameData.enemyIntendedActions.clear();
-                if (!gameData.enemies.empty()) {
-                  gameData.enemyIntendedActions.resize(gameData.enemies.size());
-                }
                 SDL_Log("--- Player Planning Complete. Transitioning to Enemy "
                         "Planning ---");
                 // Reset targeting state just in case
@@ -1147,6 +977,103 @@ void handleEvents(GameData &gameData, AssetManager &assets, bool &running,
 }
 
 // --- Rewritten updateLogic Function ---
+// --- Floor Setup ---
+void setUpFloor(GameData &gameData, AssetManager &assets) {
+  PlayerCharacter &player = gameData.currentGamePlayer;
+  Enemy::resetIdCounter(); // Enemy ids restart every floor
+  std::optional<SDL_Point> pedestalPosOpt; // Variable to receive position
+  gameData.currentLevel = generateLevel(
+      gameData.levelWidth, gameData.levelHeight, gameData.levelMaxRooms,
+      gameData.levelMinRoomSize, gameData.levelMaxRoomSize, gameData.enemies,
+      pedestalPosOpt); // Pass the optional Point
+
+  if (pedestalPosOpt.has_value()) {
+    gameData.currentPedestal.emplace(pedestalPosOpt.value().x,
+                                     pedestalPosOpt.value().y);
+    // Occupancy for the pedestal is marked once the grid is reset
+  } else {
+    gameData.currentPedestal.reset(); // Ensure no pedestal if placement failed
+  }
+  gameData.levelRooms = gameData.currentLevel.rooms;
+
+  // --- Apply enemy scaling based on floor ---
+  SDL_Log("Applying enemy scaling for floor %d...",
+          gameData.currentLevelIndex);
+  for (auto &enemy : gameData.enemies) {
+    enemy.applyFloorScaling(gameData.currentLevelIndex,
+                            gameData.enemyStatScalingPerFloor);
+  }
+  syncEnemySlots(gameData); // Hand out enemy handles
+  // Drop the old floor's turn order and give every new enemy its first turn
+  gameData.scheduler.clear();
+  gameData.dueEnemies.clear();
+  for (auto &enemy : gameData.enemies)
+    scheduleEnemy(gameData, enemy);
+  // This floor's enemies load now; the next floor's in the background
+  assets.prefetch(floorAssetGroups(gameData.currentLevelIndex));
+  assets.prefetch(floorAssetGroups(gameData.currentLevelIndex + 1));
+
+  // Fresh perception maps: nothing heard or smelled yet
+  gameData.noiseMap.reset(gameData.currentLevel.width,
+                          gameData.currentLevel.height,
+                          gameData.noiseDecayPerTurn);
+  gameData.scentMap.reset(gameData.currentLevel.width,
+                          gameData.currentLevel.height,
+                          gameData.scentDecayPerTurn);
+  resetInfluenceMaps(gameData);
+  gameData.terrainCache.reset(gameData.currentLevel.width,
+                              gameData.currentLevel.height,
+                              gameData.tileWidth, gameData.tileHeight);
+
+  // Occupancy: walls, then the pedestal
+  gameData.occupancy.reset(gameData.currentLevel.width,
+                           gameData.currentLevel.height);
+  for (int y = 0; y < gameData.currentLevel.height; ++y)
+    for (int x = 0; x < gameData.currentLevel.width; ++x)
+      if (gameData.currentLevel.tiles[y][x] == '#')
+        gameData.occupancy.place(x, y, Occupant::wall());
+  if (gameData.currentPedestal.has_value())
+    gameData.occupancy.place(gameData.currentPedestal->x,
+                             gameData.currentPedestal->y,
+                             Occupant::pedestal());
+
+  // Player to the floor's start
+  player.targetTileX = gameData.currentLevel.startCol;
+  player.targetTileY = gameData.currentLevel.startRow;
+  player.x =
+      player.targetTileX * gameData.tileWidth + gameData.tileWidth / 2.0f;
+  player.y =
+      player.targetTileY * gameData.tileHeight + gameData.tileHeight / 2.0f;
+  player.startTileX = player.targetTileX;
+  player.startTileY = player.targetTileY;
+  player.isMoving = false;
+  gameData.occupancy.place(player.targetTileX, player.targetTileY,
+                           Occupant::player());
+
+  // Mark initial enemy positions on grid
+  for (const auto &enemy : gameData.enemies) {
+    if (isWithinBounds(enemy.x, enemy.y, gameData.currentLevel.width,
+                       gameData.currentLevel.height)) {
+      if (!gameData.occupancy.place(enemy.x, enemy.y,
+                                    Occupant::forEnemy(enemy.handle))) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                    "Enemy %d spawn location [%d,%d] was already occupied.",
+                    enemy.id, enemy.x, enemy.y);
+      }
+    }
+  }
+  rebuildSpatialGrid(gameData);
+
+  // Visibility from the start tile
+  gameData.visibilityMap.assign(
+      gameData.currentLevel.height,
+      std::vector<float>(gameData.currentLevel.width, 0.0f));
+  updateVisibility(gameData.currentLevel, gameData.levelRooms,
+                   player.targetTileX, player.targetTileY,
+                   gameData.hallwayVisibilityDistance, gameData.visibilityMap);
+  gameData.terrainCache.invalidateFog();
+}
+
 void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
 
   // SDL_Log("DEBUG: [UpdateLogic Start] Current Phase: %d",
@@ -1170,9 +1097,11 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
   // update player
   gameData.currentGamePlayer.update(deltaTime, gameData);
 
-  for (auto &enemy : gameData.enemies) {
-    if (enemy.health > 0) { // Only update living enemies
-      enemy.update(deltaTime, gameData);
+  for (size_t i = 0; i < gameData.enemies.size(); ++i) {
+    // Only living enemies at full activity animate every frame
+    Enemy &enemy = gameData.enemies[i];
+    if (enemy.health > 0 && enemy.activityTier == ActivityTier::Full) {
+      enemy.update(deltaTime, gameData.enemies.presentation(i));
     }
   }
 
@@ -1201,11 +1130,7 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
   }
 
   // --- Timing variables ---
-  static Uint32 planningWallClockStartTime =
-      0; // For overall phase wall-clock time
-  static Uint32 totalEnemyPlanningCpuTime =
-      0; // Accumulator for CPU time this turn
-  static Uint32 resolutionStartTime = 0;
+  PhaseTimers &timers = gameData.phaseTimers; // Persist across frames
   Uint32 phaseEndTime = 0;
   Uint32 elapsedMs = 0;
 
@@ -1213,9 +1138,6 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
 
   // SDL_Log("DEBUG: [UpdateLogic] Entering phase switch. Current Phase: %d",
   //         (int)gameData.currentPhase);
-  TurnPhase previousPhase =
-      gameData.currentPhase; // Track phase changes for logging
-
   switch (gameData.currentPhase) {
   case TurnPhase::Planning_PlayerInput: {
 
@@ -1230,93 +1152,12 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
       SDL_Log("Player is starting turn on exit tile! Advancing to next level.");
       gameData.currentLevelIndex++;
       gameData.enemies.clear();           // Clear enemies
+      gameData.enemySlots.clear();        // Invalidate all old handles
       gameData.activeProjectiles.clear(); // Clear projectiles
       gameData.playerIntendedAction = {}; // Clear intent
       gameData.enemyIntendedActions.clear();
 
-      // Generate New Level
-      Enemy::resetIdCounter(); // Reset IDs for new level
-      // *** MODIFIED CALL to generateLevel ***
-      std::optional<SDL_Point> pedestalPosOpt; // Variable to receive position
-      gameData.currentLevel = generateLevel(
-          gameData.levelWidth, gameData.levelHeight, gameData.levelMaxRooms,
-          gameData.levelMinRoomSize, gameData.levelMaxRoomSize,
-          gameData.enemies, gameData.tileWidth, gameData.tileHeight,
-          pedestalPosOpt); // Pass the optional Point
-
-      // *** NEW: Create pedestal object if position was found ***
-      if (pedestalPosOpt.has_value()) {
-        gameData.currentPedestal.emplace(pedestalPosOpt.value().x,
-                                         pedestalPosOpt.value().y);
-        // Mark occupation grid for pedestal (optional, depends if it blocks
-        // movement)
-        // gameData.occupationGrid[pedestalPosOpt.value().y][pedestalPosOpt.value().x]
-        // = true;
-      } else {
-        gameData.currentPedestal
-            .reset(); // Ensure no pedestal if placement failed
-      }
-      // *** END NEW ***
-      gameData.levelRooms = gameData.currentLevel.rooms;
-
-      // --- Apply enemy scaling based on floor ---
-      SDL_Log("Applying enemy scaling for floor %d...",
-              gameData.currentLevelIndex);
-      for (auto &enemy : gameData.enemies) {
-        enemy.applyFloorScaling(gameData.currentLevelIndex,
-                                gameData.enemyStatScalingPerFloor);
-      }
-      // --- END Apply enemy scaling ---
-
-      // Re-Initialize Occupation Grid
-      gameData.occupationGrid.assign(
-          gameData.currentLevel.height,
-          std::vector<bool>(gameData.currentLevel.width, false));
-      for (int y = 0; y < gameData.currentLevel.height; ++y)
-        for (int x = 0; x < gameData.currentLevel.width; ++x)
-          if (gameData.currentLevel.tiles[y][x] == '#')
-            gameData.occupationGrid[y][x] = true;
-
-      // Reset Player Position to New Start
-      player.targetTileX = gameData.currentLevel.startCol;
-      player.targetTileY = gameData.currentLevel.startRow;
-      player.x =
-          player.targetTileX * gameData.tileWidth + gameData.tileWidth / 2.0f;
-      player.y =
-          player.targetTileY * gameData.tileHeight + gameData.tileHeight / 2.0f;
-      player.startTileX = player.targetTileX;
-      player.startTileY = player.targetTileY;
-      player.isMoving = false; // Ensure player is not moving
-      // Mark new player position on grid
-      if (isWithinBounds(player.targetTileX, player.targetTileY,
-                         gameData.currentLevel.width,
-                         gameData.currentLevel.height)) {
-        gameData.occupationGrid[player.targetTileY][player.targetTileX] = true;
-      }
-
-      // Mark initial enemy positions on grid for new level
-      for (const auto &enemy : gameData.enemies) {
-        if (isWithinBounds(enemy.x, enemy.y, gameData.currentLevel.width,
-                           gameData.currentLevel.height)) {
-          if (!gameData.occupationGrid[enemy.y][enemy.x]) {
-            gameData.occupationGrid[enemy.y][enemy.x] = true;
-          } else {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                        "New level enemy %d spawn location [%d,%d] was "
-                        "already occupied.",
-                        enemy.id, enemy.x, enemy.y);
-          }
-        }
-      }
-
-      // Reset Visibility
-      gameData.visibilityMap.assign(
-          gameData.currentLevel.height,
-          std::vector<float>(gameData.currentLevel.width, 0.0f));
-      updateVisibility(gameData.currentLevel, gameData.levelRooms,
-                       player.targetTileX, player.targetTileY,
-                       gameData.hallwayVisibilityDistance,
-                       gameData.visibilityMap);
+      setUpFloor(gameData, assets);
 
       // Transition directly to the start of the *next* turn's planning
       // (Effectively skipping the rest of the current frame's update logic for
@@ -1364,11 +1205,10 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
 
         // Remove the item from the dropped items list
         gameData.droppedItems.erase(it); // Erase the found item
+        syncSpatialItems(gameData);      // Later items shifted down
       }
     }
-    planningWallClockStartTime = 0; // Reset timers when in player input phase
-    resolutionStartTime = 0;
-    totalEnemyPlanningCpuTime = 0;
+    timers = PhaseTimers(); // Reset timers when in player input phase
 
     break; // Waiting for input
   }
@@ -1377,12 +1217,33 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
     SDL_Log(
         "DEBUG: [UpdateLogic] Entering Planning_EnemyAI phase."); // Log phase
                                                                   // entry
-    if (previousPhase ==
-        TurnPhase::Planning_PlayerInput) { // Only start timer on first frame
-                                           // entering this phase
-      planningWallClockStartTime = SDL_GetTicks();
-      totalEnemyPlanningCpuTime =
+    bool isFirstPlanningFrame = (gameData.currentEnemyPlanningIndex == 0);
+    if (isFirstPlanningFrame) { // Only start timer on the first slice
+      timers.planningWallClockStart = SDL_GetTicks();
+      timers.enemyPlanningCpuMs =
           0; // Ensure accumulator is reset at start of phase
+      // Advance the clock and pick out the enemies whose turn has come;
+      // only they are planned, one action each
+      beginEnemyTurn(gameData);
+      gameData.enemyIntendedActions.assign(gameData.dueEnemies.size(),
+                                           IntendedAction());
+      // Decide who sleeps, who gets coarse simulation and who gets full
+      updateEnemyActivityTiers(gameData);
+      // The influence maps and the distance field don't touch each other,
+      // so they build side by side; squads need the distance field first.
+      JobSystem &jobs = gameData.jobs;
+      JobCounter influenceDone, inputsDone, squadsDone;
+      // Restamp threat/density around anyone who moved since last turn
+      jobs.submit([&gameData]() { updateInfluenceMaps(gameData); },
+                  &influenceDone);
+      // Inputs every enemy's utility AI shares (player distance field)
+      jobs.submit([&gameData]() { buildAiTurnInputs(gameData); }, &inputsDone);
+      // Hand engaged enemies their places around the player
+      jobs.submit([&gameData]() { assignSquadSlots(gameData); }, &squadsDone,
+                  {&inputsDone});
+      jobs.wait(influenceDone);
+      jobs.wait(squadsDone);
+      jobs.wait(inputsDone);
     }
     // ***
 
@@ -1391,205 +1252,45 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
       gameData.currentGamePlayer.update(deltaTime, gameData);
     }
 
-    // --- Process ALL Enemies in a single loop ---
-    // Ensure intended actions vector is sized correctly first
-    if (gameData.enemyIntendedActions.size() != gameData.enemies.size()) {
-      SDL_LogWarn(
-          SDL_LOG_CATEGORY_APPLICATION,
-          "Resizing enemyIntendedActions from %zu to %zu during planning.",
-          gameData.enemyIntendedActions.size(), gameData.enemies.size());
-      gameData.enemyIntendedActions.resize(gameData.enemies.size());
+    // --- Plan the Due Enemies (possibly over several frames) ---
+    // --- Plan Stage (pure, parallel, time-sliced) ---
+    // Seed for the random walks of unseen enemies; drawn once per turn on the
+    // main thread so the plans don't depend on which worker ran them.
+    if (isFirstPlanningFrame) {
+      gameData.planningSeed = static_cast<unsigned int>(rand());
     }
-
-    // --- Main Planning Loop for All Enemies ---
-    SDL_Log(
-        "DEBUG: [UpdateLogic] Starting enemy planning loop (%zu enemies)...",
-        gameData.enemies.size());
-    for (int i = 0; i < gameData.enemies.size(); ++i) {
-      // Safety check for vector index just in case resize failed or size
-      // changed unexpectedly
-      if (i >= gameData.enemies.size() ||
-          i >= gameData.enemyIntendedActions.size()) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                     "Index %d out of bounds during enemy planning loop (Enemy "
-                     "Size: %zu, Action Size: %zu). Skipping.",
-                     i, gameData.enemies.size(),
-                     gameData.enemyIntendedActions.size());
-        continue; // Skip this iteration
-      }
-
-      Enemy &currentEnemy = gameData.enemies[i];
-
-      // *** START TIMING Single Enemy CPU Time ***
-      Uint32 singleEnemyStartTime = SDL_GetTicks();
-      // ***
-
-      if (currentEnemy.health > 0 && !currentEnemy.isMoving) {
-        // Enemy is alive and not currently animating a move, plan its action
-        IntendedAction plan = currentEnemy.planAction(
-            gameData.currentLevel, gameData.currentGamePlayer, gameData);
-        gameData.enemyIntendedActions[i] =
-            plan; // Store the plan using loop index 'i'
-
-        SDL_Log("DEBUG: [UpdateLogic] Enemy %d planned action type: %d",
-                currentEnemy.id, (int)plan.type);
-
-        // Handle tentative occupation and instant invisible moves logic
-        // immediately after planning
-        if (plan.type == ActionType::Move) {
-          if (isWithinBounds(plan.targetX, plan.targetY,
-                             gameData.currentLevel.width,
-                             gameData.currentLevel.height)) {
-            // Check if the target tile is *currently* free in the grid
-            if (!gameData.occupationGrid[plan.targetY][plan.targetX]) {
-              // Mark it as tentatively occupied for subsequent enemies in
-              // *this* planning pass
-              gameData.occupationGrid[plan.targetY][plan.targetX] = true;
-              // SDL_Log("INFO: Enemy %d tentatively occupies [%d,%d] for
-              // planning.", currentEnemy.id, plan.targetX, plan.targetY); //
-              // Optional Log
-
-              // Check visibility to handle instant invisible moves
-              float visibility = 0.0f;
-              if (isWithinBounds(currentEnemy.x, currentEnemy.y,
-                                 gameData.currentLevel.width,
-                                 gameData.currentLevel.height) &&
-                  currentEnemy.y < gameData.visibilityMap.size() &&
-                  currentEnemy.x <
-                      gameData.visibilityMap[currentEnemy.y].size()) {
-                visibility =
-                    gameData.visibilityMap[currentEnemy.y][currentEnemy.x];
-              }
-              bool isVisible = (visibility > 0.0f);
-
-              // If move is planned AND enemy is invisible, snap visual/logical
-              // coords now
-              if (!isVisible) {
-                currentEnemy.visualX = plan.targetX * gameData.tileWidth +
-                                       gameData.tileWidth / 2.0f;
-                currentEnemy.visualY = plan.targetY * gameData.tileHeight +
-                                       gameData.tileHeight / 2.0f;
-
-                // Update logical coords instantly too, clearing old spot on
-                // grid *if different*
-                if (isWithinBounds(currentEnemy.x, currentEnemy.y,
-                                   gameData.currentLevel.width,
-                                   gameData.currentLevel.height)) {
-                  if (currentEnemy.x != plan.targetX ||
-                      currentEnemy.y != plan.targetY) {
-                    gameData.occupationGrid[currentEnemy.y][currentEnemy.x] =
-                        false;
-                  }
-                }
-                currentEnemy.x = plan.targetX;
-                currentEnemy.y = plan.targetY;
-                // The target spot was already marked occupied above for the
-                // tentative logic SDL_Log("INFO: Enemy %d (invisible) instantly
-                // updated logic/visual to planned move [%d,%d]",
-                // currentEnemy.id, plan.targetX, plan.targetY); // Optional Log
-              }
-              // End of invisible enemy instant update logic
-
-            } else { // Target tile was already occupied (by player or
-                     // previously planned enemy)
-              SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                          "Enemy %d planned move to [%d,%d] but it was "
-                          "occupied during planning phase. Forcing WAIT.",
-                          currentEnemy.id, plan.targetX, plan.targetY);
-              gameData.enemyIntendedActions[i].type =
-                  ActionType::Wait; // Force Wait
-            }
-          } else { // Target tile is out of bounds
-            SDL_LogWarn(
-                SDL_LOG_CATEGORY_APPLICATION,
-                "Enemy %d planned move out of bounds to [%d,%d]. Forcing WAIT.",
-                currentEnemy.id, plan.targetX, plan.targetY);
-            gameData.enemyIntendedActions[i].type =
-                ActionType::Wait; // Force Wait
-          }
-        } // End if plan type is Move
-      } else { // Enemy is dead or already moving (shouldn't happen for moving
-        // if called correctly)
-        SDL_Log("DEBUG: [UpdateLogic] Enemy %d skipped planning (Dead or "
-                "Moving). Health: %d, Moving: %s",
-                currentEnemy.id, currentEnemy.health,
-                currentEnemy.isMoving ? "true" : "false");
-        gameData.enemyIntendedActions[i].type =
-            ActionType::None; // Ensure no action if dead/moving
-        if (currentEnemy.isMoving) {
-          SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                      "Enemy %d was already moving during planning phase? "
-                      "Setting action to None.",
-                      currentEnemy.id);
-        }
-      }
-
-      // *** END TIMING Single Enemy CPU Time & Accumulate ***
-      Uint32 singleEnemyEndTime = SDL_GetTicks();
-      totalEnemyPlanningCpuTime += (singleEnemyEndTime - singleEnemyStartTime);
-      SDL_Log("DEBUG: [UpdateLogic] Finished planning for enemy index %d.", i);
-      // ***
-
-    } // --- End FOR loop processing all enemies ---
-
-    // --- Cleanup Tentative Enemy Occupation Marks (After ALL enemies have
-    // planned) ---
-    for (int i = 0; i < gameData.enemies.size(); ++i) {
-      if (i >= gameData.enemyIntendedActions.size())
-        continue; // Safety check
-
-      const IntendedAction &plan = gameData.enemyIntendedActions[i];
-
-      // Only need to revert tentative marks for VISIBLE enemies who planned a
-      // move. Invisible enemies already committed their grid changes.
-      if (plan.type == ActionType::Move) {
-        // Need the enemy object to check its visibility status *now*
-        const Enemy &enemy = gameData.enemies[i]; // Get corresponding enemy
-        float visibility = 0.0f;
-        if (isWithinBounds(enemy.x, enemy.y, gameData.currentLevel.width,
-                           gameData.currentLevel.height) &&
-            enemy.y < gameData.visibilityMap.size() &&
-            enemy.x < gameData.visibilityMap[enemy.y].size()) {
-          visibility = gameData.visibilityMap[enemy.y][enemy.x];
-        }
-        bool isVisible = (visibility > 0.0f);
-
-        if (isVisible && isWithinBounds(plan.targetX, plan.targetY,
-                                        gameData.currentLevel.width,
-                                        gameData.currentLevel.height)) {
-          // Check if the grid is still marked as occupied by *this tentative
-          // plan* We also need to ensure the player didn't end up logically on
-          // that tile due to their concurrent move finishing.
-          if (gameData.occupationGrid[plan.targetY][plan.targetX] &&
-              !(gameData.currentGamePlayer.targetTileX == plan.targetX &&
-                gameData.currentGamePlayer.targetTileY == plan.targetY)) {
-            // It was marked (likely by this enemy or another earlier in the
-            // loop) and player isn't there, so clear it. This prepares the grid
-            // for the Resolution phase where moves are actually initiated.
-            gameData.occupationGrid[plan.targetY][plan.targetX] = false;
-            // SDL_Log("INFO: Clearing tentative *visible enemy* occupation mark
-            // at [%d,%d].", plan.targetX, plan.targetY); // Optional Log
-          }
-        }
-      }
+    Uint32 planStageStartTime = SDL_GetTicks();
+    bool planningDone = planEnemyActionsSliced(
+        gameData,
+        static_cast<Uint32>(std::max(0, gameData.enemyPlanningBudgetUs)));
+    timers.enemyPlanningCpuMs += SDL_GetTicks() - planStageStartTime;
+    SDL_Log("DEBUG: [UpdateLogic] Planned %d/%zu due enemies on up to %u "
+            "threads.",
+            gameData.currentEnemyPlanningIndex, gameData.dueEnemies.size(),
+            gameData.jobs.getThreadCount());
+    if (!planningDone) {
+      break; // Out of budget: render this frame, resume planning next frame
     }
-    // --- End Cleanup of Tentative Marks ---
+
+    // --- Reservation Stage (serial, deterministic) ---
+    resolveEnemyPlanConflicts(gameData);
 
     // *** LOG FINAL TIMING DATA ***
-    if (planningWallClockStartTime > 0) { // Ensure wall clock timer was started
+    if (timers.planningWallClockStart > 0) { // Ensure wall clock timer was started
       phaseEndTime = SDL_GetTicks();
-      elapsedMs = phaseEndTime - planningWallClockStartTime;
+      elapsedMs = phaseEndTime - timers.planningWallClockStart;
       SDL_Log("INFO: --- Phase Planning_EnemyAI (Wall Clock) Took: %u ms ---",
               elapsedMs);
-      planningWallClockStartTime = 0; // Reset wall clock timer
+      timers.planningWallClockStart = 0; // Reset wall clock timer
     }
     SDL_Log("INFO: --- Total Enemy Planning CPU Time This Turn: %u ms ---",
-            totalEnemyPlanningCpuTime);
+            timers.enemyPlanningCpuMs);
     // ***
 
     // Transition phase AFTER processing all enemies and cleaning up marks
     // SDL_Log("INFO: --- Enemy Planning Complete. Transitioning to Resolution
     // Start ---"); // Optional Log
+    gameData.currentEnemyPlanningIndex = 0;
     gameData.currentPhase = TurnPhase::Resolution_Start;
     SDL_Log("DEBUG: [UpdateLogic] Finished enemy planning loop.");
 
@@ -1600,20 +1301,17 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
     SDL_Log(
         "DEBUG: [UpdateLogic] Entering Resolution_Start phase."); // Log phase
                                                                   // entry
+    gameData.animatingEnemies.clear();
+
     // Initiate Player Action
     IntendedAction pAction = gameData.playerIntendedAction;
     PlayerCharacter &player = gameData.currentGamePlayer;
     if (pAction.type == ActionType::Move) {
-      if (isWithinBounds(pAction.targetX, pAction.targetY,
-                         gameData.currentLevel.width,
-                         gameData.currentLevel.height) &&
-          !gameData.occupationGrid[pAction.targetY][pAction.targetX]) {
-        if (isWithinBounds(player.targetTileX, player.targetTileY,
-                           gameData.currentLevel.width,
-                           gameData.currentLevel.height))
-          gameData.occupationGrid[player.targetTileY][player.targetTileX] =
-              false;
-        gameData.occupationGrid[pAction.targetY][pAction.targetX] = true;
+      if (player.targetTileX == pAction.targetX &&
+          player.targetTileY == pAction.targetY) {
+        // Move (and occupancy) already started during input
+      } else if (gameData.occupancy.move(player.targetTileX, player.targetTileY,
+                                         pAction.targetX, pAction.targetY)) {
         player.startMove(pAction.targetX, pAction.targetY);
       } else {
         SDL_Log("Player planned move to [%d,%d] blocked at resolution.",
@@ -1625,6 +1323,10 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
       SDL_Log("Player resolves CAST SPELL %d.", pAction.spellIndex);
       player.castSpell(pAction.spellIndex, pAction.targetX, pAction.targetY,
                        gameData.enemies, gameData.activeProjectiles, &assets);
+      syncSpatialProjectiles(gameData);
+      // Spellcasting is loud: rouse anything sleeping near the caster
+      emitNoise(gameData, player.targetTileX, player.targetTileY,
+                gameData.noiseWakeRadius);
     } else if (pAction.type == ActionType::Wait) {
       SDL_Log("Player resolves WAIT.");
     }
@@ -1634,19 +1336,13 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
             gameData.enemies.size());
     // Initiate Enemy Actions
     for (const auto &eAction : gameData.enemyIntendedActions) {
-      // Skip actions with no assigned enemy ID (shouldn't happen if planning is
+      // Skip actions with no assigned enemy (shouldn't happen if planning is
       // correct)
-      if (eAction.enemyId == -1)
+      if (!eAction.enemyHandle.isValid())
         continue;
 
-      // Find the enemy associated with this action by ID
-      Enemy *enemyPtr = nullptr;
-      for (auto &potentialEnemy : gameData.enemies) {
-        if (potentialEnemy.id == eAction.enemyId) {
-          enemyPtr = &potentialEnemy;
-          break;
-        }
-      }
+      // Find the enemy associated with this action by handle
+      Enemy *enemyPtr = findEnemy(gameData, eAction.enemyHandle);
 
       // Check if enemy was found AND is alive
       if (enemyPtr != nullptr && enemyPtr->health > 0) {
@@ -1659,31 +1355,17 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
         // Now resolve the action for this specific, living enemy
         switch (eAction.type) {
         case ActionType::Move: {
-          // Check if target tile is valid and unoccupied
-          if (isWithinBounds(eAction.targetX, eAction.targetY,
-                             gameData.currentLevel.width,
-                             gameData.currentLevel.height) &&
-              !gameData.occupationGrid[eAction.targetY][eAction.targetX]) {
-            // Update occupation grid: Clear old, set new
-            if (isWithinBounds(enemy.x, enemy.y, gameData.currentLevel.width,
-                               gameData.currentLevel.height)) {
-              gameData.occupationGrid[enemy.y][enemy.x] = false;
-              SDL_Log("DEBUG: Enemy %d cleared occupation at [%d,%d]", enemy.id,
-                      enemy.x, enemy.y);
-            }
-            gameData.occupationGrid[eAction.targetY][eAction.targetX] = true;
-            SDL_Log("DEBUG: Enemy %d set occupation at [%d,%d]", enemy.id,
-                    eAction.targetX, eAction.targetY);
-
-            // Start the move animation
-            enemy.startMove(eAction.targetX, eAction.targetY);
+          // resolveEnemyPlanConflicts already validated the move and updated
+          // the occupation grid; only the animation is left to start.
+          if (enemy.x == eAction.targetX && enemy.y == eAction.targetY) {
+            SDL_Log("DEBUG: Enemy %d already moved unseen to [%d,%d]",
+                    enemy.id, eAction.targetX, eAction.targetY);
+          } else {
+            enemy.startMove(eAction.targetX, eAction.targetY,
+                            gameData.enemies.presentationOf(enemy));
+            gameData.animatingEnemies.push_back(enemy.handle);
             SDL_Log("INFO: Enemy %d initiated MOVE to [%d,%d]", enemy.id,
                     eAction.targetX, eAction.targetY);
-          } else {
-            SDL_Log(
-                "WARN: Enemy %d planned move to [%d,%d] blocked at resolution.",
-                enemy.id, eAction.targetX, eAction.targetY);
-            // Enemy does nothing this turn if move is blocked at resolution
           }
           break;
         }
@@ -1695,8 +1377,12 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
           if (player.targetTileX == eAction.targetX &&
               player.targetTileY == eAction.targetY) {
             int damage = enemy.GetAttackDamage();
-            enemy.startAttackAnimation(gameData); // Start animation
+            enemy.startAttackAnimation(
+                gameData, gameData.enemies.presentationOf(enemy));
             player.takeDamage(damage);            // Apply damage
+            addDecal(gameData, DecalType::Blood,
+                     (player.targetTileX + 0.5f) * gameData.tileWidth,
+                     (player.targetTileY + 0.5f) * gameData.tileHeight);
           } else {
             SDL_Log(
                 "INFO: Enemy %d attack whiffed! Player not at target [%d,%d].",
@@ -1708,7 +1394,28 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
         case ActionType::CastSpell: {
           SDL_Log("INFO: Enemy %d resolves CAST SPELL %d.", enemy.id,
                   eAction.spellIndex);
-          // Implement enemy spell casting logic here if needed
+          const EnemyArchetype &arch = enemy.archetype();
+          SDL_Texture *projTexture =
+              arch.projectileTextureName.empty()
+                  ? nullptr
+                  : assets.getTexture(arch.projectileTextureId);
+          if (projTexture) {
+            // Homes on the player, so it lands even if they step away
+            EnemyPresentation &look = gameData.enemies.presentationOf(enemy);
+            Projectile spit(ProjectileType::Firebolt,
+                            arch.projectileTextureId, 24, 24, look.visualX,
+                            look.visualY, player.x, player.y, 450.0f,
+                            enemy.GetAttackDamage());
+            spit.targetsPlayer = true;
+            gameData.activeProjectiles.push_back(spit);
+            syncSpatialProjectiles(gameData);
+            enemy.startAttackAnimation(gameData, look);
+          } else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                        "Enemy %d has no projectile texture '%s'; spell "
+                        "fizzles.",
+                        enemy.id, arch.projectileTextureName.c_str());
+          }
           break;
         }
         case ActionType::Wait: {
@@ -1724,9 +1431,9 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
 
       } else if (enemyPtr == nullptr) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                    "Resolution_Start: Could not find enemy with ID %d for "
+                    "Resolution_Start: Could not find enemy (slot %u) for "
                     "planned action.",
-                    eAction.enemyId);
+                    eAction.enemyHandle.slot);
       } else { // enemyPtr != nullptr && enemyPtr->health <= 0
         SDL_Log("DEBUG: [UpdateLogic] Skipping action resolution for dead "
                 "Enemy ID %d.",
@@ -1735,120 +1442,26 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
     }
 
     SDL_Log("DEBUG: [UpdateLogic] Finished enemy action resolution loop.");
+
+    // Everything started above counts itself off when it finishes. A
+    // projectile can be inactive from the start and is then just erased, so
+    // only active ones count (as in countUnfinishedResolutions)
+    gameData.playerMovePending = player.isMoving;
+    gameData.pendingResolutions =
+        (gameData.playerMovePending ? 1 : 0) +
+        static_cast<int>(gameData.animatingEnemies.size()) +
+        static_cast<int>(std::count_if(
+            gameData.activeProjectiles.begin(),
+            gameData.activeProjectiles.end(),
+            [](const Projectile &proj) { return proj.isActive; }));
+    gameData.resolutionTask.reset();
     gameData.currentPhase = TurnPhase::Resolution_Update;
 
     SDL_Log("--- Transitioning to Resolution Update ---");
   } break;
 
   case TurnPhase::Resolution_Update: { // Scope
-
-    // *** START TIMING Resolution_Update (Implicit Wait) ***
-    if (previousPhase ==
-        TurnPhase::Resolution_Start) { // Only log start time on first entry
-      resolutionStartTime = SDL_GetTicks();
-      // SDL_Log("INFO: --- Entering Phase: Resolution Update ---");
-    }
-    // ***
-
-    bool playerFinishedMovingThisFrame = false;
-
-    if (gameData.currentGamePlayer.isMoving) {
-      bool wasMoving = true;
-      gameData.currentGamePlayer.update(deltaTime, gameData);
-      if (wasMoving && !gameData.currentGamePlayer.isMoving) {
-        playerFinishedMovingThisFrame = true; // Player's move completed
-      }
-    }
-    for (auto &enemy : gameData.enemies) {
-      if (enemy.health > 0 && enemy.isMoving) {
-        enemy.update(deltaTime, gameData);
-      }
-    }
-    // Iterate using index to allow modification (finding enemy by ID)
-    for (int i = 0; i < gameData.activeProjectiles.size(); ++i) {
-      Projectile &proj = gameData.activeProjectiles[i]; // Use reference
-
-      if (proj.isActive) {
-        // Update projectile movement & check for hit
-        if (proj.update(deltaTime, gameData)) { // Pass gameData for homing
-          // --- PROJECTILE HIT ---
-          proj.isActive = false; // Mark as inactive FIRST
-          SDL_Log("Projectile arrived/hit target (EnemyID: %d). Applying "
-                  "damage...",
-                  proj.targetEnemyId);
-
-          // Find the target enemy
-          Enemy *targetEnemy = nullptr;
-          // Prioritize homing target ID
-          if (proj.targetEnemyId != -1) {
-            for (auto &potentialTarget : gameData.enemies) {
-              if (potentialTarget.id == proj.targetEnemyId &&
-                  potentialTarget.health > 0) {
-                targetEnemy = &potentialTarget;
-                break;
-              }
-            }
-            if (!targetEnemy) {
-              SDL_Log("...Target Enemy ID %d not found or dead.",
-                      proj.targetEnemyId);
-            }
-          }
-
-          // If no homing target or homing target lost, check hit location
-          if (!targetEnemy) {
-            int hitTileX =
-                static_cast<int>(floor(proj.currentX / gameData.tileWidth));
-            int hitTileY =
-                static_cast<int>(floor(proj.currentY / gameData.tileHeight));
-            SDL_Log("...Checking for enemy at impact tile [%d,%d].", hitTileX,
-                    hitTileY);
-            for (auto &potentialTarget : gameData.enemies) {
-              if (potentialTarget.health > 0 && potentialTarget.x == hitTileX &&
-                  potentialTarget.y == hitTileY) {
-                targetEnemy = &potentialTarget;
-                SDL_Log("...Found enemy %d at impact tile.", targetEnemy->id);
-                break;
-              }
-            }
-          }
-
-          // Apply damage if a living target was found
-          if (targetEnemy != nullptr) { // Check if pointer is valid
-            targetEnemy->takeDamage(proj.damage);
-            // Log is now inside Enemy::takeDamage
-          } else {
-            SDL_Log("...No living enemy found at impact point/target ID. "
-                    "Damage not applied.");
-          }
-          // Projectile is now inactive and damage (if any) applied.
-          // It will be removed later.
-        }
-        // else: Projectile still moving, do nothing else this frame
-      } // End if proj.isActive
-    } // End projectile update loop
-    gameData.activeProjectiles.erase(
-        std::remove_if(gameData.activeProjectiles.begin(),
-                       gameData.activeProjectiles.end(),
-                       [](const Projectile &p) { return !p.isActive; }),
-        gameData.activeProjectiles.end());
-
-    SDL_Log("DEBUG: Entered Resolution_Update Check");
-
-    if (isResolutionComplete(gameData)) {
-      SDL_Log("DEBUG: [UpdateLogic] Movement Resolution Complete. "
-              "Transitioning to TurnEnd_ApplyEffects.");
-
-      SDL_Log("DEBUG: Resolution IS Complete");
-
-      // *** END TIMING Resolution_Update ***
-      if (resolutionStartTime > 0) { // Ensure timer was started
-        phaseEndTime = SDL_GetTicks();
-        elapsedMs = phaseEndTime - resolutionStartTime;
-        SDL_Log("INFO: --- Phase Resolution_Update Took: %u ms ---", elapsedMs);
-        resolutionStartTime = 0; // Reset timer
-      }
-      // ***
-
+    if (resolveTurn(gameData, deltaTime) == TaskStatus::Done) {
       SDL_Log("--- Resolution Complete. Transitioning to Turn End Apply "
               "Effects ---");
       gameData.currentPhase = TurnPhase::TurnEnd_ApplyEffects;
@@ -1857,6 +1470,15 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
 
   case TurnPhase::TurnEnd_ApplyEffects:
     SDL_Log("--- Phase: Turn End Apply Effects ---");
+    // The player leaves scent where they stand, and footsteps are heard
+    gameData.scentMap.deposit(gameData.currentGamePlayer.targetTileX,
+                              gameData.currentGamePlayer.targetTileY, 1.0f,
+                              gameData.turnNumber);
+    if (gameData.playerIntendedAction.type == ActionType::Move) {
+      emitNoise(gameData, gameData.currentGamePlayer.targetTileX,
+                gameData.currentGamePlayer.targetTileY,
+                gameData.playerStepNoiseRadius);
+    }
     SDL_Log("DEBUG: [UpdateLogic] Transitioning from TurnEnd_ApplyEffects to "
             "TurnEnd_Cleanup.");
     gameData.currentPhase = TurnPhase::TurnEnd_Cleanup;
@@ -1868,75 +1490,90 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
     SDL_Log("DEBUG: [UpdateLogic] Entering TurnEnd_Cleanup phase.");
     bool playerDied = gameData.currentGamePlayer.health <= 0;
     int arcanaGained = 0;
-    gameData.enemies.erase(
-        std::remove_if(
-            gameData.enemies.begin(), gameData.enemies.end(),
-            [&](const Enemy &e) {
-              if (e.health <= 0) {
-                SDL_Log("Cleaning up dead enemy %d at [%d,%d].", e.id, e.x,
-                        e.y);
-                arcanaGained += e.arcanaValue;
-
-                // --- *** NEW: Crystal Drop Logic *** ---
-                if ((rand() % 100) < gameData.crystalDropChancePercent) {
-                  ItemType dropType;
-                  std::string textureKey;
-                  // Determine crystal type (Health or Mana)
-                  if ((rand() % 100) < gameData.healthCrystalChancePercent) {
-                    dropType = ItemType::HealthCrystal;
-                    textureKey = "health_crystal_texture"; // Use consistent key
-                    SDL_Log(
-                        "INFO: Enemy %d dropped a Health Crystal at [%d,%d].",
+    gameData.enemies.eraseIf(
+        [&](const Enemy &e) {
+          if (e.health <= 0) {
+            SDL_Log("Cleaning up dead enemy %d at [%d,%d].", e.id, e.x,
+                    e.y);
+            arcanaGained += e.arcanaValue;
+
+            // --- *** NEW: Crystal Drop Logic *** ---
+            if ((rand() % 100) < gameData.crystalDropChancePercent) {
+              ItemType dropType;
+              std::string textureKey;
+              // Determine crystal type (Health or Mana)
+              if ((rand() % 100) < gameData.healthCrystalChancePercent) {
+                dropType = ItemType::HealthCrystal;
+                textureKey = "health_crystal_texture"; // Use consistent key
+                SDL_Log(
+                    "INFO: Enemy %d dropped a Health Crystal at [%d,%d].",
+                    e.id, e.x, e.y);
+              } else {
+                dropType = ItemType::ManaCrystal;
+                textureKey = "mana_crystal_texture"; // Use consistent key
+                SDL_Log("INFO: Enemy %d dropped a Mana Crystal at [%d,%d].",
                         e.id, e.x, e.y);
-                  } else {
-                    dropType = ItemType::ManaCrystal;
-                    textureKey = "mana_crystal_texture"; // Use consistent key
-                    SDL_Log("INFO: Enemy %d dropped a Mana Crystal at [%d,%d].",
-                            e.id, e.x, e.y);
-                  }
-
-                  // Create the ItemDrop object
-                  ItemDrop newItem;
-                  newItem.x = e.x; // Drop at enemy's location
-                  newItem.y = e.y;
-                  newItem.type = dropType;
-                  newItem.textureName = textureKey;
-
-                  // Add to the game's list of dropped items
-                  gameData.droppedItems.push_back(newItem);
-                }
-                // --- *** END Crystal Drop Logic *** ---
-
-                if (isWithinBounds(e.x, e.y, gameData.currentLevel.width,
-                                   gameData.currentLevel.height)) {
-                  if (gameData.occupationGrid[e.y][e.x]) {
-                    gameData.occupationGrid[e.y][e.x] = false;
-                  } else {
-                    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                                "Attempted to clear unoccupied grid "
-                                "cell [%d,%d] for dead enemy %d.",
-                                e.x, e.y, e.id);
-                  }
-                }
-                return true;
               }
-              return false;
-            }),
-        gameData.enemies.end());
+
+              // Create the ItemDrop object
+              ItemDrop newItem;
+              newItem.x = e.x; // Drop at enemy's location
+              newItem.y = e.y;
+              newItem.type = dropType;
+              newItem.textureName = textureKey;
+              newItem.spriteId = internAssetName(textureKey);
+
+              // Add to the game's list of dropped items
+              gameData.droppedItems.push_back(newItem);
+              gameData.spatialGrid.insert(
+                  {SpatialKind::Item,
+                   static_cast<uint32_t>(gameData.droppedItems.size() - 1), 0},
+                  newItem.x, newItem.y);
+            }
+            // --- *** END Crystal Drop Logic *** ---
+
+            // An enemy killed mid-move already holds its destination
+            int heldX = e.isMoving ? e.targetTileX : e.x;
+            int heldY = e.isMoving ? e.targetTileY : e.y;
+            if (gameData.occupancy.enemyAt(heldX, heldY) == e.handle) {
+              gameData.occupancy.vacate(heldX, heldY);
+              gameData.spatialGrid.remove({SpatialKind::Enemy, e.handle.slot,
+                                           e.handle.generation},
+                                          heldX, heldY);
+            } else {
+              SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                          "Dead enemy %d does not hold grid cell [%d,%d].",
+                          e.id, heldX, heldY);
+            }
+            forgetEnemyInfluence(gameData, e);
+            gameData.enemySlots.erase(e.handle);
+            const EnemyArchetype &archetype = e.archetype();
+            addDecal(gameData, DecalType::Remains,
+                     (heldX + 0.5f) * gameData.tileWidth,
+                     (heldY + 0.5f) * gameData.tileHeight,
+                     {archetype.tintR, archetype.tintG, archetype.tintB, 255});
+            return true;
+          }
+          return false;
+        });
+    syncEnemySlots(gameData); // Survivors moved down; keep handles valid
     if (arcanaGained > 0)
       gameData.currentGamePlayer.GainArcana(arcanaGained);
+    size_t projectilesBefore = gameData.activeProjectiles.size();
     gameData.activeProjectiles.erase(
         std::remove_if(gameData.activeProjectiles.begin(),
                        gameData.activeProjectiles.end(),
                        [](const Projectile &p) { return !p.isActive; }),
         gameData.activeProjectiles.end());
+    if (gameData.activeProjectiles.size() != projectilesBefore)
+      syncSpatialProjectiles(gameData);
     if (playerDied) {
       SDL_Log("--- Game Over ---");
       currentAppState = AppState::MainMenu;
       break;
     } // Go back to menu on death
     // *** INSERT REINFORCEMENT LOGIC HERE ***
-    if (gameData.enemies.size() < gameData.maxEnemyCount &&
+    if (static_cast<int>(gameData.enemies.size()) < gameData.maxEnemyCount &&
         gameData.spawnChancePercent > 0 && !gameData.levelRooms.empty()) {
       if ((rand() % 100) < gameData.spawnChancePercent) {
         SDL_Log("Attempting to spawn reinforcement...");
@@ -1957,13 +1594,14 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
           if (isWithinBounds(potentialX, potentialY,
                              gameData.currentLevel.width,
                              gameData.currentLevel.height)) {
-            bool occupied = gameData.occupationGrid[potentialY][potentialX];
+            bool occupied = gameData.occupancy.isBlocked(potentialX, potentialY);
             bool isPlayerPos =
                 (potentialX == gameData.currentGamePlayer.targetTileX &&
                  potentialY == gameData.currentGamePlayer.targetTileY);
             float visibility =
-                (potentialY < gameData.visibilityMap.size() &&
-                 potentialX < gameData.visibilityMap[potentialY].size())
+                (potentialY < static_cast<int>(gameData.visibilityMap.size()) &&
+                 potentialX < static_cast<int>(
+                                  gameData.visibilityMap[potentialY].size()))
                     ? gameData.visibilityMap[potentialY][potentialX]
                     : 0.0f;
             bool isVisible = (visibility > 0.0f);
@@ -1981,12 +1619,18 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
           int spawnX = spawnPos.first;
           int spawnY = spawnPos.second;
           int newId = Enemy::getNextId(); // Get unique ID
-          // Add new enemy (e.g., always Slime for now)
-          gameData.enemies.emplace_back(newId, EnemyType::SLIME, spawnX, spawnY,
-                                        gameData.tileWidth,
-                                        gameData.tileHeight);
-          // Mark occupation grid immediately
-          gameData.occupationGrid[spawnY][spawnX] = true;
+          // Add new enemy, type weighted by archetype spawnWeight
+          gameData.enemies.emplace_back(newId, pickEnemySpawnType(rand()),
+                                        spawnX, spawnY);
+          syncEnemySlots(gameData); // Give the newcomer a handle
+          scheduleEnemy(gameData, gameData.enemies.back());
+          // Mark occupancy immediately
+          gameData.occupancy.place(spawnX, spawnY,
+                                   Occupant::forEnemy(gameData.enemies.back().handle));
+          gameData.spatialGrid.insert({SpatialKind::Enemy,
+                                       gameData.enemies.back().handle.slot,
+                                       gameData.enemies.back().handle.generation},
+                                      spawnX, spawnY);
 
           if (!gameData.enemies.empty()) {
             gameData.enemies.back().applyFloorScaling(
@@ -2004,8 +1648,6 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
           SDL_Log("Reinforcement (Enemy %d) spawned at [%d, %d]. Total "
                   "enemies: %zu",
                   newId, spawnX, spawnY, gameData.enemies.size());
-          // Resize intended actions vector for the new enemy next turn
-          gameData.enemyIntendedActions.resize(gameData.enemies.size());
         } else {
           SDL_Log("No valid spawn location found for reinforcement after %d "
                   "attempts.",
@@ -2017,6 +1659,8 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
     gameData.playerIntendedAction = {};
     gameData.enemyIntendedActions.clear();
     gameData.currentGamePlayer.RegenerateMana(1.0f);
+    gameData.turnNumber++; // Stimulus maps fade by turn
+    updateInfluenceMaps(gameData); // Threat overlay for the coming input phase
     SDL_Log("--- Turn End. Transitioning to Player Input for Next Turn ---");
     SDL_Log("DEBUG: [UpdateLogic] Transitioning from TurnEnd_Cleanup to "
             "Planning_PlayerInput.");
@@ -2029,49 +1673,205 @@ void updateLogic(GameData &gameData, AssetManager &assets, float deltaTime) {
 }
 
 // --- Helper function to check if the Resolution phase is complete ---
-bool isResolutionComplete(const GameData &gameData) {
-  if (gameData.currentGamePlayer.isMoving)
-    return false;
+// Counts one move or projectile of this turn's resolution as finished.
+static void finishResolutionStep(GameData &gameData) {
+  if (gameData.pendingResolutions > 0) {
+    gameData.pendingResolutions--;
+  } else {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "Resolution step finished with nothing pending.");
+  }
+}
+
+// One frame of resolution: advances this turn's moves and projectiles and
+// applies projectile hits. Each one that finishes counts itself off.
+// updateLogic has already animated the player and full-activity enemies this
+// frame, so a move may have ended there; whichever update ended it, it's
+// counted off here.
+static void advanceResolutionFrame(GameData &gameData, float deltaTime) {
+  if (gameData.playerMovePending && !gameData.currentGamePlayer.isMoving) {
+    gameData.playerMovePending = false;
+    finishResolutionStep(gameData); // Player's move completed
+  }
+  // Only this turn's movers, not every enemy on the floor
+  std::vector<EnemyHandle> &movers = gameData.animatingEnemies;
+  for (size_t m = 0; m < movers.size();) {
+    Enemy *enemy = findEnemy(gameData, movers[m]);
+    if (enemy != nullptr && enemy->health > 0 && enemy->isMoving &&
+        enemy->activityTier != ActivityTier::Full) {
+      // Not animated by updateLogic
+      enemy->update(deltaTime, gameData.enemies.presentationOf(*enemy));
+    }
+    if (enemy == nullptr || enemy->health <= 0 || !enemy->isMoving) {
+      finishResolutionStep(gameData); // Arrived, or died on the way
+      movers[m] = movers.back();
+      movers.pop_back();
+    } else {
+      ++m;
+    }
+  }
+  // Iterate using index to allow modification (finding enemy by ID)
+  for (int i = 0; i < static_cast<int>(gameData.activeProjectiles.size());
+       ++i) {
+    Projectile &proj = gameData.activeProjectiles[i]; // Use reference
+
+    if (proj.isActive) {
+      // Update projectile movement & check for hit
+      int oldTileX =
+          static_cast<int>(floor(proj.currentX / gameData.tileWidth));
+      int oldTileY =
+          static_cast<int>(floor(proj.currentY / gameData.tileHeight));
+      bool hit = proj.update(deltaTime, gameData); // Pass gameData for homing
+      gameData.spatialGrid.move(
+          {SpatialKind::Projectile, static_cast<uint32_t>(i), 0}, oldTileX,
+          oldTileY, static_cast<int>(floor(proj.currentX / gameData.tileWidth)),
+          static_cast<int>(floor(proj.currentY / gameData.tileHeight)));
+      if (!proj.isActive) {
+        finishResolutionStep(gameData); // Landed, or lost its target
+      }
+      if (hit) {
+        // --- PROJECTILE HIT ---
+        proj.isActive = false; // Mark as inactive FIRST
+        SDL_Log("Projectile arrived/hit target (enemy slot: %d). Applying "
+                "damage...",
+                proj.targetEnemy.isValid() ? (int)proj.targetEnemy.slot : -1);
+
+        if (proj.targetsPlayer) {
+          // Enemy spit: always lands on the player it homed on
+          gameData.currentGamePlayer.takeDamage(proj.damage);
+          addDecal(gameData, DecalType::Blood, proj.currentX, proj.currentY);
+          continue;
+        }
+
+        // Find the target enemy
+        Enemy *targetEnemy = nullptr;
+        // Prioritize homing target
+        if (proj.targetEnemy.isValid()) {
+          targetEnemy = findEnemy(gameData, proj.targetEnemy);
+          if (targetEnemy && targetEnemy->health <= 0)
+            targetEnemy = nullptr;
+          if (!targetEnemy) {
+            SDL_Log("...Target enemy (slot %u) not found or dead.",
+                    proj.targetEnemy.slot);
+          }
+        }
+
+        int hitTileX =
+            static_cast<int>(floor(proj.currentX / gameData.tileWidth));
+        int hitTileY =
+            static_cast<int>(floor(proj.currentY / gameData.tileHeight));
+        // The impact is heard around where it lands, and leaves a mark
+        emitNoise(gameData, hitTileX, hitTileY, gameData.noiseWakeRadius);
+        addDecal(gameData, DecalType::Scorch, proj.currentX, proj.currentY);
+
+        // If no homing target or homing target lost, check hit location
+        if (!targetEnemy) {
+          SDL_Log("...Checking for enemy at impact tile [%d,%d].", hitTileX,
+                  hitTileY);
+          Enemy *tileOccupant = findEnemy(
+              gameData, gameData.occupancy.enemyAt(hitTileX, hitTileY));
+          if (tileOccupant != nullptr && tileOccupant->health > 0) {
+            targetEnemy = tileOccupant;
+            SDL_Log("...Found enemy %d at impact tile.", targetEnemy->id);
+          }
+        }
+
+        // Apply damage if a living target was found
+        if (targetEnemy != nullptr) { // Check if pointer is valid
+          targetEnemy->takeDamage(proj.damage);
+          // Log is now inside Enemy::takeDamage
+        } else {
+          SDL_Log("...No living enemy found at impact point/target ID. "
+                  "Damage not applied.");
+        }
+        // Projectile is now inactive and damage (if any) applied.
+        // It will be removed later.
+      }
+      // else: Projectile still moving, do nothing else this frame
+    } // End if proj.isActive
+  } // End projectile update loop
+  size_t projectilesBefore = gameData.activeProjectiles.size();
+  gameData.activeProjectiles.erase(
+      std::remove_if(gameData.activeProjectiles.begin(),
+                     gameData.activeProjectiles.end(),
+                     [](const Projectile &p) { return !p.isActive; }),
+      gameData.activeProjectiles.end());
+  if (gameData.activeProjectiles.size() != projectilesBefore)
+    syncSpatialProjectiles(gameData); // Survivors moved down
+}
+
+// Slow path for the watchdog: rescans everything that can hold the turn open.
+static int countUnfinishedResolutions(const GameData &gameData) {
+  int unfinished = gameData.currentGamePlayer.isMoving ? 1 : 0;
   for (const auto &enemy : gameData.enemies) {
     if (enemy.health > 0 && enemy.isMoving)
-      return false;
+      unfinished++;
   }
   for (const auto &proj : gameData.activeProjectiles) {
     if (proj.isActive)
-      return false;
+      unfinished++;
+  }
+  return unfinished;
+}
+
+// If the counter has been stuck for this long, trust a full rescan instead.
+static const Uint32 RESOLUTION_WATCHDOG_MS = 5000;
+
+static void checkResolutionWatchdog(GameData &gameData) {
+  Uint32 elapsed = SDL_GetTicks() - gameData.phaseTimers.resolutionWatchdog;
+  if (elapsed < RESOLUTION_WATCHDOG_MS)
+    return;
+  int unfinished = countUnfinishedResolutions(gameData);
+  if (unfinished != gameData.pendingResolutions) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Resolution counter stuck at %d after %u ms, but %d steps "
+                 "are unfinished. Resyncing.",
+                 gameData.pendingResolutions, elapsed, unfinished);
+    gameData.pendingResolutions = unfinished;
+    gameData.playerMovePending = gameData.currentGamePlayer.isMoving;
+  }
+  gameData.phaseTimers.resolutionWatchdog = SDL_GetTicks();
+}
+
+// Turn resolution as a resumable task: runs a frame of animation and
+// projectiles per call until everything started in Resolution_Start has
+// counted itself off. Finishing is an O(1) check of the counter.
+TaskStatus resolveTurn(GameData &gameData, float deltaTime) {
+  TaskState &task = gameData.resolutionTask;
+  TASK_BEGIN(task);
+  gameData.phaseTimers.resolutionStart = SDL_GetTicks();
+  gameData.phaseTimers.resolutionWatchdog = gameData.phaseTimers.resolutionStart;
+
+  while (gameData.pendingResolutions > 0) {
+    advanceResolutionFrame(gameData, deltaTime);
+    if (gameData.pendingResolutions > 0) {
+      checkResolutionWatchdog(gameData);
+      TASK_YIELD(task);
+    }
   }
-  return true;
+  // The last frame can still leave spent projectiles behind
+  advanceResolutionFrame(gameData, 0.0f);
+
+  SDL_Log("INFO: --- Resolution Took: %u ms ---",
+          SDL_GetTicks() - gameData.phaseTimers.resolutionStart);
+  TASK_END(task);
 }
 
 // --- Rewritten renderScene Function ---
 void renderScene(GameData &gameData, AssetManager &assets) {
-  // --- Render Level Tiles ---
-  if (gameData.currentLevel.width > 0 && gameData.currentLevel.height > 0 &&
-      !gameData.currentLevel.tiles.empty() && gameData.tileWidth > 0 &&
+  // World sprites are queued in any order, then sorted by layer and depth
+  // and batched; the queue is flushed before the UI
+  SpriteBatcher &batcher = gameData.spriteBatcher;
+  RenderQueue &queue = gameData.renderQueue;
+  batcher.begin(gameData.renderer);
+  queue.clear();
+
+  // --- Render Level Tiles (cached chunks plus the fog layer) ---
+  gameData.terrainCache.draw(gameData, assets, queue);
+
+  // --- Threat Overlay: tiles enemies can attack next turn ---
+  if (gameData.showThreatOverlay && gameData.tileWidth > 0 &&
       gameData.tileHeight > 0) {
-    SDL_Texture *wallTexture = assets.getTexture("wall_texture");
-    SDL_Texture *startTexture = assets.getTexture("start_tile");
-    SDL_Texture *exitTexture = assets.getTexture("exit_tile");
-    std::vector<SDL_Texture *> floorTextures = {assets.getTexture("floor_1"),
-                                                assets.getTexture("floor_2")};
-    floorTextures.erase(
-        std::remove(floorTextures.begin(), floorTextures.end(), nullptr),
-        floorTextures.end());
-    std::vector<double> floorWeights = {3.0, 7.0};
-    if (floorWeights.size() != floorTextures.size() && !floorTextures.empty()) {
-      floorWeights.assign(floorTextures.size(), 1.0);
-    }
-    double totalWeight = 0;
-    for (double w : floorWeights)
-      totalWeight += w;
-    std::vector<double> cumulativeWeights;
-    double currentCumulative = 0;
-    if (totalWeight > 0) {
-      for (size_t i = 0; i < floorWeights.size(); ++i) {
-        currentCumulative += floorWeights[i];
-        cumulativeWeights.push_back(currentCumulative / totalWeight);
-      }
-    }
     int startTileX = std::max(0, gameData.cameraX / gameData.tileWidth);
     int startTileY = std::max(0, gameData.cameraY / gameData.tileHeight);
     int endTileX = std::min(
@@ -2082,95 +1882,60 @@ void renderScene(GameData &gameData, AssetManager &assets) {
         (gameData.cameraY + gameData.windowHeight) / gameData.tileHeight + 1);
     for (int y = startTileY; y < endTileY; ++y) {
       for (int x = startTileX; x < endTileX; ++x) {
-        if (!isWithinBounds(x, y, gameData.currentLevel.width,
-                            gameData.currentLevel.height) ||
-            y >= (int)gameData.visibilityMap.size() ||
-            x >= (int)gameData.visibilityMap[y].size())
+        int threat = gameData.enemyThreat.at(x, y);
+        if (threat <= 0 || y >= (int)gameData.visibilityMap.size() ||
+            x >= (int)gameData.visibilityMap[y].size() ||
+            gameData.visibilityMap[y][x] <= 0.0f)
           continue;
-        SDL_Rect tileRect = {(x * gameData.tileWidth) - gameData.cameraX,
-                             (y * gameData.tileHeight) - gameData.cameraY,
-                             gameData.tileWidth, gameData.tileHeight};
-        float visibility = gameData.visibilityMap[y][x];
-        if (visibility > 0.0f) {
-          SDL_Texture *textureToRender = nullptr;
-          bool isFloor = false;
-          if (y >= (int)gameData.currentLevel.tiles.size() ||
-              x >= (int)gameData.currentLevel.tiles[y].size())
-            continue;
-          char currentTileType = gameData.currentLevel.tiles[y][x];
-          if (y == gameData.currentLevel.startRow &&
-              x == gameData.currentLevel.startCol && startTexture)
-            textureToRender = startTexture;
-          else if (y == gameData.currentLevel.endRow &&
-                   x == gameData.currentLevel.endCol && exitTexture)
-            textureToRender = exitTexture;
-          else if (currentTileType == '#' && wallTexture)
-            textureToRender = wallTexture;
-          else if (currentTileType == '.')
-            isFloor = true;
-          if (isFloor && !floorTextures.empty() && totalWeight > 0 &&
-              !cumulativeWeights.empty()) {
-            unsigned int hash = ((unsigned int)x * 2654435761u) ^
-                                ((unsigned int)y * 3063691763u);
-            double hashValue = (double)(hash % 10000) / 10000.0;
-            for (size_t i = 0; i < cumulativeWeights.size(); ++i)
-              if (hashValue <= cumulativeWeights[i]) {
-                textureToRender = floorTextures[i];
-                break;
-              }
-            if (!textureToRender)
-              textureToRender = floorTextures[0];
-          } else if (isFloor)
-            textureToRender = nullptr;
-          if (textureToRender != nullptr)
-            SDL_RenderCopy(gameData.renderer, textureToRender, nullptr,
-                           &tileRect);
-          else {
-            Uint8 r = 50, g = 50, b = 50;
-            if (currentTileType == '#') {
-              r = 139;
-              g = 69;
-              b = 19;
-            } else if (currentTileType == '.') {
-              r = 100;
-              g = 100;
-              b = 100;
-            }
-            SDL_SetRenderDrawColor(gameData.renderer, r, g, b, 255);
-            SDL_RenderFillRect(gameData.renderer, &tileRect);
-          }
-          Uint8 alpha = static_cast<Uint8>((1.0f - visibility) * 200);
-          SDL_SetRenderDrawBlendMode(gameData.renderer, SDL_BLENDMODE_BLEND);
-          SDL_SetRenderDrawColor(gameData.renderer, 0, 0, 0, alpha);
-          SDL_RenderFillRect(gameData.renderer, &tileRect);
-          SDL_SetRenderDrawBlendMode(gameData.renderer, SDL_BLENDMODE_NONE);
-        } else {
-          SDL_SetRenderDrawColor(gameData.renderer, 0, 0, 0, 255);
-          SDL_RenderFillRect(gameData.renderer, &tileRect);
-        }
+        SDL_FRect tileRect = {
+            static_cast<float>((x * gameData.tileWidth) - gameData.cameraX),
+            static_cast<float>((y * gameData.tileHeight) - gameData.cameraY),
+            static_cast<float>(gameData.tileWidth),
+            static_cast<float>(gameData.tileHeight)};
+        // Deeper red where more enemies can reach
+        Uint8 alpha = static_cast<Uint8>(std::min(50 + 30 * threat, 170));
+        queue.fillRect(RenderLayer::GroundOverlay, 0.0f, tileRect,
+                       {200, 30, 30, alpha});
       }
-    } // End x, y loops
-  } // End level rendering check
+    }
+  }
+
+  // --- Dynamic objects near the camera (see SpatialGrid) ---
+  std::vector<SpatialEntry> &nearby = gameData.visibleObjects;
+  nearby.clear();
+  if (gameData.tileWidth > 0 && gameData.tileHeight > 0) {
+    // A tile of slack for enemies drawn mid-step and sprites wider than a tile
+    gameData.spatialGrid.query(
+        gameData.cameraX / gameData.tileWidth - 1,
+        gameData.cameraY / gameData.tileHeight - 1,
+        (gameData.cameraX + gameData.windowWidth) / gameData.tileWidth + 1,
+        (gameData.cameraY + gameData.windowHeight) / gameData.tileHeight + 1,
+        nearby);
+  }
 
   // --- *** NEW: Render Dropped Items *** ---
-  for (const auto &item : gameData.droppedItems) {
+  for (const SpatialEntry &entry : nearby) {
+    if (entry.kind != SpatialKind::Item ||
+        entry.id >= gameData.droppedItems.size())
+      continue;
+    const ItemDrop &item = gameData.droppedItems[entry.id];
     // Check visibility of the item's tile
     float visibility = 0.0f;
     if (isWithinBounds(item.x, item.y, gameData.currentLevel.width,
                        gameData.currentLevel.height) &&
-        item.y < gameData.visibilityMap.size() &&
-        item.x < gameData.visibilityMap[item.y].size()) {
+        item.y < static_cast<int>(gameData.visibilityMap.size()) &&
+        item.x < static_cast<int>(gameData.visibilityMap[item.y].size())) {
       visibility = gameData.visibilityMap[item.y][item.x];
     }
 
     if (visibility > 0.0f) { // Only render if the tile is visible
-      SDL_Texture *itemTexture = assets.getTexture(item.textureName);
+      const AtlasSprite *itemTexture = assets.getSprite(item.spriteId);
       if (itemTexture) {
-        SDL_Rect itemRect = {
-            (item.x * gameData.tileWidth) - gameData.cameraX,
-            (item.y * gameData.tileHeight) - gameData.cameraY,
-            gameData.tileWidth / 2, // Smaller size for item? Adjust as needed
-            gameData.tileHeight / 2 // Smaller size for item? Adjust as needed
+        SDL_FRect itemRect = {
+            static_cast<float>((item.x * gameData.tileWidth) - gameData.cameraX),
+            static_cast<float>((item.y * gameData.tileHeight) - gameData.cameraY),
+            static_cast<float>(gameData.tileWidth / 2), // Smaller size for item? Adjust as needed
+            static_cast<float>(gameData.tileHeight / 2) // Smaller size for item? Adjust as needed
         };
         // Center the smaller item texture within the tile visually
         itemRect.x += gameData.tileWidth / 4;
@@ -2178,27 +1943,18 @@ void renderScene(GameData &gameData, AssetManager &assets) {
 
         // Apply visibility alpha
         Uint8 alpha = static_cast<Uint8>(visibility * 255);
-        SDL_SetTextureAlphaMod(itemTexture, alpha);
-        SDL_SetTextureBlendMode(itemTexture,
-                                SDL_BLENDMODE_BLEND); // Ensure blending
-
-        SDL_RenderCopy(gameData.renderer, itemTexture, nullptr, &itemRect);
-
-        // Reset alpha/blend mode if other things rely on defaults
-        SDL_SetTextureAlphaMod(itemTexture, 255); // Reset alpha for next use
-        // SDL_SetTextureBlendMode(itemTexture, SDL_BLENDMODE_NONE); // Usually
-        // not needed to reset blend
+        queue.sprite(RenderLayer::Actors, itemRect.y + itemRect.h,
+                     *itemTexture, itemRect, {255, 255, 255, alpha});
 
       } else {
-        // Optional: Render a fallback if texture is missing
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                    "Item texture '%s' not found!", item.textureName.c_str());
-        SDL_Rect fallbackRect = {(item.x * gameData.tileWidth) -
-                                     gameData.cameraX + gameData.tileWidth / 4,
-                                 (item.y * gameData.tileHeight) -
-                                     gameData.cameraY + gameData.tileHeight / 4,
-                                 gameData.tileWidth / 2,
-                                 gameData.tileHeight / 2};
+        // Fallback if texture is missing (getSprite reported it once)
+        SDL_FRect fallbackRect = {
+            static_cast<float>((item.x * gameData.tileWidth) -
+                               gameData.cameraX + gameData.tileWidth / 4),
+            static_cast<float>((item.y * gameData.tileHeight) -
+                               gameData.cameraY + gameData.tileHeight / 4),
+            static_cast<float>(gameData.tileWidth / 2),
+            static_cast<float>(gameData.tileHeight / 2)};
         Uint8 r = 255, g = 255, b = 0; // Yellow fallback
         if (item.type == ItemType::HealthCrystal) {
           r = 255;
@@ -2213,10 +1969,8 @@ void renderScene(GameData &gameData, AssetManager &assets) {
 
         Uint8 alpha =
             static_cast<Uint8>(visibility * 128); // Dimmer fallback alpha
-        SDL_SetRenderDrawBlendMode(gameData.renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(gameData.renderer, r, g, b, alpha);
-        SDL_RenderFillRect(gameData.renderer, &fallbackRect);
-        SDL_SetRenderDrawBlendMode(gameData.renderer, SDL_BLENDMODE_NONE);
+        queue.fillRect(RenderLayer::Actors, fallbackRect.y + fallbackRect.h,
+                       fallbackRect, {r, g, b, alpha});
       }
     }
   }
@@ -2229,26 +1983,26 @@ void renderScene(GameData &gameData, AssetManager &assets) {
         // Check visibility of the pedestal's tile
         float visibility = 0.0f;
         if (isWithinBounds(pedestal.x, pedestal.y, gameData.currentLevel.width, gameData.currentLevel.height) &&
-            pedestal.y < gameData.visibilityMap.size() && pedestal.x < gameData.visibilityMap[pedestal.y].size()) {
+            pedestal.y < static_cast<int>(gameData.visibilityMap.size()) && pedestal.x < static_cast<int>(gameData.visibilityMap[pedestal.y].size())) {
             visibility = gameData.visibilityMap[pedestal.y][pedestal.x];
         }
 
         if (visibility > 0.0f && pedestal.isActive) { // Only render if visible and active
             // Get the correct frame texture
-            SDL_Texture* pedestalTexture = nullptr;
-            if (!pedestal.frameTextureNames.empty() &&
+            const AtlasSprite* pedestalTexture = nullptr;
+            if (!pedestal.frameIds.empty() &&
                 pedestal.currentFrame >= 0 &&
-                pedestal.currentFrame < pedestal.frameTextureNames.size())
+                pedestal.currentFrame < static_cast<int>(pedestal.frameIds.size()))
             {
-                pedestalTexture = assets.getTexture(pedestal.frameTextureNames[pedestal.currentFrame]);
+                pedestalTexture = assets.getSprite(pedestal.frameIds[pedestal.currentFrame]);
             }
 
             if (pedestalTexture) {
-                SDL_Rect pedestalRect = {
-                    (pedestal.x * gameData.tileWidth) - gameData.cameraX,
-                    (pedestal.y * gameData.tileHeight) - gameData.cameraY,
-                    gameData.tileWidth, // Render pedestal at full tile size? Adjust if needed
-                    gameData.tileHeight
+                SDL_FRect pedestalRect = {
+                    static_cast<float>((pedestal.x * gameData.tileWidth) - gameData.cameraX),
+                    static_cast<float>((pedestal.y * gameData.tileHeight) - gameData.cameraY),
+                    static_cast<float>(gameData.tileWidth), // Render pedestal at full tile size? Adjust if needed
+                    static_cast<float>(gameData.tileHeight)
                 };
                 // Adjust position if pedestal graphic isn't exactly tile-sized (e.g., center it)
                 // Example: If pedestal gfx is smaller and needs centering:
@@ -2262,37 +2016,33 @@ void renderScene(GameData &gameData, AssetManager &assets) {
 
                 // Apply visibility alpha
                 Uint8 alpha = static_cast<Uint8>(visibility * 255);
-                SDL_SetTextureAlphaMod(pedestalTexture, alpha);
-                SDL_SetTextureBlendMode(pedestalTexture, SDL_BLENDMODE_BLEND); // Ensure blending
-
-                SDL_RenderCopy(gameData.renderer, pedestalTexture, nullptr, &pedestalRect);
-
-                // Reset alpha/blend mode if needed
-                SDL_SetTextureAlphaMod(pedestalTexture, 255);
+                queue.sprite(RenderLayer::Actors, pedestalRect.y + pedestalRect.h,
+                             *pedestalTexture, pedestalRect, {255, 255, 255, alpha});
 
             } else {
-                // Optional: Render a fallback if texture is missing for the current frame
-                 if (!pedestal.frameTextureNames.empty()) {
-                    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Pedestal texture '%s' (frame %d) not found!",
-                                pedestal.frameTextureNames[pedestal.currentFrame].c_str(), pedestal.currentFrame);
-                 } else {
+                // Fallback if the current frame is missing (getSprite reported it once)
+                 if (pedestal.frameIds.empty()) {
                      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Pedestal has no frame texture names defined!");
                  }
                  // Draw a simple placeholder (e.g., magenta square)
-                 SDL_Rect fallbackRect = {(pedestal.x * gameData.tileWidth) - gameData.cameraX,
-                                          (pedestal.y * gameData.tileHeight) - gameData.cameraY,
-                                          gameData.tileWidth, gameData.tileHeight};
+                 SDL_FRect fallbackRect = {static_cast<float>((pedestal.x * gameData.tileWidth) - gameData.cameraX),
+                                           static_cast<float>((pedestal.y * gameData.tileHeight) - gameData.cameraY),
+                                           static_cast<float>(gameData.tileWidth), static_cast<float>(gameData.tileHeight)};
                  Uint8 alpha = static_cast<Uint8>(visibility * 128);
-                 SDL_SetRenderDrawBlendMode(gameData.renderer, SDL_BLENDMODE_BLEND);
-                 SDL_SetRenderDrawColor(gameData.renderer, 255, 0, 255, alpha); // Magenta fallback
-                 SDL_RenderFillRect(gameData.renderer, &fallbackRect);
-                 SDL_SetRenderDrawBlendMode(gameData.renderer, SDL_BLENDMODE_NONE);
+                 queue.fillRect(RenderLayer::Actors, fallbackRect.y + fallbackRect.h,
+                                fallbackRect, {255, 0, 255, alpha}); // Magenta fallback
             }
         }
     }
 
   // --- Render Entities ---
-  for (const auto &enemy : gameData.enemies) {
+  for (const SpatialEntry &entry : nearby) {
+    if (entry.kind != SpatialKind::Enemy)
+      continue;
+    const Enemy *found = findEnemy(gameData, {entry.id, entry.generation});
+    if (!found)
+      continue;
+    const Enemy &enemy = *found;
     if (enemy.health > 0) {
       int ex = enemy.x;
       int ey = enemy.y;
@@ -2304,15 +2054,15 @@ void renderScene(GameData &gameData, AssetManager &assets) {
         vis = gameData.visibilityMap[ey][ex];
       }
       if (vis > 0.0f) {
-        enemy.render(gameData.renderer, assets, gameData.cameraX,
-                     gameData.cameraY, vis);
+        enemy.render(queue, assets, gameData.enemies.presentationOf(enemy),
+                     gameData.cameraX, gameData.cameraY, vis);
       }
     }
   }
 
   // --- Render Player ---
-  SDL_Texture *playerTexture = nullptr;
-  std::string textureKeyToUse;
+  const AtlasSprite *playerTexture = nullptr;
+  AssetId textureKeyToUse;
   bool isTargeting = gameData.showTargetingReticle; // Cache flags
   bool isPlayerMoving = gameData.currentGamePlayer.isMoving;
 
@@ -2321,35 +2071,36 @@ void renderScene(GameData &gameData, AssetManager &assets) {
     // --- Use Targeting Animation ---
     SDL_Log("DEBUG: [RenderPlayer] Player IS targeting. TargetFrames=%zu, "
             "CurrentTargetFrame=%d",
-            gameData.currentGamePlayer.targetingFrameTextureNames.size(),
+            gameData.currentGamePlayer.targetingFrameIds.size(),
             gameData.currentGamePlayer.currentTargetingFrame);
-    if (!gameData.currentGamePlayer.targetingFrameTextureNames.empty() &&
+    if (!gameData.currentGamePlayer.targetingFrameIds.empty() &&
         gameData.currentGamePlayer.currentTargetingFrame <
-            gameData.currentGamePlayer.targetingFrameTextureNames.size()) {
-      textureKeyToUse = gameData.currentGamePlayer.targetingFrameTextureNames
+            static_cast<int>(
+                gameData.currentGamePlayer.targetingFrameIds.size())) {
+      textureKeyToUse = gameData.currentGamePlayer.targetingFrameIds
                             [gameData.currentGamePlayer.currentTargetingFrame];
       SDL_Log("DEBUG: [RenderPlayer] Using TARGETING key: %s",
-              textureKeyToUse.c_str());
-    } else if (!gameData.currentGamePlayer.idleFrameTextureNames
+              assetNameOf(textureKeyToUse).c_str());
+    } else if (!gameData.currentGamePlayer.idleFrameIds
                     .empty()) { // Fallback to idle if targeting frames missing
-      textureKeyToUse = gameData.currentGamePlayer.idleFrameTextureNames[0];
+      textureKeyToUse = gameData.currentGamePlayer.idleFrameIds[0];
       SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                   "[RenderPlayer] Targeting frame invalid/missing, fallback to "
                   "IDLE key: %s",
-                  textureKeyToUse.c_str());
+                  assetNameOf(textureKeyToUse).c_str());
     }
 
   } else if (isPlayerMoving) {
     // Use Walking Animation
-    if (!gameData.currentGamePlayer.walkFrameTextureNames.empty() &&
+    if (!gameData.currentGamePlayer.walkFrameIds.empty() &&
         gameData.currentGamePlayer.currentWalkFrame <
-            gameData.currentGamePlayer.walkFrameTextureNames.size()) {
-      textureKeyToUse = gameData.currentGamePlayer.walkFrameTextureNames
+            static_cast<int>(gameData.currentGamePlayer.walkFrameIds.size())) {
+      textureKeyToUse = gameData.currentGamePlayer.walkFrameIds
                             [gameData.currentGamePlayer.currentWalkFrame];
-    } else if (!gameData.currentGamePlayer.idleFrameTextureNames.empty()) {
+    } else if (!gameData.currentGamePlayer.idleFrameIds.empty()) {
       // Fallback to first idle frame if walk frames are missing/invalid
-      textureKeyToUse = gameData.currentGamePlayer.idleFrameTextureNames[0];
-      if (gameData.currentGamePlayer.walkFrameTextureNames.empty()) {
+      textureKeyToUse = gameData.currentGamePlayer.idleFrameIds[0];
+      if (gameData.currentGamePlayer.walkFrameIds.empty()) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                     "Player is moving but has no walk frames defined!");
       }
@@ -2361,15 +2112,15 @@ void renderScene(GameData &gameData, AssetManager &assets) {
          gameData.currentPhase == TurnPhase::Planning_PlayerInput &&
          !gameData.showTargetingReticle); // Check idle conditions
     if (shouldAnimateIdle &&
-        !gameData.currentGamePlayer.idleFrameTextureNames.empty() &&
+        !gameData.currentGamePlayer.idleFrameIds.empty() &&
         gameData.currentGamePlayer.currentIdleFrame <
-            gameData.currentGamePlayer.idleFrameTextureNames.size()) {
-      textureKeyToUse = gameData.currentGamePlayer.idleFrameTextureNames
+            static_cast<int>(gameData.currentGamePlayer.idleFrameIds.size())) {
+      textureKeyToUse = gameData.currentGamePlayer.idleFrameIds
                             [gameData.currentGamePlayer.currentIdleFrame];
-    } else if (!gameData.currentGamePlayer.idleFrameTextureNames.empty()) {
+    } else if (!gameData.currentGamePlayer.idleFrameIds.empty()) {
       // Default to first idle frame if not animating idle or frames missing
-      textureKeyToUse = gameData.currentGamePlayer.idleFrameTextureNames[0];
-      if (gameData.currentGamePlayer.idleFrameTextureNames.empty()) {
+      textureKeyToUse = gameData.currentGamePlayer.idleFrameIds[0];
+      if (gameData.currentGamePlayer.idleFrameIds.empty()) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                     "Player is idle but has no idle frames defined!");
       }
@@ -2377,24 +2128,22 @@ void renderScene(GameData &gameData, AssetManager &assets) {
   }
 
   // Get the texture using the determined key
-  if (!textureKeyToUse.empty()) {
-    playerTexture = assets.getTexture(textureKeyToUse);
+  if (textureKeyToUse.isValid()) {
+    playerTexture = assets.getSprite(textureKeyToUse);
   }
   // --- END MODIFIED Frame Selection ---
 
   // Render the texture if found, otherwise use fallback
   if (playerTexture) {
-    SDL_Rect playerRect;
-    int texW, texH;
-    SDL_QueryTexture(playerTexture, NULL, NULL, &texW, &texH);
+    SDL_FRect playerRect;
     playerRect.w = 96; // Example fixed width
     playerRect.h = 96; // Example fixed height
-    playerRect.x =
+    playerRect.x = static_cast<float>(
         static_cast<int>(gameData.currentGamePlayer.x - playerRect.w / 2.0f) -
-        gameData.cameraX;
-    playerRect.y =
+        gameData.cameraX);
+    playerRect.y = static_cast<float>(
         static_cast<int>(gameData.currentGamePlayer.y - playerRect.h / 2.0f) -
-        gameData.cameraY;
+        gameData.cameraY);
 
     // <<< DETERMINE FLIP BASED ON FACING DIRECTION >>>
     SDL_RendererFlip flip = SDL_FLIP_NONE; // Default: no flip (facing left)
@@ -2403,33 +2152,24 @@ void renderScene(GameData &gameData, AssetManager &assets) {
       flip = SDL_FLIP_HORIZONTAL; // Flip horizontally if facing left
     }
 
-    // <<< USE SDL_RenderCopyEx WITH FLIP >>>
-    SDL_RenderCopyEx(gameData.renderer, playerTexture,
-                     nullptr,     // Source rect (entire texture)
-                     &playerRect, // Destination rect
-                     0.0,         // Angle (no rotation)
-                     nullptr,     // Center of rotation (not needed)
-                     flip);       // Apply flip
+    queue.sprite(RenderLayer::Actors, playerRect.y + playerRect.h,
+                 *playerTexture, playerRect, {255, 255, 255, 255}, flip);
 
   } else {
     // Fallback green rectangle
-    SDL_Rect playerRect;
-    playerRect.w = gameData.tileWidth / 2;
-    playerRect.h = gameData.tileHeight / 2;
-    playerRect.x =
+    SDL_FRect playerRect;
+    playerRect.w = static_cast<float>(gameData.tileWidth / 2);
+    playerRect.h = static_cast<float>(gameData.tileHeight / 2);
+    playerRect.x = static_cast<float>(
         static_cast<int>(gameData.currentGamePlayer.x - playerRect.w / 2.0f) -
-        gameData.cameraX;
-    playerRect.y =
+        gameData.cameraX);
+    playerRect.y = static_cast<float>(
         static_cast<int>(gameData.currentGamePlayer.y - playerRect.h / 2.0f) -
-        gameData.cameraY;
-    SDL_SetRenderDrawColor(gameData.renderer, 0, 255, 0, 255);
-    SDL_RenderFillRect(gameData.renderer, &playerRect);
-    // Logging for missing textures...
-    if (!gameData.currentGamePlayer.idleFrameTextureNames.empty() &&
-        !textureKeyToUse.empty()) {
-      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                  "Player texture '%s' not found!", textureKeyToUse.c_str());
-    } else if (gameData.currentGamePlayer.idleFrameTextureNames.empty()) {
+        gameData.cameraY);
+    queue.fillRect(RenderLayer::Actors, playerRect.y + playerRect.h,
+                   playerRect, {0, 255, 0, 255});
+    // A missing frame was already reported (once) by getSprite
+    if (gameData.currentGamePlayer.idleFrameIds.empty()) {
       SDL_LogWarn(
           SDL_LOG_CATEGORY_APPLICATION,
           "Player has no idle frame textures defined in character.cpp!");
@@ -2438,9 +2178,13 @@ void renderScene(GameData &gameData, AssetManager &assets) {
   // --- End Player Rendering ---
 
   // --- Render Projectiles ---
-  for (const auto &proj : gameData.activeProjectiles) {
+  for (const SpatialEntry &entry : nearby) {
+    if (entry.kind != SpatialKind::Projectile ||
+        entry.id >= gameData.activeProjectiles.size())
+      continue;
+    const Projectile &proj = gameData.activeProjectiles[entry.id];
     if (proj.isActive) {
-      proj.render(gameData.renderer, gameData.cameraX, gameData.cameraY);
+      proj.render(queue, assets, gameData.cameraX, gameData.cameraY);
     }
   }
 
@@ -2455,12 +2199,19 @@ void renderScene(GameData &gameData, AssetManager &assets) {
             (int)gameData.visibilityMap[gameData.targetIndicatorY].size() &&
         gameData.visibilityMap[gameData.targetIndicatorY]
                               [gameData.targetIndicatorX] > 0.0f) {
-      SDL_Rect reticleRect = {
-          (gameData.targetIndicatorX * gameData.tileWidth) - gameData.cameraX,
-          (gameData.targetIndicatorY * gameData.tileHeight) - gameData.cameraY,
-          gameData.tileWidth, gameData.tileHeight};
-      SDL_Texture *reticleTexture = assets.getTexture("reticle");
+      SDL_FRect reticleRect = {
+          static_cast<float>((gameData.targetIndicatorX * gameData.tileWidth) -
+                             gameData.cameraX),
+          static_cast<float>((gameData.targetIndicatorY * gameData.tileHeight) -
+                             gameData.cameraY),
+          static_cast<float>(gameData.tileWidth),
+          static_cast<float>(gameData.tileHeight)};
+      static const AssetId reticleId = internAssetName("reticle");
+      SDL_Texture *reticleTexture = assets.getTexture(reticleId);
       Uint8 reticleAlpha = 180;
+      // White in range, red out of range (texture tint / outline colour)
+      SDL_Color textureTint = {255, 255, 255, reticleAlpha};
+      SDL_Color outlineColor = {255, 255, 255, reticleAlpha};
       if (gameData.currentSpellIndex != -1) {
         const Spell &spell =
             gameData.currentGamePlayer.getSpell(gameData.currentSpellIndex);
@@ -2468,34 +2219,31 @@ void renderScene(GameData &gameData, AssetManager &assets) {
                                 gameData.targetIndicatorX) +
                        std::abs(gameData.currentGamePlayer.targetTileY -
                                 gameData.targetIndicatorY);
-        if (distance <= spell.range) {
-          if (reticleTexture)
-            SDL_SetTextureColorMod(reticleTexture, 255, 255, 255);
-          SDL_SetRenderDrawColor(gameData.renderer, 255, 255, 255,
-                                 reticleAlpha);
-        } else {
-          if (reticleTexture)
-            SDL_SetTextureColorMod(reticleTexture, 255, 100, 100);
-          SDL_SetRenderDrawColor(gameData.renderer, 255, 0, 0, reticleAlpha);
+        if (distance > spell.range) {
+          textureTint = {255, 100, 100, reticleAlpha};
+          outlineColor = {255, 0, 0, reticleAlpha};
         }
-      } else {
-        if (reticleTexture)
-          SDL_SetTextureColorMod(reticleTexture, 255, 255, 255);
-        SDL_SetRenderDrawColor(gameData.renderer, 255, 255, 255, reticleAlpha);
       }
       if (reticleTexture) {
-        SDL_SetTextureAlphaMod(reticleTexture, reticleAlpha);
-        SDL_SetTextureBlendMode(reticleTexture, SDL_BLENDMODE_BLEND);
-        SDL_RenderCopy(gameData.renderer, reticleTexture, nullptr,
-                       &reticleRect);
+        queue.texture(RenderLayer::Interface, 0.0f, reticleTexture,
+                      reticleRect, textureTint);
       } else {
-        SDL_SetRenderDrawBlendMode(gameData.renderer, SDL_BLENDMODE_BLEND);
-        SDL_RenderDrawRect(gameData.renderer, &reticleRect);
-        SDL_SetRenderDrawBlendMode(gameData.renderer, SDL_BLENDMODE_NONE);
+        // One-pixel outline as four thin quads
+        const float x = reticleRect.x, y = reticleRect.y;
+        const float w = reticleRect.w, h = reticleRect.h;
+        const SDL_FRect edges[4] = {{x, y, w, 1.0f},
+                                    {x, y + h - 1.0f, w, 1.0f},
+                                    {x, y, 1.0f, h},
+                                    {x + w - 1.0f, y, 1.0f, h}};
+        for (const SDL_FRect &edge : edges)
+          queue.fillRect(RenderLayer::Interface, 0.0f, edge, outlineColor);
       }
     }
   }
 
+  // --- Submit the world: sort, batch, draw ---
+  queue.flush(batcher);
+
   // --- Render UI Overlays ---
   renderSpellBar(gameData, assets);
   renderUI(gameData, assets);
@@ -65,4 +65,30 @@ void displayMenu(SDL_Renderer* renderer, TTF_Font* font, SDL_Texture* splashText
     }
 
     SDL_RenderPresent(renderer);
-}
\ No newline at end of file
+}
+
+void displayLoadingScreen(SDL_Renderer* renderer, SDL_Texture* splashTexture, float progress, int windowWidth, int windowHeight) {
+    SDL_SetRenderDrawColor(renderer, 50, 50, 50, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+
+    if (splashTexture != nullptr) {
+        SDL_Rect srcRect = {0, 1536 - windowHeight, 1024, windowHeight};
+        SDL_Rect destRect = {0, 0, windowWidth, windowHeight};
+        SDL_SetTextureAlphaMod(splashTexture, 255);
+        SDL_RenderCopy(renderer, splashTexture, &srcRect, &destRect);
+    }
+
+    // Progress bar along the bottom
+    if (progress < 0.0f) progress = 0.0f;
+    if (progress > 1.0f) progress = 1.0f;
+    int barWidth = windowWidth / 2;
+    int barHeight = 16;
+    SDL_Rect frameRect = {(windowWidth - barWidth) / 2, windowHeight - 80, barWidth, barHeight};
+    SDL_Rect fillRect = {frameRect.x + 2, frameRect.y + 2, static_cast<int>((barWidth - 4) * progress), barHeight - 4};
+    SDL_SetRenderDrawColor(renderer, 20, 20, 20, SDL_ALPHA_OPAQUE);
+    SDL_RenderFillRect(renderer, &frameRect);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 0, SDL_ALPHA_OPAQUE); // Menu highlight yellow
+    SDL_RenderFillRect(renderer, &fillRect);
+
+    SDL_RenderPresent(renderer);
+}
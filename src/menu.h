@@ -7,5 +7,7 @@
 #include <string>
 
 void displayMenu(SDL_Renderer* renderer, TTF_Font* font, SDL_Texture* splashTexture, const std::vector<std::string>& menuItems, int selectedIndex, bool isPanning, int splashPanOffset, int initialPanOffset, int windowWidth, int windowHeight);
+// Splash (framed as the menu shows it at rest) with a bar filled to progress (0..1). Presents the frame.
+void displayLoadingScreen(SDL_Renderer* renderer, SDL_Texture* splashTexture, float progress, int windowWidth, int windowHeight);
 
 #endif // MENU_H
\ No newline at end of file
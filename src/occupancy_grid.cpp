@@ -0,0 +1,69 @@
+// src/occupancy_grid.cpp
+#include "occupancy_grid.h"
+
+void OccupancyGrid::reset(int newWidth, int newHeight) {
+  width = newWidth > 0 ? newWidth : 0;
+  height = newHeight > 0 ? newHeight : 0;
+  size_t cellCount = static_cast<size_t>(width) * height;
+  cells.assign(cellCount, Occupant());
+  blockedBits.assign((cellCount + 63) / 64, 0);
+}
+
+void OccupancyGrid::setBlockedBit(int cell, bool blocked) {
+  uint64_t mask = uint64_t(1) << (cell & 63);
+  if (blocked) {
+    blockedBits[cell >> 6] |= mask;
+  } else {
+    blockedBits[cell >> 6] &= ~mask;
+  }
+}
+
+bool OccupancyGrid::place(int x, int y, Occupant occupant) {
+  if (!inRange(x, y) || occupant.kind == OccupantKind::None) return false;
+  int cell = y * width + x;
+  if (cells[cell].kind != OccupantKind::None) return false;
+  cells[cell] = occupant;
+  setBlockedBit(cell, true);
+  return true;
+}
+
+Occupant OccupancyGrid::vacate(int x, int y) {
+  if (!inRange(x, y)) return Occupant();
+  int cell = y * width + x;
+  Occupant previous = cells[cell];
+  cells[cell] = Occupant();
+  setBlockedBit(cell, false);
+  return previous;
+}
+
+bool OccupancyGrid::move(int fromX, int fromY, int toX, int toY) {
+  if (!inRange(fromX, fromY) || !inRange(toX, toY)) return false;
+  int fromCell = fromY * width + fromX;
+  int toCell = toY * width + toX;
+  if (fromCell == toCell) return cells[fromCell].kind != OccupantKind::None;
+  if (cells[fromCell].kind == OccupantKind::None ||
+      cells[toCell].kind != OccupantKind::None) {
+    return false;
+  }
+  cells[toCell] = cells[fromCell];
+  cells[fromCell] = Occupant();
+  setBlockedBit(toCell, true);
+  setBlockedBit(fromCell, false);
+  return true;
+}
+
+bool OccupancyGrid::isBlocked(int x, int y) const {
+  if (!inRange(x, y)) return true;
+  int cell = y * width + x;
+  return (blockedBits[cell >> 6] >> (cell & 63)) & 1u;
+}
+
+Occupant OccupancyGrid::at(int x, int y) const {
+  if (!inRange(x, y)) return Occupant();
+  return cells[y * width + x];
+}
+
+EnemyHandle OccupancyGrid::enemyAt(int x, int y) const {
+  Occupant occupant = at(x, y);
+  return occupant.kind == OccupantKind::Enemy ? occupant.enemy : EnemyHandle();
+}
@@ -0,0 +1,65 @@
+// src/occupancy_grid.h
+#ifndef OCCUPANCY_GRID_H
+#define OCCUPANCY_GRID_H
+
+#include "enemy_slot_map.h" // For EnemyHandle
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- Occupancy Grid ---
+// Who (or what) is standing on each tile. Cells are stored flat, and a
+// separate bitset answers "is this tile blocked?" without touching the
+// occupant array, which is the test planAction runs most often.
+// All changes go through place/vacate/move so the two can't disagree.
+
+enum class OccupantKind : uint8_t { None, Wall, Player, Enemy, Pedestal };
+
+struct Occupant {
+  OccupantKind kind = OccupantKind::None;
+  EnemyHandle enemy; // Only meaningful when kind == Enemy
+
+  static Occupant wall() { return {OccupantKind::Wall, EnemyHandle()}; }
+  static Occupant player() { return {OccupantKind::Player, EnemyHandle()}; }
+  static Occupant pedestal() { return {OccupantKind::Pedestal, EnemyHandle()}; }
+  static Occupant forEnemy(EnemyHandle handle) {
+    return {OccupantKind::Enemy, handle};
+  }
+};
+
+class OccupancyGrid {
+public:
+  // Resizes to width x height with every tile empty.
+  void reset(int width, int height);
+
+  // Puts occupant on (x, y). Returns false (and changes nothing) if the
+  // tile is out of range or already taken.
+  bool place(int x, int y, Occupant occupant);
+  // Empties (x, y) and returns whatever was there.
+  Occupant vacate(int x, int y);
+  // Moves the occupant of (fromX, fromY) to (toX, toY). Returns false (and
+  // changes nothing) if the source is empty or the destination is taken.
+  bool move(int fromX, int fromY, int toX, int toY);
+
+  // Out-of-range tiles count as blocked.
+  bool isBlocked(int x, int y) const;
+  Occupant at(int x, int y) const;
+  // Handle of the enemy on (x, y); invalid if it isn't an enemy.
+  EnemyHandle enemyAt(int x, int y) const;
+
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+
+private:
+  bool inRange(int x, int y) const {
+    return x >= 0 && y >= 0 && x < width && y < height;
+  }
+  void setBlockedBit(int cell, bool blocked);
+
+  int width = 0;
+  int height = 0;
+  std::vector<Occupant> cells;       // width * height
+  std::vector<uint64_t> blockedBits; // 1 bit per cell, set when occupied
+};
+
+#endif // OCCUPANCY_GRID_H
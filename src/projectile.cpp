@@ -2,27 +2,29 @@
 #include "projectile.h"
 #include "game_data.h" // Include GameData to access enemy list in update
 #include "enemy.h"     // Include Enemy to access its members (x, y, health)
+#include "render_queue.h"
+#include "asset_manager.h"
 #include <cmath>       // For sqrt, atan2 (optional), or just normalization
 #include <SDL.h>       // For SDL_Log if debugging
 
 // --- Updated Constructor ---
-Projectile::Projectile(ProjectileType pType, SDL_Texture* tex, int w, int h,
+Projectile::Projectile(ProjectileType pType, AssetId texture, int w, int h,
                        float sX, float sY, float tX, float tY, float spd, int dmg,
-                       int targetId /* = -1 */) // Added targetId
+                       EnemyHandle target /* = EnemyHandle() */)
     : type(pType),
       isActive(true),
-      targetEnemyId(targetId), // Store the target ID
+      targetEnemy(target), // Store the homing target
       startX(sX), startY(sY),
       targetX(tX), targetY(tY), // Store initial target coords
       currentX(sX), currentY(sY),
       speed(spd),
       damage(dmg),
       dx(0.0f), dy(0.0f),
-      texture(tex),
+      textureId(texture),
       width(w), height(h)
 {
-    if (!texture) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Projectile created with null texture!");
+    if (!textureId.isValid()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Projectile created without a texture!");
         isActive = false;
     }
     // Calculate initial direction towards the initial target point
@@ -61,27 +63,28 @@ bool Projectile::update(float deltaTime, const GameData& gameData) {
     bool targetFoundAndAlive = false;
 
     // --- Homing Logic ---
-    if (targetEnemyId != -1) {
-        const Enemy* targetEnemy = nullptr;
-        // Find the target enemy in the game data
-        for (const auto& enemy : gameData.enemies) {
-            if (enemy.id == targetEnemyId) {
-                targetEnemy = &enemy;
-                break;
-            }
-        }
+    if (targetsPlayer) {
+        // Follow the player's visual position (they may be mid-move)
+        currentTargetX = gameData.currentGamePlayer.x;
+        currentTargetY = gameData.currentGamePlayer.y;
+        calculateDirection(currentTargetX, currentTargetY);
+    } else if (targetEnemy.isValid()) {
+        // Find the target enemy in the game data (null if it was removed)
+        const Enemy* homingTarget = findEnemy(gameData, targetEnemy);
 
         // Check if found and alive
-        if (targetEnemy != nullptr && targetEnemy->health > 0) {
+        if (homingTarget != nullptr && homingTarget->health > 0) {
             // Update target coordinates to the enemy's current visual position
-            currentTargetX = targetEnemy->visualX;
-            currentTargetY = targetEnemy->visualY;
+            const EnemyPresentation &look =
+                gameData.enemies.presentationOf(*homingTarget);
+            currentTargetX = look.visualX;
+            currentTargetY = look.visualY;
             targetFoundAndAlive = true;
             // Recalculate direction towards the moving target each frame
             calculateDirection(currentTargetX, currentTargetY);
         } else {
             // Target died or disappeared while projectile was in flight
-            SDL_Log("Projectile target Enemy ID %d not found or dead. Deactivating.", targetEnemyId);
+            SDL_Log("Projectile target enemy (slot %u) not found or dead. Deactivating.", targetEnemy.slot);
             isActive = false;
             return false; // Deactivate and stop processing this frame
         }
@@ -106,7 +109,7 @@ bool Projectile::update(float deltaTime, const GameData& gameData) {
         currentX = currentTargetX; // Snap to final target position
         currentY = currentTargetY;
         isActive = false; // Mark for removal / effect application
-        SDL_Log("Projectile reached/hit target (EnemyID: %d).", targetEnemyId);
+        SDL_Log("Projectile reached/hit target (enemy slot: %d).", targetEnemy.isValid() ? (int)targetEnemy.slot : -1);
         return true; // Indicate target reached/hit
     } else {
         // Move along the (potentially updated) direction vector
@@ -117,14 +120,15 @@ bool Projectile::update(float deltaTime, const GameData& gameData) {
 }
 
 // --- render Method (Unchanged) ---
-void Projectile::render(SDL_Renderer* renderer, int cameraX, int cameraY) const {
-    if (!isActive || !texture) {
+void Projectile::render(RenderQueue& queue, const AssetManager& assets, int cameraX, int cameraY) const {
+    SDL_Texture* texture = isActive ? assets.getTexture(textureId) : nullptr;
+    if (!texture) {
         return;
     }
-    SDL_Rect destRect;
-    destRect.x = static_cast<int>(currentX - width / 2.0f) - cameraX;
-    destRect.y = static_cast<int>(currentY - height / 2.0f) - cameraY;
-    destRect.w = width;
-    destRect.h = height;
-    SDL_RenderCopy(renderer, texture, nullptr, &destRect);
+    SDL_FRect destRect;
+    destRect.x = static_cast<float>(static_cast<int>(currentX - width / 2.0f) - cameraX);
+    destRect.y = static_cast<float>(static_cast<int>(currentY - height / 2.0f) - cameraY);
+    destRect.w = static_cast<float>(width);
+    destRect.h = static_cast<float>(height);
+    queue.texture(RenderLayer::Effects, destRect.y + destRect.h, texture, destRect, {255, 255, 255, 255});
 }
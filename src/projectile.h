@@ -4,9 +4,13 @@
 
 #include <SDL.h>
 #include <string>
+#include "asset_id.h"       // For AssetId
+#include "enemy_slot_map.h" // For EnemyHandle
 
 // Forward declare GameData if needed for update signature (it is needed)
 struct GameData;
+class RenderQueue;
+class AssetManager;
 
 enum class ProjectileType {
     Firebolt,
@@ -21,7 +25,8 @@ public:
     bool isActive;
 
     // --- NEW: Target Tracking ---
-    int targetEnemyId = -1; // ID of the enemy being targeted (-1 if none/tile target)
+    EnemyHandle targetEnemy; // Enemy being targeted (invalid if none/tile target)
+    bool targetsPlayer = false; // Fired by an enemy: homes on and damages the player
 
     // --- Position & Movement ---
     float startX, startY;   // Visual world coordinates where it originated
@@ -32,19 +37,19 @@ public:
     int damage;
 
     // --- Visuals ---
-    SDL_Texture* texture; // Pointer to the texture to render (MUST NOT be null)
+    AssetId textureId;    // Looked up each frame, so a reloaded texture shows up
     int width, height;    // Dimensions for rendering
 
     // --- Constructor (Updated) ---
-    Projectile(ProjectileType type, SDL_Texture* tex, int w, int h,
+    Projectile(ProjectileType type, AssetId texture, int w, int h,
                float startX, float startY, float targetX, float targetY, float speed, int damage,
-               int targetId = -1); // Added optional targetId parameter
+               EnemyHandle target = EnemyHandle()); // Optional homing target
 
     // --- Methods (Updated) ---
     // Updates position, returns true if target reached/hit this frame, false otherwise
-    // Now requires GameData to find the target enemy by ID
+    // Now requires GameData to find the target enemy by handle
     bool update(float deltaTime, const GameData& gameData);
-    void render(SDL_Renderer* renderer, int cameraX, int cameraY) const;
+    void render(RenderQueue& queue, const AssetManager& assets, int cameraX, int cameraY) const;
 
 private:
     // Calculate the normalized direction vector towards a specific point
@@ -0,0 +1,117 @@
+// src/render_queue.cpp
+#include "render_queue.h"
+#include "sprite_batcher.h"
+#include "texture_atlas.h"
+#include <algorithm>
+
+static const int KEY_INDEX_BITS = 28;
+static const int KEY_TEXTURE_BITS = 12;
+static const int KEY_Y_BITS = 20;
+static const int KEY_TEXTURE_SHIFT = KEY_INDEX_BITS;
+static const int KEY_Y_SHIFT = KEY_TEXTURE_SHIFT + KEY_TEXTURE_BITS;
+static const int KEY_LAYER_SHIFT = KEY_Y_SHIFT + KEY_Y_BITS;
+// Screen y is biased so sprites partly above the window still sort right
+static const int KEY_Y_BIAS = 1 << (KEY_Y_BITS - 2);
+
+void RenderQueue::clear() {
+  commands.clear();
+  keys.clear();
+  textureIds.clear();
+}
+
+uint64_t RenderQueue::textureKey(SDL_Texture *texture) {
+  // A frame only ever sees a handful of textures; a linear scan is cheapest
+  for (size_t i = 0; i < textureIds.size(); ++i) {
+    if (textureIds[i] == texture)
+      return i;
+  }
+  textureIds.push_back(texture);
+  return std::min<uint64_t>(textureIds.size() - 1,
+                            (1u << KEY_TEXTURE_BITS) - 1);
+}
+
+void RenderQueue::push(RenderLayer layer, float sortY,
+                       const Command &command) {
+  if (commands.size() >= (1u << KEY_INDEX_BITS)) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "RenderQueue full; dropping draw command.");
+    return;
+  }
+  int64_t y = static_cast<int64_t>(sortY) + KEY_Y_BIAS;
+  y = std::max<int64_t>(0, std::min<int64_t>(y, (1 << KEY_Y_BITS) - 1));
+
+  uint64_t key = (static_cast<uint64_t>(layer) << KEY_LAYER_SHIFT) |
+                 (static_cast<uint64_t>(y) << KEY_Y_SHIFT) |
+                 (textureKey(command.texture) << KEY_TEXTURE_SHIFT) |
+                 static_cast<uint64_t>(commands.size());
+  keys.push_back(key);
+  commands.push_back(command);
+}
+
+void RenderQueue::sprite(RenderLayer layer, float sortY,
+                         const AtlasSprite &sprite, const SDL_FRect &dest,
+                         SDL_Color color, SDL_RendererFlip flip,
+                         SDL_BlendMode blend) {
+  if (!sprite.texture)
+    return;
+  push(layer, sortY,
+       {sprite.texture, dest, sprite.u0, sprite.v0, sprite.u1, sprite.v1,
+        color, flip, blend});
+}
+
+void RenderQueue::texture(RenderLayer layer, float sortY,
+                          SDL_Texture *texture, const SDL_FRect &dest,
+                          SDL_Color color, SDL_RendererFlip flip,
+                          SDL_BlendMode blend) {
+  if (!texture)
+    return;
+  push(layer, sortY,
+       {texture, dest, 0.0f, 0.0f, 1.0f, 1.0f, color, flip, blend});
+}
+
+void RenderQueue::fillRect(RenderLayer layer, float sortY,
+                           const SDL_FRect &dest, SDL_Color color,
+                           SDL_BlendMode blend) {
+  push(layer, sortY,
+       {nullptr, dest, 0.0f, 0.0f, 0.0f, 0.0f, color, SDL_FLIP_NONE, blend});
+}
+
+void RenderQueue::flush(SpriteBatcher &batcher) {
+  // --- LSD radix sort, 8 bits a pass, over everything above the index ---
+  const size_t count = keys.size();
+  scratch.resize(count);
+  uint64_t *source = keys.data();
+  uint64_t *target = scratch.data();
+  for (int shift = KEY_INDEX_BITS; shift < 64; shift += 8) {
+    size_t buckets[257] = {0};
+    for (size_t i = 0; i < count; ++i)
+      buckets[((source[i] >> shift) & 0xFF) + 1]++;
+    // Every key has the same digit here (usually the layer or texture
+    // bytes): nothing to reorder
+    bool trivial = false;
+    for (int b = 1; b <= 256; ++b) {
+      if (buckets[b] == count) {
+        trivial = true;
+        break;
+      }
+    }
+    if (trivial)
+      continue;
+    for (int b = 1; b <= 256; ++b)
+      buckets[b] += buckets[b - 1];
+    for (size_t i = 0; i < count; ++i)
+      target[buckets[(source[i] >> shift) & 0xFF]++] = source[i];
+    std::swap(source, target);
+  }
+
+  // --- Submit in order; the batcher merges runs of the same state ---
+  const uint64_t indexMask = (uint64_t(1) << KEY_INDEX_BITS) - 1;
+  for (size_t i = 0; i < count; ++i) {
+    const Command &command = commands[source[i] & indexMask];
+    batcher.drawQuad(command.texture, command.dest, command.color,
+                     command.u0, command.v0, command.u1, command.v1,
+                     command.flip, command.blend);
+  }
+  batcher.flush();
+  clear();
+}
@@ -0,0 +1,73 @@
+// src/render_queue.h
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+
+struct AtlasSprite;
+class SpriteBatcher;
+
+// Draw order, back to front. Within a layer, commands sort by their y key.
+enum class RenderLayer : uint8_t {
+  Ground,        // Floor and wall tiles
+  Fog,           // Per-tile darkness over the terrain
+  GroundOverlay, // Tints laid over tiles (threat overlay)
+  Actors,        // Items, pedestal, enemies, player: y-sorted together
+  Effects,       // Projectiles in flight
+  Interface,     // World-space UI such as the targeting reticle
+};
+
+// --- Render Queue ---
+// Systems push draw commands in any order; flush() sorts them and hands
+// them to the SpriteBatcher. The 64-bit sort key is, from the top bit down:
+//   layer (4) | y (20) | texture (12) | submission index (28)
+// so anything lower on screen draws over what's above it within a layer,
+// and equal-y commands are grouped by texture to keep batches long. The sort
+// is an LSD radix sort over the top 36 bits; the index bits are already in
+// order and the sort is stable, so ties keep their submission order.
+class RenderQueue {
+public:
+  void clear();
+
+  // sortY is the screen y the command is ordered by: the bottom edge of
+  // dest (the sprite's feet), so tall and short sprites on one row layer
+  // correctly. Pass 0 on layers that don't overlap.
+  void sprite(RenderLayer layer, float sortY, const AtlasSprite &sprite,
+              const SDL_FRect &dest, SDL_Color color,
+              SDL_RendererFlip flip = SDL_FLIP_NONE,
+              SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+  void texture(RenderLayer layer, float sortY, SDL_Texture *texture,
+               const SDL_FRect &dest, SDL_Color color,
+               SDL_RendererFlip flip = SDL_FLIP_NONE,
+               SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+  void fillRect(RenderLayer layer, float sortY, const SDL_FRect &dest,
+                SDL_Color color, SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+
+  // Sorts and submits everything to `batcher`, then clears the queue. The
+  // batcher is flushed too, so the renderer is free to use afterwards.
+  void flush(SpriteBatcher &batcher);
+
+  size_t size() const { return commands.size(); }
+
+private:
+  struct Command {
+    SDL_Texture *texture; // nullptr = solid quad
+    SDL_FRect dest;
+    float u0, v0, u1, v1;
+    SDL_Color color;
+    SDL_RendererFlip flip;
+    SDL_BlendMode blend;
+  };
+
+  void push(RenderLayer layer, float sortY, const Command &command);
+  uint64_t textureKey(SDL_Texture *texture);
+
+  std::vector<Command> commands;
+  std::vector<uint64_t> keys;
+  std::vector<uint64_t> scratch;          // Radix sort ping-pong buffer
+  std::vector<SDL_Texture *> textureIds;  // Per-frame texture -> key id
+};
+
+#endif // RENDER_QUEUE_H
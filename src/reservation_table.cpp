@@ -0,0 +1,30 @@
+// src/reservation_table.cpp
+#include "reservation_table.h"
+
+void ReservationTable::reset(int newWidth, int newHeight) {
+  width = newWidth > 0 ? newWidth : 0;
+  height = newHeight > 0 ? newHeight : 0;
+  claimants.assign(static_cast<size_t>(width) * height, NO_CLAIMANT);
+  claimedCells.clear();
+}
+
+void ReservationTable::clear() {
+  for (int cell : claimedCells) {
+    claimants[cell] = NO_CLAIMANT;
+  }
+  claimedCells.clear();
+}
+
+bool ReservationTable::claim(int x, int y, int claimant) {
+  if (x < 0 || y < 0 || x >= width || y >= height) return false;
+  int cell = y * width + x;
+  if (claimants[cell] != NO_CLAIMANT) return false;
+  claimants[cell] = claimant;
+  claimedCells.push_back(cell);
+  return true;
+}
+
+int ReservationTable::claimantAt(int x, int y) const {
+  if (x < 0 || y < 0 || x >= width || y >= height) return NO_CLAIMANT;
+  return claimants[y * width + x];
+}
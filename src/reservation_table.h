@@ -0,0 +1,38 @@
+// src/reservation_table.h
+#ifndef RESERVATION_TABLE_H
+#define RESERVATION_TABLE_H
+
+#include <cstddef>
+#include <vector>
+
+// Per-turn map of tile -> claimant (an index into the caller's own list, e.g.
+// an enemy slot). Claims live in a flat array sized to the level; the claimed
+// cells are also remembered so clear() only touches what was written this turn
+// instead of the whole map.
+class ReservationTable {
+public:
+  static const int NO_CLAIMANT = -1;
+
+  // Resizes for a level of width x height and drops every claim.
+  void reset(int width, int height);
+  // Drops every claim. O(number of claims).
+  void clear();
+
+  // Claims (x, y) for claimant. Returns false (and changes nothing) if the
+  // tile is out of range or someone else already holds it.
+  bool claim(int x, int y, int claimant);
+  // Current holder of (x, y), or NO_CLAIMANT.
+  int claimantAt(int x, int y) const;
+
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+  size_t claimCount() const { return claimedCells.size(); }
+
+private:
+  int width = 0;
+  int height = 0;
+  std::vector<int> claimants;    // width * height, NO_CLAIMANT when free
+  std::vector<int> claimedCells; // Flat indices written since the last clear
+};
+
+#endif // RESERVATION_TABLE_H
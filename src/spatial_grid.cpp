@@ -0,0 +1,111 @@
+// src/spatial_grid.cpp
+#include "spatial_grid.h"
+#include "game_data.h"
+#include <algorithm>
+#include <cmath>
+
+void SpatialGrid::reset(int levelWidth, int levelHeight, int newCellTiles) {
+  cellTiles = newCellTiles > 0 ? newCellTiles : SPATIAL_CELL_TILES;
+  cellsWide = levelWidth > 0 ? (levelWidth + cellTiles - 1) / cellTiles : 0;
+  cellsHigh = levelHeight > 0 ? (levelHeight + cellTiles - 1) / cellTiles : 0;
+  cells.assign(static_cast<size_t>(cellsWide) * cellsHigh,
+               std::vector<SpatialEntry>());
+}
+
+int SpatialGrid::cellOf(int tileX, int tileY) const {
+  int cx = std::max(0, std::min(cellsWide - 1, tileX / cellTiles));
+  int cy = std::max(0, std::min(cellsHigh - 1, tileY / cellTiles));
+  return cy * cellsWide + cx;
+}
+
+static bool sameEntry(const SpatialEntry &a, const SpatialEntry &b) {
+  return a.kind == b.kind && a.id == b.id && a.generation == b.generation;
+}
+
+void SpatialGrid::insert(SpatialEntry entry, int tileX, int tileY) {
+  if (cells.empty()) return;
+  cells[cellOf(tileX, tileY)].push_back(entry);
+}
+
+bool SpatialGrid::remove(SpatialEntry entry, int tileX, int tileY) {
+  if (cells.empty()) return false;
+  std::vector<SpatialEntry> &cell = cells[cellOf(tileX, tileY)];
+  for (size_t i = 0; i < cell.size(); ++i) {
+    if (sameEntry(cell[i], entry)) {
+      cell[i] = cell.back(); // Order within a cell doesn't matter
+      cell.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+void SpatialGrid::move(SpatialEntry entry, int fromX, int fromY, int toX,
+                       int toY) {
+  if (cells.empty() || cellOf(fromX, fromY) == cellOf(toX, toY)) return;
+  if (!remove(entry, fromX, fromY)) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "SpatialGrid: entry %u not found at [%d,%d]; filing it "
+                "anyway.",
+                entry.id, fromX, fromY);
+  }
+  insert(entry, toX, toY);
+}
+
+void SpatialGrid::clearKind(SpatialKind kind) {
+  for (std::vector<SpatialEntry> &cell : cells) {
+    cell.erase(std::remove_if(cell.begin(), cell.end(),
+                              [kind](const SpatialEntry &e) {
+                                return e.kind == kind;
+                              }),
+               cell.end());
+  }
+}
+
+void SpatialGrid::query(int minX, int minY, int maxX, int maxY,
+                        std::vector<SpatialEntry> &out) const {
+  if (cells.empty() || maxX < minX || maxY < minY) return;
+  int firstX = std::max(0, minX / cellTiles);
+  int firstY = std::max(0, minY / cellTiles);
+  int lastX = std::min(cellsWide - 1, maxX / cellTiles);
+  int lastY = std::min(cellsHigh - 1, maxY / cellTiles);
+  for (int cy = firstY; cy <= lastY; ++cy) {
+    for (int cx = firstX; cx <= lastX; ++cx) {
+      const std::vector<SpatialEntry> &cell = cells[cy * cellsWide + cx];
+      out.insert(out.end(), cell.begin(), cell.end());
+    }
+  }
+}
+
+void syncSpatialItems(GameData &gameData) {
+  gameData.spatialGrid.clearKind(SpatialKind::Item);
+  for (size_t i = 0; i < gameData.droppedItems.size(); ++i) {
+    const ItemDrop &item = gameData.droppedItems[i];
+    gameData.spatialGrid.insert(
+        {SpatialKind::Item, static_cast<uint32_t>(i), 0}, item.x, item.y);
+  }
+}
+
+void syncSpatialProjectiles(GameData &gameData) {
+  gameData.spatialGrid.clearKind(SpatialKind::Projectile);
+  if (gameData.tileWidth <= 0 || gameData.tileHeight <= 0) return;
+  for (size_t i = 0; i < gameData.activeProjectiles.size(); ++i) {
+    const Projectile &proj = gameData.activeProjectiles[i];
+    gameData.spatialGrid.insert(
+        {SpatialKind::Projectile, static_cast<uint32_t>(i), 0},
+        static_cast<int>(std::floor(proj.currentX / gameData.tileWidth)),
+        static_cast<int>(std::floor(proj.currentY / gameData.tileHeight)));
+  }
+}
+
+void rebuildSpatialGrid(GameData &gameData) {
+  gameData.spatialGrid.reset(gameData.currentLevel.width,
+                             gameData.currentLevel.height);
+  for (const Enemy &enemy : gameData.enemies) {
+    gameData.spatialGrid.insert(
+        {SpatialKind::Enemy, enemy.handle.slot, enemy.handle.generation},
+        enemy.x, enemy.y);
+  }
+  syncSpatialItems(gameData);
+  syncSpatialProjectiles(gameData);
+}
@@ -0,0 +1,73 @@
+// src/spatial_grid.h
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+struct GameData;
+
+// Side of a spatial grid cell in tiles. A 1920x1080 view of 128px tiles
+// touches about 5x4 cells.
+const int SPATIAL_CELL_TILES = 4;
+
+enum class SpatialKind : uint8_t { Enemy, Item, Projectile };
+
+struct SpatialEntry {
+  SpatialKind kind = SpatialKind::Enemy;
+  // Enemy handle slot, or index into droppedItems / activeProjectiles
+  uint32_t id = 0;
+  uint32_t generation = 0; // Enemy handle generation; unused otherwise
+};
+
+// --- Spatial Grid ---
+// Uniform grid over the level bucketing the dynamic objects (enemies, dropped
+// items, projectiles) by the tile they're on, so the renderer only visits
+// what's near the camera. Objects are moved between cells when they cross
+// into a new one; most moves stay inside a cell and cost nothing.
+//
+// Enemies are keyed by the tile they hold in the OccupancyGrid (their
+// destination while moving), which is never more than a tile from where
+// they're drawn. Items and projectiles are keyed by vector index, so their
+// entries are rebuilt whenever those vectors are compacted.
+class SpatialGrid {
+public:
+  // Resizes to cover a width x height tile level with every cell empty.
+  void reset(int levelWidth, int levelHeight,
+             int cellTiles = SPATIAL_CELL_TILES);
+
+  // Tiles outside the level are clamped to the nearest edge cell.
+  void insert(SpatialEntry entry, int tileX, int tileY);
+  // Returns false if the entry wasn't in the cell for (tileX, tileY).
+  bool remove(SpatialEntry entry, int tileX, int tileY);
+  // Only touches the cells if the two tiles are in different ones.
+  void move(SpatialEntry entry, int fromX, int fromY, int toX, int toY);
+  // Drops every entry of one kind.
+  void clearKind(SpatialKind kind);
+
+  // Appends the entries in every cell overlapping the tile rectangle
+  // [minX, maxX] x [minY, maxY]. Entries near but outside it are included.
+  void query(int minX, int minY, int maxX, int maxY,
+             std::vector<SpatialEntry> &out) const;
+
+  int getCellTiles() const { return cellTiles; }
+
+private:
+  int cellOf(int tileX, int tileY) const;
+
+  int cellTiles = SPATIAL_CELL_TILES;
+  int cellsWide = 0;
+  int cellsHigh = 0;
+  std::vector<std::vector<SpatialEntry>> cells; // cellsWide * cellsHigh
+};
+
+// --- GameData helpers ---
+// Fills the grid from scratch for the current level's enemies, items and
+// projectiles.
+void rebuildSpatialGrid(GameData &gameData);
+// Re-files every dropped item / active projectile after their vector changed.
+void syncSpatialItems(GameData &gameData);
+void syncSpatialProjectiles(GameData &gameData);
+
+#endif // SPATIAL_GRID_H
@@ -4,6 +4,7 @@
 
 #include <string>
 #include <vector> // Forward declare if needed, or include headers
+#include "asset_id.h" // For AssetId
 
 // Forward declarations to avoid circular dependencies if needed
 class PlayerCharacter;
@@ -35,13 +36,16 @@ struct Spell {
     float value; // Magnitude of the effect (e.g., damage amount, heal amount)
     int areaOfEffectRadius; // 0 for single target/tile
     std::string iconName;
+    AssetId iconId; // Interned iconName, for per-frame lookups
 
     // Optional: Add fields for visual effects (particle system name, sound effect name, etc.)
     // std::string visualEffectName;
     // std::string soundEffectName;
 
     Spell(std::string n, int cost, int rng, SpellTargetType tt, SpellEffectType et, float val, std::string iconKey, int aoe = 0)
-        : name(std::move(n)), manaCost(cost), range(rng), targetType(tt), effectType(et), value(val), iconName(std::move(iconKey)), areaOfEffectRadius(aoe) {}
+        : name(std::move(n)), manaCost(cost), range(rng), targetType(tt), effectType(et), value(val), iconName(std::move(iconKey)), areaOfEffectRadius(aoe) {
+        iconId = internAssetName(iconName);
+    }
 
     // Potentially add a function to apply the effect, though this might be better handled elsewhere
     // void applyEffect(PlayerCharacter& caster, /* target(s) */ );
@@ -0,0 +1,91 @@
+// src/sprite_batcher.cpp
+#include "sprite_batcher.h"
+#include "texture_atlas.h"
+#include <utility>
+
+void SpriteBatcher::begin(SDL_Renderer *targetRenderer) {
+  renderer = targetRenderer;
+  currentTexture = nullptr;
+  currentBlend = SDL_BLENDMODE_BLEND;
+  vertices.clear();
+  indices.clear();
+  drawCalls = 0;
+  quadCount = 0;
+}
+
+void SpriteBatcher::draw(const AtlasSprite &sprite, const SDL_FRect &dest,
+                         SDL_Color color, SDL_RendererFlip flip,
+                         SDL_BlendMode blend) {
+  if (!sprite.texture)
+    return;
+  drawQuad(sprite.texture, dest, color, sprite.u0, sprite.v0, sprite.u1,
+           sprite.v1, flip, blend);
+}
+
+void SpriteBatcher::drawTexture(SDL_Texture *texture, const SDL_FRect &dest,
+                                SDL_Color color, SDL_RendererFlip flip,
+                                SDL_BlendMode blend) {
+  if (!texture)
+    return;
+  drawQuad(texture, dest, color, 0.0f, 0.0f, 1.0f, 1.0f, flip, blend);
+}
+
+void SpriteBatcher::fillRect(const SDL_FRect &dest, SDL_Color color,
+                             SDL_BlendMode blend) {
+  drawQuad(nullptr, dest, color, 0.0f, 0.0f, 0.0f, 0.0f, SDL_FLIP_NONE, blend);
+}
+
+void SpriteBatcher::drawQuad(SDL_Texture *texture, const SDL_FRect &dest,
+                             SDL_Color color, float u0, float v0, float u1,
+                             float v1, SDL_RendererFlip flip,
+                             SDL_BlendMode blend) {
+  if (!vertices.empty() && (texture != currentTexture || blend != currentBlend))
+    flush();
+  currentTexture = texture;
+  currentBlend = blend;
+
+  if (flip & SDL_FLIP_HORIZONTAL)
+    std::swap(u0, u1);
+  if (flip & SDL_FLIP_VERTICAL)
+    std::swap(v0, v1);
+
+  const int base = static_cast<int>(vertices.size());
+  const float left = dest.x;
+  const float top = dest.y;
+  const float right = dest.x + dest.w;
+  const float bottom = dest.y + dest.h;
+  vertices.push_back({{left, top}, color, {u0, v0}});
+  vertices.push_back({{right, top}, color, {u1, v0}});
+  vertices.push_back({{right, bottom}, color, {u1, v1}});
+  vertices.push_back({{left, bottom}, color, {u0, v1}});
+  const int quad[6] = {0, 1, 2, 0, 2, 3};
+  for (int corner : quad)
+    indices.push_back(base + corner);
+  quadCount++;
+}
+
+void SpriteBatcher::flush() {
+  if (vertices.empty() || !renderer)
+    return;
+  if (currentTexture == nullptr) {
+    // Solid quads blend with the draw blend mode
+    SDL_SetRenderDrawBlendMode(renderer, currentBlend);
+  } else {
+    SDL_BlendMode textureBlend;
+    if (SDL_GetTextureBlendMode(currentTexture, &textureBlend) != 0 ||
+        textureBlend != currentBlend)
+      SDL_SetTextureBlendMode(currentTexture, currentBlend);
+  }
+  if (SDL_RenderGeometry(renderer, currentTexture, vertices.data(),
+                         static_cast<int>(vertices.size()), indices.data(),
+                         static_cast<int>(indices.size())) != 0) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "SpriteBatcher: SDL_RenderGeometry failed: %s",
+                 SDL_GetError());
+  }
+  if (currentTexture == nullptr)
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+  drawCalls++;
+  vertices.clear();
+  indices.clear();
+}
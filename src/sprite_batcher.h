@@ -0,0 +1,57 @@
+// src/sprite_batcher.h
+#ifndef SPRITE_BATCHER_H
+#define SPRITE_BATCHER_H
+
+#include <SDL.h>
+#include <vector>
+
+struct AtlasSprite;
+
+// --- Sprite Batcher ---
+// Collects textured and solid quads and submits each run that shares a
+// texture and blend mode with a single SDL_RenderGeometry call. Draw order
+// is kept: a quad with different state ends the current run. Sprites packed
+// into the same atlas page therefore batch across tiles, items, enemies and
+// the player. RenderQueue sorts commands so those runs are as long as the
+// depth order allows.
+//
+// Colour is per vertex and multiplies the texture (alpha included), which
+// replaces SDL_SetTextureColorMod/AlphaMod for batched sprites. Blend mode
+// is only set on the renderer or texture when a run needs a different one.
+//
+// Anything drawn straight to the renderer between begin() and flush() must
+// call flush() first or it will end up underneath the batch.
+class SpriteBatcher {
+public:
+  void begin(SDL_Renderer *renderer);
+  void draw(const AtlasSprite &sprite, const SDL_FRect &dest, SDL_Color color,
+            SDL_RendererFlip flip = SDL_FLIP_NONE,
+            SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+  // A whole texture that isn't in the atlas (ends any atlas run).
+  void drawTexture(SDL_Texture *texture, const SDL_FRect &dest,
+                   SDL_Color color, SDL_RendererFlip flip = SDL_FLIP_NONE,
+                   SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+  // An untextured quad.
+  void fillRect(const SDL_FRect &dest, SDL_Color color,
+                SDL_BlendMode blend = SDL_BLENDMODE_BLEND);
+  // Any of the above: texture may be nullptr (solid), uv in [0, 1].
+  void drawQuad(SDL_Texture *texture, const SDL_FRect &dest, SDL_Color color,
+                float u0, float v0, float u1, float v1, SDL_RendererFlip flip,
+                SDL_BlendMode blend);
+  void flush();
+
+  // Draw calls and quads submitted since begin(), for profiling.
+  int getDrawCalls() const { return drawCalls; }
+  int getQuadCount() const { return quadCount; }
+
+private:
+  SDL_Renderer *renderer = nullptr;
+  SDL_Texture *currentTexture = nullptr; // nullptr = solid run
+  SDL_BlendMode currentBlend = SDL_BLENDMODE_BLEND;
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+  int drawCalls = 0;
+  int quadCount = 0;
+};
+
+#endif // SPRITE_BATCHER_H
@@ -0,0 +1,80 @@
+// src/stimulus_map.cpp
+#include "stimulus_map.h"
+#include <algorithm>
+
+void StimulusMap::reset(int w, int h, float decay) {
+  width = std::max(0, w);
+  height = std::max(0, h);
+  decayPerTurn = std::max(0.0f, decay);
+  cells.assign(static_cast<size_t>(width) * height, Cell());
+}
+
+float StimulusMap::decayed(const Cell &cell, int turn) const {
+  int age = std::max(0, turn - cell.turn);
+  return std::max(0.0f, cell.intensity - decayPerTurn * age);
+}
+
+void StimulusMap::deposit(int x, int y, float intensity, int turn) {
+  if (x < 0 || y < 0 || x >= width || y >= height)
+    return;
+  Cell &cell = cells[y * width + x];
+  // Fold the old value's fade in now so the cell only needs one timestamp
+  cell.intensity = std::max(intensity, decayed(cell, turn));
+  cell.turn = turn;
+}
+
+float StimulusMap::sample(int x, int y, int turn) const {
+  if (x < 0 || y < 0 || x >= width || y >= height)
+    return 0.0f;
+  return decayed(cells[y * width + x], turn);
+}
+
+void StimulusMap::propagate(const std::vector<std::string> &tiles, int x,
+                            int y, float intensity, int radius, int turn,
+                            std::vector<int> *outReached) {
+  if (x < 0 || y < 0 || x >= width || y >= height || radius < 0)
+    return;
+
+  // Visited marks live in a window around the source, so a small sound
+  // doesn't pay for the size of the level.
+  const int side = 2 * radius + 1;
+  steps.assign(static_cast<size_t>(side) * side, -1);
+  frontier.clear();
+  steps[radius * side + radius] = 0;
+  frontier.push_back(radius * side + radius);
+
+  const int stepX[4] = {0, 0, -1, 1};
+  const int stepY[4] = {-1, 1, 0, 0};
+  for (size_t head = 0; head < frontier.size(); ++head) {
+    int local = frontier[head];
+    int lx = local % side;
+    int ly = local / side;
+    int tileX = x - radius + lx;
+    int tileY = y - radius + ly;
+    int distance = steps[local];
+
+    deposit(tileX, tileY,
+            intensity * (1.0f - static_cast<float>(distance) / (radius + 1)),
+            turn);
+    if (outReached)
+      outReached->push_back(tileY * width + tileX);
+    if (distance >= radius)
+      continue;
+
+    for (int d = 0; d < 4; ++d) {
+      int nlx = lx + stepX[d];
+      int nly = ly + stepY[d];
+      int nx = tileX + stepX[d];
+      int ny = tileY + stepY[d];
+      if (nx < 0 || ny < 0 || nx >= width || ny >= height ||
+          ny >= (int)tiles.size() || nx >= (int)tiles[ny].size() ||
+          tiles[ny][nx] == '#')
+        continue;
+      int nextLocal = nly * side + nlx;
+      if (steps[nextLocal] != -1)
+        continue;
+      steps[nextLocal] = distance + 1;
+      frontier.push_back(nextLocal);
+    }
+  }
+}
@@ -0,0 +1,50 @@
+// src/stimulus_map.h
+#ifndef STIMULUS_MAP_H
+#define STIMULUS_MAP_H
+
+#include <string>
+#include <vector>
+
+// --- Stimulus Map ---
+// A per-tile perception field (noise, scent) that fades over turns. Each tile
+// keeps the intensity it was last stamped with and the turn it was stamped
+// on; the fade is applied when the tile is read, so nothing walks the grid to
+// decay it. sample() is O(1) and read-only, safe from planning workers.
+class StimulusMap {
+public:
+  // Clears the map. decayPerTurn is how much intensity is lost each turn.
+  void reset(int width, int height, float decayPerTurn);
+
+  // Raises one tile to at least `intensity` as of `turn`.
+  void deposit(int x, int y, float intensity, int turn);
+
+  // Spreads from (x, y) over walkable tiles (not '#') up to `radius` steps,
+  // falling off linearly to nothing at the edge. Appends the index
+  // (y * width + x) of every tile reached to outReached if given.
+  void propagate(const std::vector<std::string> &tiles, int x, int y,
+                 float intensity, int radius, int turn,
+                 std::vector<int> *outReached = nullptr);
+
+  // Intensity at (x, y) as of `turn`, 0 off the map or once faded.
+  float sample(int x, int y, int turn) const;
+
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+
+private:
+  struct Cell {
+    float intensity = 0.0f;
+    int turn = 0; // Turn `intensity` was deposited on
+  };
+
+  float decayed(const Cell &cell, int turn) const;
+
+  int width = 0;
+  int height = 0;
+  float decayPerTurn = 0.0f;
+  std::vector<Cell> cells;
+  std::vector<int> frontier; // Propagation scratch
+  std::vector<int> steps;    // Propagation scratch: steps from the source
+};
+
+#endif // STIMULUS_MAP_H
@@ -0,0 +1,55 @@
+// src/task.h
+#ifndef TASK_H
+#define TASK_H
+
+// --- Resumable Tasks ---
+// Stackless, switch-based coroutines for multi-frame logic. A task is a
+// function that is called once per frame with the same TaskState; it runs
+// until it yields, and the next call resumes just after that point. This
+// lets a multi-frame sequence be written top to bottom instead of as phase
+// flags and timers spread over several frames:
+//
+//   TaskStatus resolve(TaskState &task, ...) {
+//     TASK_BEGIN(task);
+//     startMoves();
+//     while (movesPending()) {
+//       advanceMoves();
+//       TASK_YIELD(task);
+//     }
+//     TASK_END(task);
+//   }
+//
+// Rules (same as any switch-based coroutine):
+//   - Locals don't survive a yield; keep state in TaskState or the caller's
+//     data.
+//   - Don't declare initialised locals between TASK_BEGIN and a yield in the
+//     same scope (the resume jumps past them).
+//   - Only one TASK_* yield per source line.
+
+enum class TaskStatus { Running, Done };
+
+struct TaskState {
+  int resumeLine = 0; // 0 = not started (or finished)
+
+  void reset() { resumeLine = 0; }
+  bool isRunning() const { return resumeLine != 0; }
+};
+
+#define TASK_BEGIN(state)                                                      \
+  switch ((state).resumeLine) {                                                \
+  case 0:
+
+// Give up the rest of this frame; resume here next call.
+#define TASK_YIELD(state)                                                      \
+  do {                                                                         \
+    (state).resumeLine = __LINE__;                                             \
+    return TaskStatus::Running;                                                \
+  case __LINE__:;                                                              \
+  } while (0)
+
+#define TASK_END(state)                                                        \
+  }                                                                            \
+  (state).reset();                                                             \
+  return TaskStatus::Done
+
+#endif // TASK_H
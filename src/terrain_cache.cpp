@@ -0,0 +1,439 @@
+// src/terrain_cache.cpp
+#include "terrain_cache.h"
+#include "asset_manager.h"
+#include "game_data.h"
+#include "render_queue.h"
+#include "texture_atlas.h"
+#include "utils.h" // For isWithinBounds
+#include <algorithm>
+#include <cmath>
+
+// Floor variants and how often each appears. A tile's variant comes from a
+// hash of its position, so it's stable across rebuilds.
+static const AssetId FLOOR_SPRITES[] = {internAssetName("floor_1"),
+                                        internAssetName("floor_2")};
+static const AssetId WALL_SPRITE = internAssetName("wall_texture");
+static const AssetId START_SPRITE = internAssetName("start_tile");
+static const AssetId EXIT_SPRITE = internAssetName("exit_tile");
+static const AssetId DECAL_SPRITE = internAssetName(DECAL_SPRITE_NAME);
+static const double FLOOR_WEIGHTS[] = {3.0, 7.0};
+static const int FLOOR_VARIANTS = 2;
+
+void drawTerrainTiles(const GameData &gameData, const AssetManager &assets,
+                      SpriteBatcher &batcher, int startX, int startY,
+                      int endX, int endY, float offsetX, float offsetY) {
+  const Level &level = gameData.currentLevel;
+  const AtlasSprite *wallSprite = assets.getSprite(WALL_SPRITE);
+  const AtlasSprite *startSprite = assets.getSprite(START_SPRITE);
+  const AtlasSprite *exitSprite = assets.getSprite(EXIT_SPRITE);
+
+  // Cumulative weights of the floor variants that actually loaded
+  const AtlasSprite *floorSprites[FLOOR_VARIANTS];
+  double cumulativeWeights[FLOOR_VARIANTS];
+  int floorCount = 0;
+  double totalWeight = 0.0;
+  for (int i = 0; i < FLOOR_VARIANTS; ++i) {
+    const AtlasSprite *sprite = assets.getSprite(FLOOR_SPRITES[i]);
+    if (!sprite)
+      continue;
+    floorSprites[floorCount] = sprite;
+    totalWeight += FLOOR_WEIGHTS[i];
+    cumulativeWeights[floorCount] = totalWeight;
+    floorCount++;
+  }
+
+  const float tileW = static_cast<float>(gameData.tileWidth);
+  const float tileH = static_cast<float>(gameData.tileHeight);
+  for (int y = startY; y < endY; ++y) {
+    for (int x = startX; x < endX; ++x) {
+      if (!isWithinBounds(x, y, level.width, level.height) ||
+          y >= (int)level.tiles.size() || x >= (int)level.tiles[y].size())
+        continue;
+      SDL_FRect tileRect = {offsetX + (x - startX) * tileW,
+                            offsetY + (y - startY) * tileH, tileW, tileH};
+      char tileType = level.tiles[y][x];
+
+      const AtlasSprite *sprite = nullptr;
+      if (y == level.startRow && x == level.startCol && startSprite)
+        sprite = startSprite;
+      else if (y == level.endRow && x == level.endCol && exitSprite)
+        sprite = exitSprite;
+      else if (tileType == '#' && wallSprite)
+        sprite = wallSprite;
+      else if (tileType == '.' && floorCount > 0) {
+        unsigned int hash = ((unsigned int)x * 2654435761u) ^
+                            ((unsigned int)y * 3063691763u);
+        double hashValue = (double)(hash % 10000) / 10000.0 * totalWeight;
+        sprite = floorSprites[0];
+        for (int i = 0; i < floorCount; ++i)
+          if (hashValue <= cumulativeWeights[i]) {
+            sprite = floorSprites[i];
+            break;
+          }
+      }
+
+      if (sprite != nullptr) {
+        batcher.draw(*sprite, tileRect, {255, 255, 255, 255});
+      } else {
+        Uint8 r = 50, g = 50, b = 50;
+        if (tileType == '#') {
+          r = 139;
+          g = 69;
+          b = 19;
+        } else if (tileType == '.') {
+          r = 100;
+          g = 100;
+          b = 100;
+        }
+        batcher.fillRect(tileRect, {r, g, b, 255}, SDL_BLENDMODE_NONE);
+      }
+    }
+  }
+}
+
+TerrainCache::~TerrainCache() { releaseTextures(); }
+
+void TerrainCache::reset(int newLevelWidth, int newLevelHeight,
+                         int newTileWidth, int newTileHeight) {
+  // Chunk textures are only reusable if they're still the right size
+  int newChunkTiles = TERRAIN_CHUNK_MAX_TILES;
+  if (newTileWidth > 0 && newTileHeight > 0) {
+    newChunkTiles = std::max(
+        1, std::min(TERRAIN_CHUNK_MAX_TILES,
+                    TERRAIN_CHUNK_MAX_PIXELS /
+                        std::max(newTileWidth, newTileHeight)));
+  }
+  bool sameChunkSize = newChunkTiles == chunkTiles &&
+                       newTileWidth == tileWidth && newTileHeight == tileHeight;
+
+  for (Chunk &chunk : chunks) {
+    if (!chunk.texture)
+      continue;
+    if (sameChunkSize)
+      spareTextures.push_back(chunk.texture);
+    else
+      SDL_DestroyTexture(chunk.texture);
+  }
+  if (!sameChunkSize) {
+    for (SDL_Texture *texture : spareTextures)
+      SDL_DestroyTexture(texture);
+    spareTextures.clear();
+  }
+
+  levelWidth = newLevelWidth;
+  levelHeight = newLevelHeight;
+  tileWidth = newTileWidth;
+  tileHeight = newTileHeight;
+  chunkTiles = newChunkTiles;
+  chunksWide = (levelWidth + chunkTiles - 1) / chunkTiles;
+  chunksHigh = (levelHeight + chunkTiles - 1) / chunkTiles;
+  chunks.assign(static_cast<size_t>(std::max(0, chunksWide * chunksHigh)),
+                Chunk());
+  fogDirty = true;
+}
+
+void TerrainCache::invalidateTile(int x, int y) {
+  if (!isWithinBounds(x, y, levelWidth, levelHeight))
+    return;
+  chunks[chunkIndex(x / chunkTiles, y / chunkTiles)].dirty = true;
+}
+
+void TerrainCache::addDecal(const Decal &decal) {
+  if (chunks.empty() || tileWidth <= 0 || tileHeight <= 0)
+    return;
+  // Every chunk the decal overlaps bakes its own part of it
+  const float chunkPixelsW = static_cast<float>(chunkTiles * tileWidth);
+  const float chunkPixelsH = static_cast<float>(chunkTiles * tileHeight);
+  const float half = decal.size * 0.5f;
+  int firstX = std::max(0, (int)std::floor((decal.x - half) / chunkPixelsW));
+  int firstY = std::max(0, (int)std::floor((decal.y - half) / chunkPixelsH));
+  int lastX = std::min(chunksWide - 1,
+                       (int)std::floor((decal.x + half) / chunkPixelsW));
+  int lastY = std::min(chunksHigh - 1,
+                       (int)std::floor((decal.y + half) / chunkPixelsH));
+  for (int cy = firstY; cy <= lastY; ++cy) {
+    for (int cx = firstX; cx <= lastX; ++cx) {
+      Chunk &chunk = chunks[chunkIndex(cx, cy)];
+      if ((int)chunk.decals.size() >= TERRAIN_CHUNK_MAX_DECALS)
+        chunk.decals.erase(chunk.decals.begin());
+      chunk.decals.push_back(decal);
+      chunk.unbakedDecals =
+          std::min(chunk.unbakedDecals + 1, (int)chunk.decals.size());
+    }
+  }
+}
+
+void TerrainCache::invalidateAll() {
+  for (Chunk &chunk : chunks)
+    chunk.dirty = true;
+  fogDirty = true;
+}
+
+void TerrainCache::releaseTextures() {
+  for (Chunk &chunk : chunks) {
+    if (chunk.texture)
+      SDL_DestroyTexture(chunk.texture);
+    chunk.texture = nullptr;
+    chunk.dirty = true;
+  }
+  for (SDL_Texture *texture : spareTextures)
+    SDL_DestroyTexture(texture);
+  spareTextures.clear();
+  if (fogTexture)
+    SDL_DestroyTexture(fogTexture);
+  fogTexture = nullptr;
+}
+
+int TerrainCache::getBuiltChunkCount() const {
+  int built = 0;
+  for (const Chunk &chunk : chunks)
+    built += chunk.texture ? 1 : 0;
+  return built;
+}
+
+SDL_Texture *TerrainCache::acquireTexture(SDL_Renderer *renderer,
+                                          int budget) {
+  if (!spareTextures.empty()) {
+    SDL_Texture *texture = spareTextures.back();
+    spareTextures.pop_back();
+    return texture;
+  }
+  // Over budget: take the texture of the chunk that's been off screen longest
+  if (getBuiltChunkCount() >= budget) {
+    Chunk *oldest = nullptr;
+    for (Chunk &chunk : chunks) {
+      if (chunk.texture && chunk.lastUsed < frame &&
+          (!oldest || chunk.lastUsed < oldest->lastUsed))
+        oldest = &chunk;
+    }
+    if (oldest) {
+      SDL_Texture *texture = oldest->texture;
+      oldest->texture = nullptr;
+      oldest->dirty = true;
+      return texture;
+    }
+    // Everything built is on screen right now; go over budget for a frame
+  }
+  SDL_Texture *texture = SDL_CreateTexture(
+      renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+      chunkTiles * tileWidth, chunkTiles * tileHeight);
+  if (!texture) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "TerrainCache: failed to create chunk texture: %s",
+                 SDL_GetError());
+    return nullptr;
+  }
+  SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+  return texture;
+}
+
+void TerrainCache::buildChunk(GameData &gameData, const AssetManager &assets,
+                              int chunkX, int chunkY, Chunk &chunk) {
+  SDL_Renderer *renderer = gameData.renderer;
+  SDL_Texture *previousTarget = SDL_GetRenderTarget(renderer);
+  if (SDL_SetRenderTarget(renderer, chunk.texture) != 0) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "TerrainCache: can't render to chunk [%d,%d]: %s", chunkX,
+                 chunkY, SDL_GetError());
+    return;
+  }
+  // Past the level edge stays transparent
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+  SDL_RenderClear(renderer);
+
+  int startX = chunkX * chunkTiles;
+  int startY = chunkY * chunkTiles;
+  chunkBatcher.begin(renderer);
+  drawTerrainTiles(gameData, assets, chunkBatcher, startX, startY,
+                   std::min(levelWidth, startX + chunkTiles),
+                   std::min(levelHeight, startY + chunkTiles), 0.0f, 0.0f);
+  drawDecals(chunkBatcher, assets, chunk.decals.data(),
+             (int)chunk.decals.size(), -(float)(startX * tileWidth),
+             -(float)(startY * tileHeight));
+  chunkBatcher.flush();
+
+  SDL_SetRenderTarget(renderer, previousTarget);
+  chunk.dirty = false;
+  chunk.unbakedDecals = 0;
+}
+
+void TerrainCache::drawDecals(SpriteBatcher &batcher,
+                              const AssetManager &assets, const Decal *decals,
+                              int count, float offsetX, float offsetY) {
+  const AtlasSprite *sprite = assets.getSprite(DECAL_SPRITE);
+  if (!sprite)
+    return;
+  for (int i = 0; i < count; ++i) {
+    const Decal &decal = decals[i];
+    SDL_FRect dest = {offsetX + decal.x - decal.size * 0.5f,
+                      offsetY + decal.y - decal.size * 0.5f, decal.size,
+                      decal.size};
+    batcher.draw(*sprite, dest, decal.color, decal.flip);
+  }
+}
+
+void TerrainCache::bakeDecals(GameData &gameData, const AssetManager &assets,
+                              int chunkX, int chunkY, Chunk &chunk) {
+  SDL_Renderer *renderer = gameData.renderer;
+  SDL_Texture *previousTarget = SDL_GetRenderTarget(renderer);
+  if (SDL_SetRenderTarget(renderer, chunk.texture) != 0) {
+    chunk.dirty = true; // Try a full rebuild next frame instead
+    return;
+  }
+  const int first = (int)chunk.decals.size() - chunk.unbakedDecals;
+  chunkBatcher.begin(renderer);
+  drawDecals(chunkBatcher, assets, chunk.decals.data() + first,
+             chunk.unbakedDecals, -(float)(chunkX * chunkTiles * tileWidth),
+             -(float)(chunkY * chunkTiles * tileHeight));
+  chunkBatcher.flush();
+  SDL_SetRenderTarget(renderer, previousTarget);
+  chunk.unbakedDecals = 0;
+}
+
+void TerrainCache::updateFog(GameData &gameData) {
+  SDL_Renderer *renderer = gameData.renderer;
+  bool uploadAll = false;
+  if (!fogTexture || fogWidth != levelWidth || fogHeight != levelHeight) {
+    if (fogTexture)
+      SDL_DestroyTexture(fogTexture);
+    fogWidth = levelWidth;
+    fogHeight = levelHeight;
+    fogTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                   SDL_TEXTUREACCESS_STREAMING, fogWidth,
+                                   fogHeight);
+    if (!fogTexture) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                   "TerrainCache: failed to create fog texture: %s",
+                   SDL_GetError());
+      return;
+    }
+    SDL_SetTextureBlendMode(fogTexture, SDL_BLENDMODE_BLEND);
+    // One texel per tile: keep the hard tile edges
+    SDL_SetTextureScaleMode(fogTexture, SDL_ScaleModeNearest);
+    fogPixels.assign(static_cast<size_t>(fogWidth) * fogHeight * 4, 0);
+    uploadAll = true;
+  } else if (!fogDirty) {
+    return;
+  }
+  fogDirty = false;
+
+  // Black everywhere; seen tiles fade in with their visibility. Only the
+  // band of rows that changed is uploaded.
+  int firstChanged = uploadAll ? 0 : fogHeight;
+  int lastChanged = uploadAll ? fogHeight - 1 : -1;
+  for (int y = 0; y < fogHeight; ++y) {
+    const bool hasRow = y < (int)gameData.visibilityMap.size();
+    Uint8 *row = &fogPixels[static_cast<size_t>(y) * fogWidth * 4];
+    for (int x = 0; x < fogWidth; ++x) {
+      float visibility = 0.0f;
+      if (hasRow && x < (int)gameData.visibilityMap[y].size())
+        visibility = gameData.visibilityMap[y][x];
+      Uint8 alpha = visibility > 0.0f
+                        ? static_cast<Uint8>((1.0f - visibility) * 200)
+                        : 255;
+      if (row[x * 4 + 3] != alpha) {
+        row[x * 4 + 3] = alpha;
+        firstChanged = std::min(firstChanged, y);
+        lastChanged = std::max(lastChanged, y);
+      }
+    }
+  }
+  if (firstChanged > lastChanged)
+    return;
+  SDL_Rect rows = {0, firstChanged, fogWidth, lastChanged - firstChanged + 1};
+  const size_t firstByte = static_cast<size_t>(firstChanged) * fogWidth * 4;
+  SDL_UpdateTexture(fogTexture, &rows, &fogPixels[firstByte], fogWidth * 4);
+}
+
+void TerrainCache::draw(GameData &gameData, const AssetManager &assets,
+                        RenderQueue &queue) {
+  const Level &level = gameData.currentLevel;
+  if (level.width <= 0 || level.height <= 0 || level.tiles.empty() ||
+      gameData.tileWidth <= 0 || gameData.tileHeight <= 0)
+    return;
+  if (level.width != levelWidth || level.height != levelHeight ||
+      gameData.tileWidth != tileWidth || gameData.tileHeight != tileHeight) {
+    reset(level.width, level.height, gameData.tileWidth, gameData.tileHeight);
+  }
+  frame++;
+
+  SDL_Renderer *renderer = gameData.renderer;
+  const int chunkPixelsW = chunkTiles * tileWidth;
+  const int chunkPixelsH = chunkTiles * tileHeight;
+  const int startChunkX = std::max(
+      0, static_cast<int>(std::floor(gameData.cameraX / (float)chunkPixelsW)));
+  const int startChunkY = std::max(
+      0, static_cast<int>(std::floor(gameData.cameraY / (float)chunkPixelsH)));
+  const int endChunkX =
+      std::min(chunksWide, (gameData.cameraX + gameData.windowWidth) /
+                                   chunkPixelsW + 1);
+  const int endChunkY =
+      std::min(chunksHigh, (gameData.cameraY + gameData.windowHeight) /
+                                   chunkPixelsH + 1);
+
+  if (SDL_RenderTargetSupported(renderer)) {
+    const int budget = std::max(1, gameData.terrainChunkBudget);
+    for (int cy = startChunkY; cy < endChunkY; ++cy) {
+      for (int cx = startChunkX; cx < endChunkX; ++cx) {
+        Chunk &chunk = chunks[chunkIndex(cx, cy)];
+        chunk.lastUsed = frame;
+        if (!chunk.texture) {
+          chunk.texture = acquireTexture(renderer, budget);
+          chunk.dirty = true;
+          if (!chunk.texture)
+            continue;
+        }
+        if (chunk.dirty)
+          buildChunk(gameData, assets, cx, cy, chunk);
+        else if (chunk.unbakedDecals > 0)
+          bakeDecals(gameData, assets, cx, cy, chunk);
+        SDL_FRect dest = {
+            static_cast<float>(cx * chunkPixelsW - gameData.cameraX),
+            static_cast<float>(cy * chunkPixelsH - gameData.cameraY),
+            static_cast<float>(chunkPixelsW), static_cast<float>(chunkPixelsH)};
+        queue.texture(RenderLayer::Ground, 0.0f, chunk.texture, dest,
+                      {255, 255, 255, 255});
+      }
+    }
+  } else {
+    // No render targets: draw the visible tiles now, under everything else
+    int startTileX = std::max(0, gameData.cameraX / tileWidth);
+    int startTileY = std::max(0, gameData.cameraY / tileHeight);
+    int endTileX = std::min(
+        levelWidth, (gameData.cameraX + gameData.windowWidth) / tileWidth + 1);
+    int endTileY = std::min(
+        levelHeight,
+        (gameData.cameraY + gameData.windowHeight) / tileHeight + 1);
+    chunkBatcher.begin(renderer);
+    drawTerrainTiles(gameData, assets, chunkBatcher, startTileX, startTileY,
+                     endTileX, endTileY,
+                     static_cast<float>(startTileX * tileWidth - gameData.cameraX),
+                     static_cast<float>(startTileY * tileHeight - gameData.cameraY));
+    // Decals spanning chunks are stored in each; draw them from the chunk
+    // holding their centre only
+    for (int cy = startChunkY; cy < endChunkY; ++cy) {
+      for (int cx = startChunkX; cx < endChunkX; ++cx) {
+        for (const Decal &decal : chunks[chunkIndex(cx, cy)].decals) {
+          if ((int)std::floor(decal.x / chunkPixelsW) != cx ||
+              (int)std::floor(decal.y / chunkPixelsH) != cy)
+            continue;
+          drawDecals(chunkBatcher, assets, &decal, 1,
+                     static_cast<float>(-gameData.cameraX),
+                     static_cast<float>(-gameData.cameraY));
+        }
+      }
+    }
+    chunkBatcher.flush();
+  }
+
+  // --- Fog over the whole level (the GPU clips what's off screen) ---
+  updateFog(gameData);
+  if (fogTexture) {
+    SDL_FRect levelRect = {static_cast<float>(-gameData.cameraX),
+                           static_cast<float>(-gameData.cameraY),
+                           static_cast<float>(levelWidth * tileWidth),
+                           static_cast<float>(levelHeight * tileHeight)};
+    queue.texture(RenderLayer::Fog, 0.0f, fogTexture, levelRect,
+                  {255, 255, 255, 255});
+  }
+}
@@ -0,0 +1,119 @@
+// src/terrain_cache.h
+#ifndef TERRAIN_CACHE_H
+#define TERRAIN_CACHE_H
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+#include "decals.h"         // For Decal
+#include "sprite_batcher.h" // For the batcher chunks are drawn with
+
+// Forward declarations
+struct GameData;
+class AssetManager;
+class RenderQueue;
+
+// Largest chunk side in pixels; chunks cover fewer tiles when tiles are big
+const int TERRAIN_CHUNK_MAX_PIXELS = 1024;
+const int TERRAIN_CHUNK_MAX_TILES = 16;
+// Decals remembered per chunk; past this the oldest is forgotten
+const int TERRAIN_CHUNK_MAX_DECALS = 48;
+
+// --- Terrain Cache ---
+// Level tiles never change from frame to frame, so they're drawn once into
+// render-target textures covering a square chunk of tiles each. A chunk is
+// built the first time it comes on screen (or after invalidateTile) and the
+// tile pass becomes one copy per visible chunk.
+//
+// Built chunks are kept up to a budget and the least recently drawn one is
+// recycled for the next chunk that needs building.
+//
+// Decals are baked into every chunk they overlap. Each chunk also keeps its
+// newest decals so a rebuilt chunk (recycled, or after its target was lost)
+// can draw them again; that list is capped, so a rebuild forgets the oldest.
+//
+// Fog changes every turn, so it isn't baked in: a one-pixel-per-tile
+// texture holds each tile's darkness and is stretched over the level on
+// top of the chunks. It's only refreshed after invalidateFog, and then only
+// the rows whose darkness changed are uploaded.
+//
+// If the renderer can't render to textures, tiles are drawn directly every
+// frame instead, as before.
+class TerrainCache {
+public:
+  TerrainCache() = default;
+  ~TerrainCache();
+  TerrainCache(const TerrainCache &) = delete;
+  TerrainCache &operator=(const TerrainCache &) = delete;
+
+  // Forgets every chunk for a new level. Textures are kept for reuse.
+  void reset(int levelWidth, int levelHeight, int tileWidth, int tileHeight);
+  // The tile at (x, y) changed: its chunk is rebuilt next time it's drawn.
+  void invalidateTile(int x, int y);
+  // Records a decal; it's baked into its chunks when they're next drawn.
+  void addDecal(const Decal &decal);
+  // gameData.visibilityMap changed: the fog is refreshed next draw.
+  void invalidateFog() { fogDirty = true; }
+  // Contents of every target texture were lost (SDL_RENDER_TARGETS_RESET).
+  void invalidateAll();
+  // The textures themselves were lost (SDL_RENDER_DEVICE_RESET).
+  void releaseTextures();
+
+  // Queues the visible chunks and the fog layer, building chunks as needed.
+  // Must run before anything else is drawn this frame, since building a
+  // chunk switches the render target.
+  void draw(GameData &gameData, const AssetManager &assets,
+            RenderQueue &queue);
+
+  int getChunkTiles() const { return chunkTiles; }
+  int getBuiltChunkCount() const;
+
+private:
+  struct Chunk {
+    SDL_Texture *texture = nullptr;
+    bool dirty = true;       // Needs (re)drawing into texture
+    uint64_t lastUsed = 0;   // Frame it was last drawn, for eviction
+    std::vector<Decal> decals; // Newest last, at most TERRAIN_CHUNK_MAX_DECALS
+    int unbakedDecals = 0;     // Trailing decals not yet in the texture
+  };
+
+  int chunkIndex(int chunkX, int chunkY) const {
+    return chunkY * chunksWide + chunkX;
+  }
+  SDL_Texture *acquireTexture(SDL_Renderer *renderer, int budget);
+  void buildChunk(GameData &gameData, const AssetManager &assets,
+                  int chunkX, int chunkY, Chunk &chunk);
+  void drawDecals(SpriteBatcher &batcher, const AssetManager &assets,
+                  const Decal *decals, int count, float offsetX,
+                  float offsetY);
+  void bakeDecals(GameData &gameData, const AssetManager &assets,
+                  int chunkX, int chunkY, Chunk &chunk);
+  void updateFog(GameData &gameData);
+
+  int levelWidth = 0;
+  int levelHeight = 0;
+  int tileWidth = 0;
+  int tileHeight = 0;
+  int chunkTiles = TERRAIN_CHUNK_MAX_TILES;
+  int chunksWide = 0;
+  int chunksHigh = 0;
+  std::vector<Chunk> chunks;
+  std::vector<SDL_Texture *> spareTextures; // Chunk-sized, free to reuse
+  uint64_t frame = 0;
+  SpriteBatcher chunkBatcher;
+
+  SDL_Texture *fogTexture = nullptr;
+  int fogWidth = 0;
+  int fogHeight = 0;
+  std::vector<Uint8> fogPixels; // RGBA, one pixel per tile, as uploaded
+  bool fogDirty = true;
+};
+
+// Draws the tiles of [startX, endX) x [startY, endY) with their top-left
+// tile at screen (offsetX, offsetY), unfogged. Shared by chunk building and
+// the no-render-target fallback.
+void drawTerrainTiles(const GameData &gameData, const AssetManager &assets,
+                      SpriteBatcher &batcher, int startX, int startY,
+                      int endX, int endY, float offsetX, float offsetY);
+
+#endif // TERRAIN_CACHE_H
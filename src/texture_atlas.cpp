@@ -0,0 +1,284 @@
+// src/texture_atlas.cpp
+#include "texture_atlas.h"
+#include <SDL_image.h> // For IMG_SavePNG
+#include <algorithm>
+#include <cstdio>
+
+// Border around each sprite, filled by extruding the sprite's own edge
+static const int ATLAS_PADDING = 1;
+
+namespace {
+struct Shelf {
+  int y;
+  int height;
+  int nextX;
+};
+
+struct PageLayout {
+  int width;
+  int height;
+  int nextShelfY = 0;
+  std::vector<Shelf> shelves;
+};
+
+struct Placement {
+  int page = -1;
+  int x = 0; // Top-left of the sprite itself, inside its padding
+  int y = 0;
+};
+} // namespace
+
+// Tries to fit a w x h box (padding included) on a page. First shelf that
+// fits wins; otherwise a new shelf is opened under the last one.
+static bool placeOnPage(PageLayout &layout, int w, int h, int &outX,
+                        int &outY) {
+  for (Shelf &shelf : layout.shelves) {
+    if (h <= shelf.height && shelf.nextX + w <= layout.width) {
+      outX = shelf.nextX;
+      outY = shelf.y;
+      shelf.nextX += w;
+      return true;
+    }
+  }
+  if (layout.nextShelfY + h > layout.height || w > layout.width)
+    return false;
+  layout.shelves.push_back({layout.nextShelfY, h, w});
+  outX = 0;
+  outY = layout.nextShelfY;
+  layout.nextShelfY += h;
+  return true;
+}
+
+// Copies `image` to (x, y) on `page` and repeats its outermost pixels into
+// the padding around it.
+static void blitWithBorder(SDL_Surface *image, SDL_Surface *page, int x,
+                           int y) {
+  const int w = image->w;
+  const int h = image->h;
+  SDL_Rect dest = {x, y, w, h};
+  SDL_BlitSurface(image, nullptr, page, &dest);
+
+  const SDL_Rect edges[4][2] = {
+      {{0, 0, w, 1}, {x, y - 1, w, 1}},     // Top
+      {{0, h - 1, w, 1}, {x, y + h, w, 1}}, // Bottom
+      {{0, 0, 1, h}, {x - 1, y, 1, h}},     // Left
+      {{w - 1, 0, 1, h}, {x + w, y, 1, h}}, // Right
+  };
+  for (const auto &edge : edges) {
+    SDL_Rect source = edge[0];
+    SDL_Rect target = edge[1];
+    SDL_BlitSurface(image, &source, page, &target);
+  }
+}
+
+TextureAtlas::~TextureAtlas() { clear(); }
+
+void TextureAtlas::clear() {
+  for (SDL_Texture *page : pages) {
+    if (page)
+      SDL_DestroyTexture(page);
+  }
+  pages.clear();
+  sprites.clear();
+}
+
+bool TextureAtlas::build(
+    SDL_Renderer *renderer,
+    const std::vector<std::pair<std::string, SDL_Surface *>> &images,
+    int pageSize, const std::string &dumpPath) {
+  clear();
+  if (!renderer || pageSize <= 0)
+    return false;
+
+  // --- Layout: tallest first packs shelves tightest ---
+  std::vector<size_t> order;
+  for (size_t i = 0; i < images.size(); ++i) {
+    if (images[i].second != nullptr)
+      order.push_back(i);
+  }
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    const SDL_Surface *sa = images[a].second;
+    const SDL_Surface *sb = images[b].second;
+    if (sa->h != sb->h)
+      return sa->h > sb->h;
+    return sa->w > sb->w;
+  });
+
+  std::vector<PageLayout> layouts;
+  std::vector<Placement> placements(images.size());
+  for (size_t index : order) {
+    const SDL_Surface *image = images[index].second;
+    int boxW = image->w + 2 * ATLAS_PADDING;
+    int boxH = image->h + 2 * ATLAS_PADDING;
+    Placement &placement = placements[index];
+    int boxX = 0, boxY = 0;
+    for (size_t p = 0; p < layouts.size() && placement.page < 0; ++p) {
+      if (placeOnPage(layouts[p], boxW, boxH, boxX, boxY))
+        placement.page = static_cast<int>(p);
+    }
+    if (placement.page < 0) {
+      PageLayout layout;
+      layout.width = std::max(pageSize, boxW);
+      layout.height = std::max(pageSize, boxH);
+      if (boxW > pageSize || boxH > pageSize) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                    "Atlas: '%s' (%dx%d) is bigger than a %d page; it gets "
+                    "a page of its own.",
+                    images[index].first.c_str(), image->w, image->h, pageSize);
+        layout.width = boxW;
+        layout.height = boxH;
+      }
+      layouts.push_back(layout);
+      placeOnPage(layouts.back(), boxW, boxH, boxX, boxY);
+      placement.page = static_cast<int>(layouts.size() - 1);
+    }
+    placement.x = boxX + ATLAS_PADDING;
+    placement.y = boxY + ATLAS_PADDING;
+  }
+
+  // --- Pages: blit, upload, optionally dump ---
+  FILE *indexFile = nullptr;
+  if (!dumpPath.empty()) {
+    indexFile = std::fopen((dumpPath + ".txt").c_str(), "w");
+    if (indexFile)
+      std::fprintf(indexFile, "# name page x y w h\n");
+  }
+
+  bool success = true;
+  for (size_t p = 0; p < layouts.size(); ++p) {
+    // Trim unused rows off the bottom of single-shelf pages
+    int pageW = layouts[p].width;
+    int pageH = std::max(1, layouts[p].nextShelfY);
+    SDL_Surface *pageSurface = SDL_CreateRGBSurfaceWithFormat(
+        0, pageW, pageH, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!pageSurface) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                   "Atlas: failed to create page %zu surface: %s", p,
+                   SDL_GetError());
+      pages.push_back(nullptr);
+      success = false;
+      continue;
+    }
+    SDL_FillRect(pageSurface, nullptr, 0); // Transparent
+
+    for (size_t i = 0; i < images.size(); ++i) {
+      if (placements[i].page != static_cast<int>(p))
+        continue;
+      SDL_Surface *image = images[i].second;
+      // Copy alpha as is instead of blending onto the empty page
+      SDL_BlendMode oldMode;
+      SDL_GetSurfaceBlendMode(image, &oldMode);
+      SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+      blitWithBorder(image, pageSurface, placements[i].x, placements[i].y);
+      SDL_SetSurfaceBlendMode(image, oldMode);
+    }
+
+    if (!dumpPath.empty()) {
+      std::string pagePath = dumpPath + "_" + std::to_string(p) + ".png";
+      if (IMG_SavePNG(pageSurface, pagePath.c_str()) != 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                    "Atlas: couldn't write '%s': %s", pagePath.c_str(),
+                    IMG_GetError());
+      }
+    }
+
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, pageSurface);
+    if (!texture) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                   "Atlas: failed to upload page %zu: %s", p, SDL_GetError());
+      success = false;
+    } else {
+      SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+    pages.push_back(texture);
+
+    for (size_t i = 0; i < images.size(); ++i) {
+      if (placements[i].page != static_cast<int>(p) || !texture)
+        continue;
+      const SDL_Surface *image = images[i].second;
+      AtlasSprite sprite;
+      sprite.texture = texture;
+      sprite.page = static_cast<int>(p);
+      sprite.source = {placements[i].x, placements[i].y, image->w, image->h};
+      sprite.u0 = static_cast<float>(sprite.source.x) / pageW;
+      sprite.v0 = static_cast<float>(sprite.source.y) / pageH;
+      sprite.u1 = static_cast<float>(sprite.source.x + sprite.source.w) / pageW;
+      sprite.v1 = static_cast<float>(sprite.source.y + sprite.source.h) / pageH;
+      sprites[images[i].first] = sprite;
+      if (indexFile) {
+        std::fprintf(indexFile, "%s %zu %d %d %d %d\n",
+                     images[i].first.c_str(), p, sprite.source.x,
+                     sprite.source.y, sprite.source.w, sprite.source.h);
+      }
+    }
+    SDL_FreeSurface(pageSurface);
+  }
+  if (indexFile)
+    std::fclose(indexFile);
+
+  SDL_Log("Atlas: packed %zu sprites into %zu page(s).", sprites.size(),
+          pages.size());
+  return success;
+}
+
+const AtlasSprite *TextureAtlas::find(const std::string &name) const {
+  auto it = sprites.find(name);
+  return it != sprites.end() ? &it->second : nullptr;
+}
+
+size_t TextureAtlas::getMemoryBytes() const {
+  size_t bytes = 0;
+  for (SDL_Texture *page : pages) {
+    int w = 0, h = 0;
+    if (page && SDL_QueryTexture(page, nullptr, nullptr, &w, &h) == 0)
+      bytes += static_cast<size_t>(w) * static_cast<size_t>(h) * 4;
+  }
+  return bytes;
+}
+
+bool TextureAtlas::replace(const std::string &name, SDL_Surface *image) {
+  auto it = sprites.find(name);
+  if (it == sprites.end() || !image)
+    return false;
+  const AtlasSprite &sprite = it->second;
+  if (image->w != sprite.source.w || image->h != sprite.source.h) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                "Atlas: '%s' changed size (%dx%d -> %dx%d); it can't be "
+                "replaced in place.",
+                name.c_str(), sprite.source.w, sprite.source.h, image->w,
+                image->h);
+    return false;
+  }
+
+  // Rebuild the padded box on its own, in the page texture's format
+  Uint32 pageFormat = SDL_PIXELFORMAT_RGBA32;
+  SDL_QueryTexture(sprite.texture, &pageFormat, nullptr, nullptr, nullptr);
+  SDL_Surface *box = SDL_CreateRGBSurfaceWithFormat(
+      0, image->w + 2 * ATLAS_PADDING, image->h + 2 * ATLAS_PADDING, 32,
+      SDL_PIXELFORMAT_RGBA32);
+  if (!box)
+    return false;
+  SDL_FillRect(box, nullptr, 0);
+  SDL_BlendMode oldMode;
+  SDL_GetSurfaceBlendMode(image, &oldMode);
+  SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+  blitWithBorder(image, box, ATLAS_PADDING, ATLAS_PADDING);
+  SDL_SetSurfaceBlendMode(image, oldMode);
+  SDL_Surface *converted = SDL_ConvertSurfaceFormat(box, pageFormat, 0);
+  SDL_FreeSurface(box);
+  if (!converted)
+    return false;
+
+  SDL_Rect dest = {sprite.source.x - ATLAS_PADDING,
+                   sprite.source.y - ATLAS_PADDING, converted->w,
+                   converted->h};
+  bool updated = SDL_UpdateTexture(sprite.texture, &dest, converted->pixels,
+                                   converted->pitch) == 0;
+  if (!updated) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Atlas: failed to update '%s': %s", name.c_str(),
+                 SDL_GetError());
+  }
+  SDL_FreeSurface(converted);
+  return updated;
+}
@@ -0,0 +1,57 @@
+// src/texture_atlas.h
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <SDL.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Where one sprite lives inside an atlas page.
+struct AtlasSprite {
+  SDL_Texture *texture = nullptr; // The page (owned by the atlas)
+  int page = -1;
+  SDL_Rect source = {0, 0, 0, 0}; // Pixel rect on the page
+  // Normalised texture coordinates of `source`, ready for SDL_RenderGeometry
+  float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+};
+
+// --- Texture Atlas ---
+// Packs many small images into a few large page textures at load time, so
+// sprites from the same page can be drawn together in one call (see
+// SpriteBatcher). Shelf packing, tallest first; every sprite gets a one
+// pixel border copied from its own edge so filtering never samples a
+// neighbour.
+class TextureAtlas {
+public:
+  TextureAtlas() = default;
+  ~TextureAtlas();
+  TextureAtlas(const TextureAtlas &) = delete;
+  TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+  // Packs `images` (name, surface) into pages of at most pageSize x pageSize.
+  // The surfaces stay owned by the caller. An image bigger than a page gets
+  // a page to itself. If dumpPath isn't empty, each page is also written as
+  // <dumpPath>_<page>.png next to a <dumpPath>.txt frame index.
+  bool build(SDL_Renderer *renderer,
+             const std::vector<std::pair<std::string, SDL_Surface *>> &images,
+             int pageSize, const std::string &dumpPath = "");
+  void clear();
+
+  // nullptr if `name` isn't in the atlas.
+  const AtlasSprite *find(const std::string &name) const;
+  // Overwrites a packed sprite's pixels (and border) with `image`, in place
+  // on its page, so every AtlasSprite pointer stays good. Only works when the
+  // new image is the same size; the surface stays owned by the caller.
+  bool replace(const std::string &name, SDL_Surface *image);
+  size_t getPageCount() const { return pages.size(); }
+  // Bytes the pages take on the GPU (32-bit pixels).
+  size_t getMemoryBytes() const;
+
+private:
+  std::vector<SDL_Texture *> pages;
+  std::map<std::string, AtlasSprite> sprites;
+};
+
+#endif // TEXTURE_ATLAS_H
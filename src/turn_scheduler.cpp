@@ -0,0 +1,74 @@
+// src/turn_scheduler.cpp
+#include "turn_scheduler.h"
+#include "enemy.h"
+#include "game_data.h"
+#include <SDL.h>
+#include <algorithm>
+
+bool TurnScheduler::later(const Entry &a, const Entry &b) {
+  if (a.time != b.time)
+    return a.time > b.time;
+  return a.sequence > b.sequence;
+}
+
+void TurnScheduler::clear() {
+  heap.clear();
+  nextSequence = 0;
+}
+
+void TurnScheduler::schedule(EnemyHandle handle, int64_t time) {
+  heap.push_back({time, nextSequence++, handle});
+  std::push_heap(heap.begin(), heap.end(), later);
+}
+
+void TurnScheduler::popDue(const GameData &gameData, int64_t until,
+                           std::vector<EnemyHandle> &outDue) {
+  while (!heap.empty() && heap.front().time <= until) {
+    Entry entry = heap.front();
+    std::pop_heap(heap.begin(), heap.end(), later);
+    heap.pop_back();
+
+    const Enemy *enemy = findEnemy(gameData, entry.handle);
+    if (enemy == nullptr || enemy->health <= 0 ||
+        enemy->nextActTime != entry.time)
+      continue; // Stale: removed, dead or rescheduled
+    outDue.push_back(entry.handle);
+  }
+}
+
+void scheduleEnemy(GameData &gameData, Enemy &enemy) {
+  if (enemy.nextActTime >= 0 || !enemy.handle.isValid())
+    return; // Already scheduled, or no handle yet (call syncEnemySlots first)
+  enemy.nextActTime = gameData.gameClock + enemy.archetype().actionCost;
+  gameData.scheduler.schedule(enemy.handle, enemy.nextActTime);
+}
+
+size_t beginEnemyTurn(GameData &gameData) {
+  // Last turn's actors go back to waiting
+  for (EnemyHandle handle : gameData.dueEnemies) {
+    if (Enemy *enemy = findEnemy(gameData, handle))
+      enemy->actsThisTurn = false;
+  }
+  gameData.dueEnemies.clear();
+
+  const int64_t turnEnd =
+      gameData.gameClock + gameData.currentGamePlayer.GetActionCost();
+  gameData.scheduler.popDue(gameData, turnEnd, gameData.dueEnemies);
+
+  for (EnemyHandle handle : gameData.dueEnemies) {
+    Enemy *enemy = findEnemy(gameData, handle);
+    enemy->actsThisTurn = true;
+    // One action per turn: whatever is left of a fast enemy's speed starts
+    // the next turn instead of piling up.
+    int cost = std::max(1, enemy->archetype().actionCost);
+    enemy->nextActTime = std::max(enemy->nextActTime + cost, turnEnd + 1);
+    gameData.scheduler.schedule(handle, enemy->nextActTime);
+  }
+  gameData.gameClock = turnEnd;
+
+  SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION,
+               "Scheduler: clock %lld, %zu of %zu enemies act this turn.",
+               static_cast<long long>(gameData.gameClock),
+               gameData.dueEnemies.size(), gameData.enemies.size());
+  return gameData.dueEnemies.size();
+}
@@ -0,0 +1,64 @@
+// src/turn_scheduler.h
+#ifndef TURN_SCHEDULER_H
+#define TURN_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "enemy_slot_map.h" // For EnemyHandle
+
+// Forward declarations
+struct GameData;
+class Enemy;
+
+// Game time one action takes at normal speed. Actors with a smaller action
+// cost are faster, larger are slower.
+const int BASE_ACTION_COST = 100;
+
+// --- Turn Scheduler ---
+// A min-heap of enemies keyed on the game time they next act. Each turn the
+// clock advances by the player's action cost and only the enemies that come
+// due are popped; everyone else stays in the heap and is never looked at, so
+// a slow monster costs nothing on the turns it sits out. O(log n) per action.
+//
+// Entries are never removed early. An entry whose handle is stale (enemy
+// gone) or whose time no longer matches the enemy's nextActTime (it was
+// rescheduled) is dropped when it reaches the top.
+//
+// Turns stay simultaneous: a due enemy plans and resolves one action with
+// everyone else. An enemy faster than the player still acts at most once per
+// turn; its next action is pushed into the following turn rather than banked.
+class TurnScheduler {
+public:
+  void clear();
+  void schedule(EnemyHandle handle, int64_t time);
+  bool empty() const { return heap.empty(); }
+  size_t size() const { return heap.size(); }
+
+  // Pops every live entry due at or before `until` into outDue.
+  void popDue(const GameData &gameData, int64_t until,
+              std::vector<EnemyHandle> &outDue);
+
+private:
+  struct Entry {
+    int64_t time;
+    uint32_t sequence; // Insertion order: equal times pop first-in first-out
+    EnemyHandle handle;
+  };
+  static bool later(const Entry &a, const Entry &b);
+
+  std::vector<Entry> heap;
+  uint32_t nextSequence = 0;
+};
+
+// Gives an enemy that has never been scheduled its first slot, one action
+// from now.
+void scheduleEnemy(GameData &gameData, Enemy &enemy);
+
+// Advances gameData.gameClock by the player's action cost, lists the enemies
+// that come due in gameData.dueEnemies (planning walks that list, not every
+// enemy), marks them with actsThisTurn and reschedules them. Main thread, at
+// the start of Planning_EnemyAI. Returns how many enemies act this turn.
+size_t beginEnemyTurn(GameData &gameData);
+
+#endif // TURN_SCHEDULER_H
@@ -322,7 +322,7 @@ void renderSpellBar(GameData &gameData, AssetManager &assets) {
                            slotBorderColor.b, slotBorderColor.a);
     SDL_RenderDrawRect(renderer, &slotRect);
 
-    SDL_Texture* iconTex = assets.getTexture(spell.iconName);
+    SDL_Texture* iconTex = assets.getTexture(spell.iconId);
     if (iconTex) {
         int iconPadding = 2;
         SDL_Rect iconDestRect = {
@@ -410,11 +410,13 @@ void renderCharacterSheet(GameData& gameData, AssetManager& assets) {
 
     // --- Column 1: Portrait and Basic Info ---
     SDL_Texture* portraitTexture = nullptr;
-    std::string portraitKey;
+    static const AssetId femalePortrait = internAssetName("female_mage_portrait");
+    static const AssetId malePortrait = internAssetName("male_mage_portrait");
+    AssetId portraitKey;
      if (player.type == CharacterType::FemaleMage) {
-         portraitKey = "female_mage_portrait";
+         portraitKey = femalePortrait;
      } else {
-         portraitKey = "male_mage_portrait";
+         portraitKey = malePortrait;
      }
     portraitTexture = assets.getTexture(portraitKey);
 
@@ -424,7 +426,7 @@ void renderCharacterSheet(GameData& gameData, AssetManager& assets) {
         SDL_RenderCopy(renderer, portraitTexture, nullptr, &portraitRect);
         currentY += portraitSize + sectionPadding;
     } else {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Character portrait '%s' not found.", portraitKey.c_str());
+        // getTexture has reported the missing portrait (once)
          SDL_Rect placeholderRect = {leftColX, currentY, portraitSize, portraitSize};
          SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
          SDL_RenderFillRect(renderer, &placeholderRect);
@@ -495,7 +497,7 @@ void renderCharacterSheet(GameData& gameData, AssetManager& assets) {
          if (currentY + iconSize > sheetY + sheetHeight - 20) break; // Prevent overflow
 
         // Render Icon
-        SDL_Texture* iconTex = assets.getTexture(spell.iconName);
+        SDL_Texture* iconTex = assets.getTexture(spell.iconId);
         if (iconTex) {
             SDL_Rect iconRect = {rightColX, currentY, iconSize, iconSize};
             SDL_RenderCopy(renderer, iconTex, nullptr, &iconRect);
@@ -0,0 +1,119 @@
+// tools/asset_packer.cpp
+// Packs the files listed in an asset manifest into one archive the game maps
+// straight into memory (see src/asset_manifest.h for the layout and
+// src/asset_archive.h for the reader).
+//
+//   asset_packer <manifest.txt> <assets dir> <out.pak>
+//
+// Each file is stored once even if several entries name it, so a font listed
+// at two sizes costs one copy.
+#include "../src/asset_manifest.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static bool readFile(const std::string &path, std::string &contents) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    return false;
+  contents.assign(std::istreambuf_iterator<char>(file),
+                  std::istreambuf_iterator<char>());
+  return !file.bad();
+}
+
+static void putU32(std::string &out, uint32_t value) {
+  for (int i = 0; i < 4; ++i)
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+static void putU64(std::string &out, uint64_t value) {
+  for (int i = 0; i < 8; ++i)
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+int main(int argc, char *argv[]) {
+  if (argc != 4) {
+    std::fprintf(stderr,
+                 "usage: %s <manifest.txt> <assets dir> <out.pak>\n",
+                 argv[0]);
+    return 2;
+  }
+  const std::string manifestPath = argv[1];
+  const std::string assetRoot = argv[2];
+  const std::string outputPath = argv[3];
+
+  std::string manifestText;
+  if (!readFile(manifestPath, manifestText)) {
+    std::fprintf(stderr, "asset_packer: can't read %s\n",
+                 manifestPath.c_str());
+    return 1;
+  }
+  std::vector<AssetManifestEntry> entries;
+  std::string error;
+  if (!parseAssetManifest(manifestText, entries, error)) {
+    std::fprintf(stderr, "asset_packer: %s: %s\n", manifestPath.c_str(),
+                 error.c_str());
+    return 1;
+  }
+
+  // --- File data, each file once, aligned ---
+  std::string archive(ASSET_ARCHIVE_HEADER_SIZE, '\0');
+  std::map<std::string, std::pair<uint64_t, uint64_t>> stored; // path -> at
+  int failures = 0;
+  for (AssetManifestEntry &entry : entries) {
+    auto found = stored.find(entry.path);
+    if (found == stored.end()) {
+      std::string contents;
+      if (!readFile(assetRoot + "/" + entry.path, contents)) {
+        std::fprintf(stderr, "asset_packer: can't read %s/%s (for '%s')\n",
+                     assetRoot.c_str(), entry.path.c_str(),
+                     entry.name.c_str());
+        failures++;
+        continue;
+      }
+      while (archive.size() % ASSET_ARCHIVE_ALIGNMENT != 0)
+        archive.push_back('\0');
+      uint64_t offset = archive.size();
+      archive += contents;
+      found = stored.emplace(entry.path, std::make_pair(offset,
+                                                        contents.size()))
+                  .first;
+    }
+    entry.offset = found->second.first;
+    entry.size = found->second.second;
+  }
+  if (failures > 0) {
+    std::fprintf(stderr, "asset_packer: %d file(s) missing, nothing written\n",
+                 failures);
+    return 1;
+  }
+
+  // --- Index, then the header pointing at it ---
+  while (archive.size() % ASSET_ARCHIVE_ALIGNMENT != 0)
+    archive.push_back('\0');
+  const uint64_t indexOffset = archive.size();
+  const std::string index = writeAssetArchiveIndex(entries);
+  archive += index;
+
+  std::string header(ASSET_ARCHIVE_MAGIC, sizeof(ASSET_ARCHIVE_MAGIC));
+  putU32(header, ASSET_ARCHIVE_VERSION);
+  putU64(header, indexOffset);
+  putU64(header, index.size());
+  putU64(header, hashAssetManifest(manifestText));
+  archive.replace(0, header.size(), header);
+
+  std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+  output.write(archive.data(), static_cast<std::streamsize>(archive.size()));
+  if (!output) {
+    std::fprintf(stderr, "asset_packer: can't write %s\n", outputPath.c_str());
+    return 1;
+  }
+  std::printf("asset_packer: %zu entries, %zu files, %zu bytes -> %s\n",
+              entries.size(), stored.size(), archive.size(),
+              outputPath.c_str());
+  return 0;
+}